@@ -1,7 +1,12 @@
+import argparse
+import calendar
 import csv
 import subprocess
 import datetime
 import json
+import re
+import sys
+import unicodedata
 
 
 tznames = json.loads('''
@@ -416,7 +421,10 @@ def get_cities():
         return cities
 
 def get_time_jumps(city):
-    print(city)
+    """Returns the transitions of a city as (utc, gmtoff, tzname, dst) tuples, with
+    utc in seconds since the epoch. zdump prints each transition as the second
+    before it and the second it happens, so only changes are kept."""
+    print(city, file=sys.stderr)
     p = subprocess.run(["zdump", "-v", "/usr/share/zoneinfo/{}".format(city)], capture_output=True)
     out = p.stdout
     times = out.strip().split(b"\n")
@@ -425,31 +433,125 @@ def get_time_jumps(city):
         if b"NULL" in t:
             continue
         elements = [e for e in t.split(b' ') if e]
-        utc = b' '.join(elements[2:6]) # Does not include timezone
-        local = b' '.join(elements[9:13]) # Does not include timezone
-        tzname = elements[13]
+        if len(elements) < 16:
+            continue
+        utc = b' '.join(elements[2:6]).decode() # Does not include timezone
+        tzname = elements[13].decode()
         dst = int(elements[14].split(b'=')[1])
         gmtoff = int(elements[15].split(b'=')[1])
-        metadata.append({city: (utc.decode(), local.decode(), tzname, dst, gmtoff)});
+        seconds = calendar.timegm(datetime.datetime.strptime(utc, "%b %d %H:%M:%S %Y").timetuple())
+        if not metadata or metadata[-1][1:] != (gmtoff, tzname, dst):
+            metadata.append((seconds, gmtoff, tzname, dst))
     return metadata
 
+def get_rule(city):
+    """The POSIX TZ string at the end of a city's TZif file, for the time after
+    the transitions zdump lists."""
+    try:
+        with open("/usr/share/zoneinfo/{}".format(city), "rb") as f:
+            data = f.read()
+    except OSError:
+        return ""
+    if not data.startswith(b"TZif") or data[4:5] == b"\0":
+        return ""
+    return data.rstrip(b"\n").rsplit(b"\n", 1)[-1].decode()
+
+def calc_offset(hour, minute):
+    """The name Timezone::CalcOffset() gives an offset."""
+    n = str(hour) + ((":" + str(minute)) if minute > 0 else "")
+    return ("UTC-" if hour < 0 else "UTC+") + n
+
+def identifier(name):
+    """A C++ identifier for a zone name, as used by the TimezoneId enumerators."""
+    name = name.replace("+", "p").replace("-", "m").replace(":", "")
+    name = "".join(c for c in unicodedata.normalize("NFKD", name) if not unicodedata.combining(c))
+    return re.sub(r"[^A-Za-z0-9]+", "_", name).strip("_")
+
+def c_string(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+def c_bytes(b):
+    """A C string literal for bytes, with octal escapes for anything but plain ASCII."""
+    out = ""
+    for c in b:
+        ch = chr(c)
+        out += ch if 32 <= c < 127 and ch not in "\\\"?" else "\\{:03o}".format(c)
+    return '"' + out + '"'
+
+def name_trie(names):
+    """The trie NameIndex builds over names, keyed by position, as (nodes, edges,
+    labels). Nodes are [key, first_edge, edge_count, label, label_length] and edges
+    (byte, child)."""
+    items = sorted((n.encode(), i) for i, n in enumerate(names) if n)
+    nodes = [[-1, 0, 0, 0, 0]]
+    edges = []
+    labels = bytearray()
+
+    def build(node, lo, hi, depth):
+        if lo < hi and len(items[lo][0]) == depth:
+            nodes[node][0] = items[lo][1]
+            while lo < hi and len(items[lo][0]) == depth:
+                lo += 1
+        starts = [i for i in range(lo, hi) if i == lo or items[i][0][depth] != items[i - 1][0][depth]]
+        ends = starts[1:] + [hi]
+        first = len(edges)
+        nodes[node][1] = first
+        nodes[node][2] = len(starts)
+        for start, end in zip(starts, ends):
+            name, last = items[start][0], items[end - 1][0]
+            shared = depth + 1
+            while shared < len(name) and len(last) > shared and last[shared] == name[shared]:
+                shared += 1
+            nodes.append([-1, 0, 0, len(labels), shared - depth - 1])
+            labels.extend(name[depth + 1:shared])
+            edges.append((name[depth], len(nodes) - 1))
+        for k, (start, end) in enumerate(zip(starts, ends)):
+            child = edges[first + k][1]
+            build(child, start, end, depth + 1 + nodes[child][4])
+
+    build(0, 0, len(items), 0)
+    return nodes, edges, bytes(labels)
+
 def print_output(city_to_tz):
+    # Every built-in zone, as name -> (gmtoff, transitions, rule). Fixed offsets
+    # have no transitions. Handles are positions in this list: UTC first, then by name.
+    zones = {}
+    for city, (metadata, rule) in city_to_tz.items():
+        if not metadata:
+            print("warning: zdump printed no transitions for {}, skipping it".format(city), file=sys.stderr)
+            continue
+        zones[city] = (metadata[0][1], metadata, rule)
+    for h in range(-12, 14+1):
+        for m in [0, 15, 30, 45]:
+            zones[calc_offset(h, m)] = (m * 60 + h * 60 * 60, [], "")
+    for name, hm in tznames.items():
+        zones[name] = (hm[1] * 60 + hm[0] * 60 * 60, [], "")
+    names = ["UTC"] + sorted((n for n in zones if n != "UTC"), key=lambda n: n.encode())
+    ids = [identifier(n) for n in names]
+    assert len(set(ids)) == len(ids), "zone names with the same identifier"
+
+    abbrs = []
+    transitions = []
+    for name in names:
+        for entry in zones[name][1]:
+            if entry[2] not in abbrs:
+                abbrs.append(entry[2])
+
     print("// Autogenerated by gen-tz-data.py. Do not modify.")
     print("#ifndef X_DATETIME_TIMEZONE_H")
     print("#define X_DATETIME_TIMEZONE_H")
     print("#include <string>")
-    print("#include <map>")
     print("#include <vector>")
     print("#include <time.h>")
     print("namespace xDateTime {")
     print("struct Timezone {")
     print("    std::string name;")
-    #print("    bool is_city;")
     print("    std::vector<time_t> utc;")
     print("    std::vector<time_t> local;")
     print("    std::vector<std::string> tzname;")
     print("    std::vector<int> dst;")
     print("    std::vector<int> gmtoff; // seconds")
+    print("    std::string rule;        // POSIX TZ string, for the time after the last transition")
     print("    static std::string CalcOffset(int hour, int minute) {")
     print("        std::string n = std::to_string(hour) + ((minute > 0) ? \":\" + std::to_string(minute) : \"\");")
     print("        n.insert(0, hour < 0 ? \"UTC-\" : \"UTC+\");")
@@ -458,64 +560,96 @@ def print_output(city_to_tz):
     print("    Timezone() {}")
     print("    Timezone(int hour, int minute) {")
     print("        name = Timezone::CalcOffset(hour, minute);")
-    #print("        is_city = false;")
     print("        gmtoff.push_back(minute * 60 + hour * 60 * 60);")
     print("    }")
     print("    Timezone(const std::string& name_, int hour, int minute) {")
     print("        name = name_;")
-    #print("        is_city = false;")
     print("        gmtoff.push_back(minute * 60 + hour * 60 * 60);")
     print("    }")
     print("};\n")
-    print("static inline std::map<std::string, Timezone> InitializeTimezones();")
-    print("static inline Timezone TZ(const std::string& name) { return InitializeTimezones()[name]; }")
+    print("// Handle to a zone interned in the TimezoneRegistry. The built-in zones come first,")
+    print("// in the order of BuiltinZones, and UTC is always registered first, so a")
+    print("// value-initialized TimezoneId refers to UTC.")
+    print("enum TimezoneId : unsigned short {")
+    for i, ident in enumerate(ids):
+        print("    {}_TimezoneId = {},".format(ident, i))
+    print("};\n")
+    print("// The built-in zones, as constant tables which need no initialization. A zone")
+    print("// has the transitions [first, first + count) of BuiltinTransitions, or the fixed")
+    print("// offset gmtoff if count is 0. After its last transition, a zone follows its")
+    print("// POSIX TZ rule. Apart from UTC, which is first, the zones are sorted by name.")
+    print("struct BuiltinTransition {")
+    print("    long long utc;        // seconds since the epoch")
+    print("    int gmtoff;           // seconds, from utc on")
+    print("    unsigned short abbr;  // index into BuiltinAbbreviations")
+    print("    unsigned char dst;")
+    print("};\n")
+    print("struct BuiltinZone {")
+    print("    const char* name;")
+    print("    int gmtoff; // seconds")
+    print("    unsigned first;")
+    print("    unsigned count;")
+    print("    const char* rule;")
+    print("};\n")
+    print("static constexpr unsigned BuiltinZoneCount = {};\n".format(len(names)))
+    print("static constexpr const char* BuiltinAbbreviations[] = {")
+    for a in abbrs or [""]:
+        print("    {},".format(c_string(a)))
+    print("};\n")
+    print("static constexpr BuiltinTransition BuiltinTransitions[] = {")
+    if not any(zones[n][1] for n in names):
+        print("    {0, 0, 0, 0}, // unused")
+    for name in names:
+        for entry in zones[name][1]:
+            print("    {{{}, {}, {}, {}}},".format(entry[0], entry[1], abbrs.index(entry[2]), entry[3]))
+    print("};\n")
+    print("static constexpr BuiltinZone BuiltinZones[] = {")
+    first = 0
+    for name in names:
+        gmtoff, metadata, rule = zones[name]
+        print("    {{{}, {}, {}, {}, {}}},".format(c_string(name), gmtoff, first, len(metadata), c_string(rule)))
+        first += len(metadata)
+    print("};\n")
+    nodes, edges, labels = name_trie(names)
+    print("// The names of the built-in zones as a trie, laid out as NameIndex builds one,")
+    print("// so that they are looked up without building anything first. The keys are")
+    print("// TimezoneIds.")
+    print("struct NameTrieNode {")
+    print("    int key;               // of the name ending here, or -1")
+    print("    unsigned first_edge;")
+    print("    unsigned edge_count;")
+    print("    unsigned label;        // bytes after the edge's byte, in the labels")
+    print("    unsigned label_length;")
+    print("};\n")
+    print("struct NameTrieEdge {")
+    print("    unsigned char c;")
+    print("    unsigned child;")
+    print("};\n")
+    print("static constexpr unsigned BuiltinNameMaxLength = {};\n".format(max(len(n.encode()) for n in names)))
+    print("static constexpr NameTrieNode BuiltinNameNodes[] = {")
+    for node in nodes:
+        print("    {{{}, {}, {}, {}, {}}},".format(*node))
+    print("};\n")
+    print("static constexpr NameTrieEdge BuiltinNameEdges[] = {")
+    for c, child in edges:
+        print("    {{{}, {}}},".format(c, child))
+    print("};\n")
+    print("static constexpr char BuiltinNameLabels[] =")
+    for i in range(0, len(labels), 64):
+        print("    {}".format(c_bytes(labels[i:i + 64])))
+    print("    \"\";\n")
+    print("static inline const Timezone& TZ(const std::string& name);")
+    print("static inline const Timezone& TZ(TimezoneId id);")
     print("struct BaseTimezone {")
     print("    Timezone tz;")
-    print("    BaseTimezone() { tz = TZ(\"UTC\"); }")
+    print("    BaseTimezone() { tz = TZ(UTC_TimezoneId); }")
     print("};\n")
-    print("static inline std::map<std::string, Timezone> InitializeTimezones() {")
-    print("    static std::map<std::string, Timezone> timezones; ")
-    print("    static bool initialized = false; ")
-    print("    struct tm t;")
-    print("    if (initialized) return timezones;\n")
-    print("    // Cities markes as time zone reference points")
-    print("    // Note: None of these conversions allow auto DST because we apply it ourselves")
-    print("    // based on the info we have handy.")
-    for city, metadata in city_to_tz.items():
-        print("    timezones[\"{}\"] = Timezone();".format(city))
-        print("    timezones[\"{}\"].name = \"{}\";".format(city, city))
-        #print("    timezones[\"{}\"].is_city = true;\n".format(city))
-        for entry in metadata:
-             print("    strptime(\"{}\", \"%b %d %H:%M:%S %Y\", &t);".format(entry.utc))
-             print("    t.tm_isdst = 0;")
-             print("    timezones[\"{}\".utc.push_back(mktime(&t));".format(city))
-             print("    strptime(\"{}\", \"%b %d %H:%M:%S %Y\", &t);".format(entry.local))
-             print("    t.tm_isdst = 0;")
-             print("    timezones[\"{}\".local.push_back(mktime(&t));".format(city))
-             print("    timezones[\"{}\".tzname.push_back(\"{}\");".format(city, entry.tzname))
-             print("    timezones[\"{}\".dst.push_back({});".format(city, entry.dst))
-             print("    timezones[\"{}\".gmtoff.push_back({});\n".format(city, entry.gmtoff))
-        print("") # another empty line
-
-    print("    // Time zone offsets from UTC")
-    for h in range(-12, 14+1):
-        for m in [0, 15, 30, 45]:
-            print("    timezones[Timezone::CalcOffset({}, {})] = Timezone({}, {});".format(h, m, h, m))
-    print("") # another empty line
-
-    print("    // Time zone names")
-    for name, hm in tznames.items():
-        print("    timezones[\"{}\"] = Timezone(\"{}\", {}, {});".format(name, name, hm[0], hm[1]))   
-    print("") # another empty line
-    print("    initialized = true;");
-    print("    return timezones;");
-    print("}\n")
     for name, hm in tznames.items():
         if name.upper() == name: #To identify the time zone appreviations
             replaced_name = name.replace("+", "p").replace("-", "m")
             print("struct {}_Timezone: public BaseTimezone {{".format(replaced_name))
             print("    {}_Timezone(): BaseTimezone() {{".format(replaced_name))
-            print("        tz = TZ(\"{}\");".format(name))
+            print("        tz = TZ({}_TimezoneId);".format(identifier(name)))
             print("    }")
             print("};")
     for h in range(-12, 14+1):
@@ -529,18 +663,21 @@ def print_output(city_to_tz):
             print("struct {}_Timezone: public BaseTimezone {{".format(replaced_name))
             print("    Timezone tz;")
             print("    {}_Timezone(): BaseTimezone() {{".format(replaced_name))
-            print("        tz = TZ(\"{}\");".format(name))
+            print("        tz = TZ({}_TimezoneId);".format(identifier(calc_offset(h, m))))
             print("    }")
             print("};")
     print("}")
     print("#endif /* X_DATETIME_TIMEZONE_H */")
 
 def main():
+    parser = argparse.ArgumentParser(description="Writes x_datetime_timezone.h to stdout.")
+    parser.add_argument("--cities", action="store_true",
+                        help="include the transitions of every city in zone.tab, from zdump")
+    args = parser.parse_args()
     city_to_tz = {}
-    cities = get_cities()
-    for city in cities:
-        pass
-        #city_to_tz[city] = get_time_jumps(city) # Thia takes too long.
+    if args.cities:
+        for city in get_cities():
+            city_to_tz[city] = (get_time_jumps(city), get_rule(city))
     print_output(city_to_tz)
 
 
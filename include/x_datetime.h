@@ -69,8 +69,50 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstring>
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+// The ISO 8601 parser uses SSE2 where the compiler targets it (always the case on x86-64),
+// and portable 64-bit arithmetic otherwise. Define X_DATETIME_NO_SIMD to always use the latter.
+#if defined(__SSE2__) && !defined(X_DATETIME_NO_SIMD)
+#include <emmintrin.h>
+#define X_DATETIME_SSE2
+#endif
+
+// LogReader and the zoneinfo loader map files with mmap(), which is only there on
+// POSIX systems. Define X_DATETIME_NO_MMAP to leave them out.
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(X_DATETIME_NO_MMAP)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define X_DATETIME_MMAP
+#endif
+
+// Zones which are not built in can be loaded from the system's zoneinfo directory by
+// name with TZId(). Parsing only resolves zone names against the zones which are
+// built in or already registered. Define X_DATETIME_NO_ZONEINFO to leave this out.
+#if defined(X_DATETIME_MMAP) && !defined(X_DATETIME_NO_ZONEINFO)
+#define X_DATETIME_ZONEINFO
+#endif
 
 // In C++20 and later, the u8 literal makes a char8_t which is incompatible
 // with char strings unless you cast it.
@@ -117,6 +159,33 @@ public:
 private:
     std::string msg;
 };
+
+// Result of the non-throwing parsers (DateTime::TryParse and friends). Bad
+// input is an expected outcome when parsing, so it is reported as a value
+// rather than by throwing MalformedDateTime.
+enum class ParseError {
+    None = 0,
+    BadFormat,           // the format string itself is invalid
+    Mismatch,            // the input does not match a literal or name in the format
+    BadValue,            // a numeric field is missing or out of range
+    TrailingCharacters,  // input left over after the format was consumed
+    UnknownTimezone,     // %Z named a zone that is not registered
+    NoMatchingFormat     // none of the candidate formats accepted the input
+};
+
+inline const char* ParseErrorString(ParseError e) {
+    switch (e) {
+        case ParseError::None: return "No error";
+        case ParseError::BadFormat: return "Bad format string";
+        case ParseError::Mismatch: return "Bad format string and/or input values";
+        case ParseError::BadValue: return "Bad input value";
+        case ParseError::TrailingCharacters: return "Trailing characters are not allowed";
+        case ParseError::UnknownTimezone: return "Unknown time zone name";
+        case ParseError::NoMatchingFormat:
+            return "None of the ISO8601 or supplied locale formats could interpret the string.";
+    }
+    return "Unknown parse error";
+}
 }
 
 #ifndef X_DATETIME_NO_TIMEZONES
@@ -130,6 +199,7 @@ struct Timezone {
     std::vector<std::string> tzname;
     std::vector<int> dst;
     std::vector<int> gmtoff; // seconds
+    std::string rule;        // POSIX TZ string, for the time after the last transition
     static std::string CalcOffset(int hour, int minute) {
         std::string n = std::to_string(hour) + ((minute > 0) ? ":" + std::to_string(minute) : "");
         n.insert(0, hour < 0 ? "UTC-" : "UTC+");
@@ -146,29 +216,1101 @@ struct Timezone {
     }
 };
 
-static inline std::map<std::string, Timezone> InitializeTimezones();
-static inline Timezone TZ(const std::string& name) { return InitializeTimezones()[name]; }
+enum TimezoneId : unsigned short { UTC_TimezoneId = 0 };
+
+struct BuiltinTransition {
+    long long utc;
+    int gmtoff;
+    unsigned short abbr;
+    unsigned char dst;
+};
+
+struct BuiltinZone {
+    const char* name;
+    int gmtoff;
+    unsigned first;
+    unsigned count;
+    const char* rule;
+};
+
+static constexpr unsigned BuiltinZoneCount = 1;
+static constexpr const char* BuiltinAbbreviations[] = {""};
+static constexpr BuiltinTransition BuiltinTransitions[] = {{0, 0, 0, 0}};
+static constexpr BuiltinZone BuiltinZones[] = {{"UTC", 0, 0, 0, ""}};
+
+struct NameTrieNode {
+    int key;
+    unsigned first_edge;
+    unsigned edge_count;
+    unsigned label;
+    unsigned label_length;
+};
+
+struct NameTrieEdge {
+    unsigned char c;
+    unsigned child;
+};
+
+static constexpr unsigned BuiltinNameMaxLength = 3;
+static constexpr NameTrieNode BuiltinNameNodes[] = {{-1, 0, 1, 0, 0}, {0, 1, 0, 0, 2}};
+static constexpr NameTrieEdge BuiltinNameEdges[] = {{'U', 1}};
+static constexpr char BuiltinNameLabels[] = "TC";
+
+static inline const Timezone& TZ(const std::string& name);
+static inline const Timezone& TZ(TimezoneId id);
 struct BaseTimezone {
     Timezone tz;
-    BaseTimezone() { tz = TZ("UTC"); }
+    BaseTimezone() { tz = TZ(UTC_TimezoneId); }
 };
 
-static inline std::map<std::string, Timezone> InitializeTimezones() {
-static std::map<std::string, Timezone> timezones;
-    bool initialized = false;
-    if (initialized) return timezones;
-    timezones["UTC"] = Timezone("UTC", 0, 0);
-    initialized = true;
-    return timezones;
-}
 struct UTC_Timezone: public BaseTimezone {
     UTC_Timezone(): BaseTimezone() {
-        tz = TZ("UTC");
+        tz = TZ(UTC_TimezoneId);
     }
 };
 }
 #endif /* X_DATETIME_NO_TIMEZONES */
 
+namespace xDateTime {
+
+// Proleptic Gregorian calendar arithmetic on days since the Unix epoch.
+// These are pure integer functions (after Howard Hinnant's days_from_civil and civil_from_days),
+// so unlike mktime() and gmtime_r() they do not look at the TZ environment variable or
+// take the libc timezone lock. Months and days are one-based.
+class GregorianCalendar {
+public:
+    static const long long SecondsPerDay = 86400;
+
+    // Division rounding towards negative infinity, for dates before 1970.
+    static long long FloorDiv(long long a, long long b) {
+        return (a >= 0) ? a / b : -((-a - 1) / b) - 1;
+    }
+
+    static bool IsLeap(long long y) {
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    }
+
+    static int DaysInMonth(long long y, int m) {
+        static const unsigned char days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return (m == 2 && IsLeap(y)) ? 29 : days[m - 1];
+    }
+
+    // Days since 1970-01-01 of y-m-d. The day may be outside of the month and
+    // simply carries over (like mktime). The month must be in 1..12.
+    static long long DaysFromCivil(long long y, int m, int d) {
+        y -= m <= 2;
+        const long long era = FloorDiv(y, 400);
+        const long long yoe = y - era * 400;                                  // [0, 399]
+        const long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;  // [0, 365]
+        const long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;          // [0, 146096]
+        return era * 146097 + doe - 719468;
+    }
+
+    static void CivilFromDays(long long z, long long& y, int& m, int& d) {
+        z += 719468;
+        const long long era = FloorDiv(z, 146097);
+        const long long doe = z - era * 146097;                               // [0, 146096]
+        const long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+        const long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);        // [0, 365]
+        const long long mp = (5 * doy + 2) / 153;                             // [0, 11]
+        d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        y = yoe + era * 400 + (m <= 2);
+    }
+
+    // Day of the week, 0 = Sunday (like tm_wday).
+    static int WeekdayFromDays(long long z) {
+        return static_cast<int>(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+    }
+
+    // Day of the year, 1 = January 1st.
+    static int DayOfYear(long long y, int m, int d) {
+        return static_cast<int>(DaysFromCivil(y, m, d) - DaysFromCivil(y, 1, 1)) + 1;
+    }
+
+    // Seconds since the Unix epoch. Out of range fields are normalized like mktime() does,
+    // but no time zone is applied.
+    static long long SecondsFromCivil(long long y, long long m, long long d,
+            long long H, long long M, long long S) {
+        long long m0 = m - 1;
+        y += FloorDiv(m0, 12);
+        m0 -= FloorDiv(m0, 12) * 12;
+        return (DaysFromCivil(y, static_cast<int>(m0) + 1, 1) + d - 1) * SecondsPerDay
+            + H * 3600 + M * 60 + S;
+    }
+};
+
+// A trie laid out in arrays: the children of each node are kept together, sorted
+// by byte, and a run of bytes without a branch is a single node, so that most
+// names are compared with one memcmp after their first byte. NameIndex builds
+// these at run time, and gen-tz-data.py writes the one for the built-in zones.
+class NameTrie {
+public:
+    NameTrie(const NameTrieNode* nodes_, const NameTrieEdge* edges_, const char* labels_)
+        : nodes(nodes_), edges(edges_), labels(labels_) {}
+
+    // The key of the longest name which starts [p, last), or -1. p is moved past it.
+    int Match(const char*& p, const char* last) const {
+        return Match(p, last, [](const char*) { return true; });
+    }
+
+    // The same, but only names for which accept(end of the name in the input) is
+    // true count.
+    template <typename Accept>
+    int Match(const char*& p, const char* last, Accept accept) const {
+        unsigned node = 0;
+        int key = -1;
+        const char* end = p;
+        for (const char* q = p; q != last; ) {
+            const unsigned char c = static_cast<unsigned char>(*q);
+            const Node& n = nodes[node];
+            const Edge* e = edges + n.first_edge;
+            const Edge* e_end = e + n.edge_count;
+            while (e != e_end && e->c < c) ++e;
+            if (e == e_end || e->c != c) break;
+            const Node& child = nodes[e->child];
+            ++q;
+            if (static_cast<size_t>(last - q) < child.label_length ||
+                    memcmp(q, labels + child.label, child.label_length) != 0) {
+                break;
+            }
+            node = e->child;
+            q += child.label_length;
+            if (nodes[node].key >= 0 && accept(q)) {
+                key = nodes[node].key;
+                end = q;
+            }
+        }
+        p = end;
+        return key;
+    }
+
+    // The key of exactly name, or -1.
+    int Find(const std::string& name) const {
+        const char* p = name.data();
+        const char* last = p + name.size();
+        int key = Match(p, last);
+        return (p == last) ? key : -1;
+    }
+
+private:
+    typedef NameTrieNode Node;
+    typedef NameTrieEdge Edge;
+    const Node* nodes;
+    const Edge* edges;
+    const char* labels;
+};
+
+// A trie over a table of names, such as a locale's month names or alternate
+// digits, for finding which one starts an input in a single pass over its bytes.
+class NameIndex {
+public:
+    NameIndex() {
+        Node root = {-1, 0, 0, 0, 0};
+        nodes.push_back(root);
+    }
+
+    // Indexes the non-empty names in the table by their keys. If two keys have the
+    // same name, the smaller one is found.
+    explicit NameIndex(const std::map<int, std::string>& names) {
+        std::vector<std::pair<std::string, int> > sorted;
+        for (const auto& kv: names) {
+            if (!kv.second.empty()) sorted.push_back(std::make_pair(kv.second, kv.first));
+        }
+        std::sort(sorted.begin(), sorted.end());
+        Node root = {-1, 0, 0, 0, 0};
+        nodes.push_back(root);
+        Build(0, sorted, 0, sorted.size(), 0);
+    }
+
+    bool Empty() const { return nodes.size() == 1; }
+
+    // The key of the longest name which starts [p, last), or -1. p is moved past it.
+    int Match(const char*& p, const char* last) const { return Trie().Match(p, last); }
+
+    // The same, but only names for which accept(end of the name in the input) is
+    // true count.
+    template <typename Accept>
+    int Match(const char*& p, const char* last, Accept accept) const { return Trie().Match(p, last, accept); }
+
+    // The key of exactly name, or -1.
+    int Find(const std::string& name) const { return Trie().Find(name); }
+
+private:
+    typedef NameTrieNode Node;
+    typedef NameTrieEdge Edge;
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::string labels;
+
+    NameTrie Trie() const { return NameTrie(nodes.data(), edges.data(), labels.data()); }
+
+    // Fills in node for the names in sorted[lo, hi), which share their first depth bytes.
+    void Build(unsigned node, const std::vector<std::pair<std::string, int> >& sorted, size_t lo, size_t hi,
+            size_t depth) {
+        if (lo < hi && sorted[lo].first.size() == depth) {
+            // Of equal names, the smallest key sorts first.
+            nodes[node].key = sorted[lo].second;
+            while (lo < hi && sorted[lo].first.size() == depth) ++lo;
+        }
+        // Reserve the edges first, so that they stay together.
+        std::vector<size_t> starts;
+        for (size_t i = lo; i < hi; ++i) {
+            if (i == lo || sorted[i].first[depth] != sorted[i - 1].first[depth]) starts.push_back(i);
+        }
+        const unsigned first = static_cast<unsigned>(edges.size());
+        nodes[node].first_edge = first;
+        nodes[node].edge_count = static_cast<unsigned>(starts.size());
+        for (size_t k = 0; k < starts.size(); ++k) {
+            // The child takes the bytes which all of its names share, up to the
+            // first one that ends.
+            const size_t end = (k + 1 < starts.size()) ? starts[k + 1] : hi;
+            const std::string& name = sorted[starts[k]].first;
+            size_t shared = depth + 1;
+            while (shared < name.size() && sorted[end - 1].first.size() > shared &&
+                    sorted[end - 1].first[shared] == name[shared]) {
+                ++shared;
+            }
+            Node child = {-1, 0, 0, static_cast<unsigned>(labels.size()),
+                static_cast<unsigned>(shared - depth - 1)};
+            labels.append(name, depth + 1, shared - depth - 1);
+            Edge e = {static_cast<unsigned char>(name[depth]), static_cast<unsigned>(nodes.size())};
+            nodes.push_back(child);
+            edges.push_back(e);
+        }
+        for (size_t k = 0; k < starts.size(); ++k) {
+            const size_t end = (k + 1 < starts.size()) ? starts[k + 1] : hi;
+            const Node& child = nodes[edges[first + k].child];
+            Build(edges[first + k].child, sorted, starts[k], end, depth + 1 + child.label_length);
+        }
+    }
+};
+
+// A POSIX TZ string such as "CET-1CEST,M3.5.0,M10.5.0/3", which TZif files end
+// with to describe the time after their last transition. Besides POSIX, hours of
+// the rule times may be negative or up to 167 (RFC 8536). A string with a DST
+// name but no rules gets the US rules, as in glibc. Valid() is false if the
+// string could not be parsed.
+class PosixRule {
+public:
+    PosixRule() : valid(false), has_dst(false), std_offset(0), dst_offset(0) {}
+
+    explicit PosixRule(const std::string& spec) : PosixRule() {
+        const char* p = spec.c_str();
+        if (!Name(p, std_name) || !Offset(p, std_offset, 24)) return;
+        std_offset = -std_offset;
+        if (*p == '\0') {
+            valid = true;
+            return;
+        }
+        if (!Name(p, dst_name)) return;
+        dst_offset = std_offset + 3600;
+        if (*p != ',' && *p != '\0') {
+            if (!Offset(p, dst_offset, 24)) return;
+            dst_offset = -dst_offset;
+        }
+        const char* rules = (*p == '\0') ? ",M3.2.0,M11.1.0" : p;
+        if (*rules++ != ',' || !Date(rules, start) || *rules++ != ',' || !Date(rules, end) || *rules != '\0') {
+            return;
+        }
+        valid = has_dst = true;
+    }
+
+    bool Valid() const { return valid; }
+    bool HasDST() const { return has_dst; }
+
+    // Seconds ahead of UTC, and abbreviations, of standard and daylight saving time.
+    int StdOffset() const { return std_offset; }
+    int DSTOffset() const { return dst_offset; }
+    const std::string& StdName() const { return std_name; }
+    const std::string& DSTName() const { return dst_name; }
+
+    // When daylight saving time starts and ends in the given year, in seconds since
+    // the epoch in UTC. In the southern hemisphere, end comes before start.
+    void Transitions(long long year, long long& start_utc, long long& end_utc) const {
+        start_utc = Local(start, year) - std_offset;
+        end_utc = Local(end, year) - dst_offset;
+    }
+
+private:
+    struct Rule {
+        char kind;  // 'J' (1-365, no February 29th), 'D' (0-365) or 'M'
+        int month;  // kind M
+        int week;   // kind M, 1-5; 5 is the last
+        int day;    // the day for J and D, the weekday (0 = Sunday) for M
+        int time;   // seconds after local midnight
+    };
+
+    bool valid;
+    bool has_dst;
+    int std_offset;
+    int dst_offset;
+    std::string std_name;
+    std::string dst_name;
+    Rule start;
+    Rule end;
+
+    static long long Local(const Rule& r, long long year) {
+        typedef GregorianCalendar C;
+        long long day;
+        if (r.kind == 'J') {
+            day = C::DaysFromCivil(year, 1, 1) + r.day - 1 + (C::IsLeap(year) && r.day >= 60);
+        } else if (r.kind == 'D') {
+            day = C::DaysFromCivil(year, 1, 1) + r.day;
+        } else {
+            const long long first = C::DaysFromCivil(year, r.month, 1);
+            day = first + (r.day - C::WeekdayFromDays(first) + 7) % 7 + (r.week - 1) * 7;
+            while (day >= first + C::DaysInMonth(year, r.month)) day -= 7;
+        }
+        return day * C::SecondsPerDay + r.time;
+    }
+
+    static bool Number(const char*& p, int lo, int hi, int& n) {
+        if (!isdigit(static_cast<unsigned char>(*p))) return false;
+        n = 0;
+        while (isdigit(static_cast<unsigned char>(*p))) {
+            n = n * 10 + (*p++ - '0');
+            if (n > hi) return false;
+        }
+        return n >= lo;
+    }
+
+    // <...> or three or more letters.
+    static bool Name(const char*& p, std::string& name) {
+        const char* first = p;
+        if (*p == '<') {
+            first = ++p;
+            while (isalnum(static_cast<unsigned char>(*p)) || *p == '+' || *p == '-') ++p;
+            if (*p != '>') return false;
+            name.assign(first, p++);
+        } else {
+            while (isalpha(static_cast<unsigned char>(*p))) ++p;
+            name.assign(first, p);
+        }
+        return name.size() >= 3;
+    }
+
+    // [+-]hh[:mm[:ss]], in seconds.
+    static bool Offset(const char*& p, int& seconds, int max_hours) {
+        int sign = 1, h, m = 0, sec = 0;
+        if (*p == '+' || *p == '-') sign = (*p++ == '-') ? -1 : 1;
+        if (!Number(p, 0, max_hours, h)) return false;
+        if (*p == ':' && !Number(++p, 0, 59, m)) return false;
+        if (*p == ':' && !Number(++p, 0, 59, sec)) return false;
+        seconds = sign * (h * 3600 + m * 60 + sec);
+        return true;
+    }
+
+    static bool Date(const char*& p, Rule& r) {
+        r.month = r.week = 0;
+        if (*p == 'J') {
+            r.kind = 'J';
+            if (!Number(++p, 1, 365, r.day)) return false;
+        } else if (*p == 'M') {
+            r.kind = 'M';
+            if (!Number(++p, 1, 12, r.month) || *p++ != '.' || !Number(p, 1, 5, r.week) ||
+                *p++ != '.' || !Number(p, 0, 6, r.day)) {
+                return false;
+            }
+        } else {
+            r.kind = 'D';
+            if (!Number(p, 0, 365, r.day)) return false;
+        }
+        r.time = 2 * 3600;
+        return *p != '/' || Offset(++p, r.time, 167);
+    }
+};
+
+// The offset of a zone over time, built from the transitions of a Timezone: from
+// utc[i] on, the zone is gmtoff[i] seconds ahead of UTC, with abbreviation
+// tzname[i] and DST flag dst[i]. The first entry also holds before utc[0]. A zone
+// without transitions has the fixed offset gmtoff[0].
+//
+// The transitions are kept in Eytzinger (BFS) order, once by UTC and once by local
+// time, so that a lookup is a branchless descent whose first levels share a few
+// cache lines. Each node carries the offset, abbreviation and DST flag in effect
+// before its transition next to its time, so the node where the search ends holds
+// the answer.
+//
+// After the last transition, a zone whose rule string has daylight saving time
+// follows that rule. The transitions of a year are worked out when it is first
+// looked up, and kept in a small cache of recent years.
+class ZoneTransitions {
+public:
+    struct Info {
+        int gmtoff;          // seconds
+        unsigned short abbr; // index for Abbreviation()
+        unsigned char dst;
+    };
+
+    ZoneTransitions() : by_utc(1), by_local(1), rule_after_utc(LLONG_MAX), rule_after_local(LLONG_MAX) {
+        Info none = {0, 0, 0};
+        last = none;
+        abbrs.push_back(std::string());
+    }
+
+    explicit ZoneTransitions(const Timezone& zone)
+        : by_utc(1), by_local(1), rule_after_utc(LLONG_MAX), rule_after_local(LLONG_MAX) {
+        const size_t n = std::min(zone.utc.size(), zone.gmtoff.size());
+        std::vector<Info> infos;
+        for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) {
+            Info info = {i < zone.gmtoff.size() ? zone.gmtoff[i] : 0,
+                Abbr(i < zone.tzname.size() ? zone.tzname[i] : zone.name),
+                static_cast<unsigned char>(i < zone.dst.size() && zone.dst[i] != 0)};
+            infos.push_back(info);
+        }
+        last = infos.back();
+
+        // (time of transition i, what held before it), by UTC and by local time.
+        std::vector<Node> utc, local;
+        for (size_t i = 0; i < n; ++i) {
+            const Info& before = infos[i == 0 ? 0 : i - 1];
+            const long long u = static_cast<long long>(zone.utc[i]);
+            Node a = {u, before};
+            Node b = {i < zone.local.size() ? static_cast<long long>(zone.local[i]) : u + infos[i].gmtoff, before};
+            utc.push_back(a);
+            local.push_back(b);
+        }
+        Layout(utc, by_utc);
+        Layout(local, by_local);
+
+        rule = PosixRule(zone.rule);
+        if (rule.Valid() && rule.HasDST()) {
+            const Info std_time = {rule.StdOffset(), Abbr(rule.StdName()), 0};
+            const Info dst_time = {rule.DSTOffset(), Abbr(rule.DSTName()), 1};
+            std_info = std_time;
+            dst_info = dst_time;
+            rule_after_utc = rule_after_local = LLONG_MIN;
+            for (size_t i = 0; i < n; ++i) {
+                rule_after_utc = std::max(rule_after_utc, utc[i].at);
+                rule_after_local = std::max(rule_after_local, local[i].at);
+            }
+        }
+    }
+
+    // What holds at t, in seconds since the epoch in UTC.
+    const Info& AtUTC(long long t) const {
+        return (t > rule_after_utc) ? FromRule(by_utc, t, NULL) : Find(by_utc, t);
+    }
+
+    // The same for t in the zone's local time. A local time which happens twice
+    // takes the later offset, and one which is skipped the earlier.
+    const Info& AtLocal(long long t) const {
+        return (t > rule_after_local) ? FromRule(by_local, t, NULL) : Find(by_local, t);
+    }
+
+    // The interval [start, end) between two transitions which the last lookup fell
+    // in, and what holds there. Times in a stream are usually close together, so
+    // the next lookup is mostly answered from here without a search. A Hint may be
+    // shared between tables, but must not outlive the ones it has been used with.
+    struct Hint {
+        const void* table;
+        long long start;
+        long long end;
+        Info info;
+
+        Hint() : table(NULL), start(0), end(0), info() {}
+    };
+
+    const Info& AtUTC(long long t, Hint& hint) const { return Find(by_utc, t, hint); }
+    const Info& AtLocal(long long t, Hint& hint) const { return Find(by_local, t, hint); }
+
+    // For a local time which happens twice, what held the first time, which is the
+    // offset before the transition back. Other times get the same as AtLocal().
+    const Info& AtLocalFirst(long long t) const {
+        const Info& later = AtLocal(t);
+        size_t j = 0; // the last transition at or before t, or 0
+        for (size_t k = 1; k < by_local.size(); k = 2 * k + (by_local[k].at <= t)) {
+            if (by_local[k].at <= t) j = k;
+        }
+        if (j != 0) {
+            const Info& after = (t > rule_after_local) ? last : later;
+            const Info& before = by_local[j].before;
+            if (t < by_local[j].at - after.gmtoff + before.gmtoff) return before;
+        }
+        if (t > rule_after_local && &later == &std_info) {
+            typedef GregorianCalendar C;
+            long long year, start, end;
+            int month, day;
+            C::CivilFromDays(C::FloorDiv(t, C::SecondsPerDay), year, month, day);
+            years.Get(rule, year, start, end);
+            if (end + rule.StdOffset() <= t && t < end + rule.DSTOffset()) return dst_info;
+        }
+        return later;
+    }
+
+    // The rule for the time after the last transition, if the zone has one.
+    const PosixRule& Rule() const { return rule; }
+
+    const std::string& Abbreviation(const Info& info) const { return abbrs[info.abbr]; }
+
+    size_t Size() const { return by_utc.size() - 1; }
+
+private:
+    struct Node {
+        long long at;
+        Info before;
+    };
+
+    // Recently used years of the rule, by year modulo the number of slots. Each
+    // slot is a seqlock, so lookups from several threads don't take a lock: a
+    // reader which sees the slot change under it works the year out itself, and
+    // a writer which finds the slot busy doesn't store its result. Copies start
+    // empty.
+    class YearCache {
+    public:
+        YearCache() {}
+        YearCache(const YearCache&) {}
+        YearCache& operator=(const YearCache&) {
+            for (Slot& slot: slots) {
+                slot.seq.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.year.store(LLONG_MIN, std::memory_order_relaxed);
+                slot.seq.fetch_add(1, std::memory_order_release);
+            }
+            return *this;
+        }
+
+        void Get(const PosixRule& rule, long long year, long long& start, long long& end) const {
+            Slot& slot = slots[year & (size - 1)];
+            unsigned seq = slot.seq.load(std::memory_order_acquire);
+            if (!(seq & 1) && slot.year.load(std::memory_order_relaxed) == year) {
+                start = slot.start.load(std::memory_order_relaxed);
+                end = slot.end.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == seq) return;
+            }
+            rule.Transitions(year, start, end);
+            if (!(seq & 1) && slot.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.year.store(year, std::memory_order_relaxed);
+                slot.start.store(start, std::memory_order_relaxed);
+                slot.end.store(end, std::memory_order_relaxed);
+                slot.seq.store(seq + 2, std::memory_order_release);
+            }
+        }
+
+    private:
+        static const unsigned size = 8;
+        struct Slot {
+            std::atomic<unsigned> seq;
+            std::atomic<long long> year;
+            std::atomic<long long> start;
+            std::atomic<long long> end;
+            Slot() : seq(0), year(LLONG_MIN), start(0), end(0) {}
+        };
+        mutable Slot slots[size];
+    };
+
+    // 1-based; node k has children 2k and 2k + 1.
+    std::vector<Node> by_utc;
+    std::vector<Node> by_local;
+    Info last;
+    std::vector<std::string> abbrs;
+    // The rule holds after these times, which are LLONG_MAX if there is none.
+    PosixRule rule;
+    long long rule_after_utc;
+    long long rule_after_local;
+    Info std_info;
+    Info dst_info;
+    YearCache years;
+
+    // What the rule gives for t, which is in UTC for by_utc and in local time for
+    // by_local. With a hint, also notes the interval around t until the next change
+    // or the end of the year.
+    const Info& FromRule(const std::vector<Node>& tree, long long t, Hint* hint) const {
+        typedef GregorianCalendar C;
+        const bool local = &tree == &by_local;
+        const long long shift = local ? 0 : rule.StdOffset();
+        long long year;
+        int month, day;
+        C::CivilFromDays(C::FloorDiv(t + shift, C::SecondsPerDay), year, month, day);
+        long long start, end;
+        years.Get(rule, year, start, end);
+        if (local) {
+            // Skipped local times are before the start, and repeated ones after the end.
+            start += rule.DSTOffset();
+            end += rule.StdOffset();
+        }
+        const bool dst = (start < end) ? (start <= t && t < end) : !(end <= t && t < start);
+        const Info& info = dst ? dst_info : std_info;
+        if (hint != NULL) {
+            long long lo = std::max(C::DaysFromCivil(year, 1, 1) * C::SecondsPerDay - shift,
+                                    (local ? rule_after_local : rule_after_utc) + 1);
+            long long hi = C::DaysFromCivil(year + 1, 1, 1) * C::SecondsPerDay - shift;
+            for (long long at: {start, end}) {
+                if (at <= t) lo = std::max(lo, at);
+                else hi = std::min(hi, at);
+            }
+            hint->table = &tree;
+            hint->start = lo;
+            hint->end = hi;
+            hint->info = info;
+            return hint->info;
+        }
+        return info;
+    }
+
+    unsigned short Abbr(const std::string& name) {
+        for (size_t i = 0; i < abbrs.size(); ++i) {
+            if (abbrs[i] == name) return static_cast<unsigned short>(i);
+        }
+        abbrs.push_back(name);
+        return static_cast<unsigned short>(abbrs.size() - 1);
+    }
+
+    static void Layout(std::vector<Node>& sorted, std::vector<Node>& tree) {
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Node& a, const Node& b) { return a.at < b.at; });
+        tree.resize(sorted.size() + 1);
+        size_t i = 0;
+        Fill(sorted, tree, i, 1);
+    }
+
+    static void Fill(const std::vector<Node>& sorted, std::vector<Node>& tree, size_t& i, size_t k) {
+        if (k >= tree.size()) return;
+        Fill(sorted, tree, i, 2 * k);
+        tree[k] = sorted[i++];
+        Fill(sorted, tree, i, 2 * k + 1);
+    }
+
+    // Descends to the first transition after t. The turns taken are the bits of k,
+    // so dropping the trailing right turns (and the one left turn before them)
+    // gives that node, or 0 if every transition is at or before t.
+    const Info& Find(const std::vector<Node>& tree, long long t) const {
+        const size_t n = tree.size();
+        size_t k = 1;
+        while (k < n) {
+            k = 2 * k + (tree[k].at <= t);
+        }
+        k >>= TrailingOnes(k) + 1;
+        return k ? tree[k].before : last;
+    }
+
+    // As above, also noting the last transition at or before t, which is the last
+    // node where the descent turned right.
+    const Info& Find(const std::vector<Node>& tree, long long t, Hint& hint) const {
+        if (hint.table == &tree && hint.start <= t && t < hint.end) {
+            return hint.info;
+        }
+        if (t > (&tree == &by_utc ? rule_after_utc : rule_after_local)) {
+            return FromRule(tree, t, &hint);
+        }
+        const size_t n = tree.size();
+        long long start = LLONG_MIN;
+        size_t k = 1;
+        while (k < n) {
+            const bool right = tree[k].at <= t;
+            start = right ? tree[k].at : start;
+            k = 2 * k + right;
+        }
+        k >>= TrailingOnes(k) + 1;
+        const long long after = (&tree == &by_utc) ? rule_after_utc : rule_after_local;
+        hint.table = &tree;
+        hint.start = start;
+        hint.end = k ? tree[k].at : after + (after < LLONG_MAX);
+        hint.info = k ? tree[k].before : last;
+        return hint.info;
+    }
+
+    static int TrailingOnes(size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        int n = 0;
+        while (k & 1) { k >>= 1; ++n; }
+        return n;
+#endif
+    }
+};
+
+#ifdef X_DATETIME_ZONEINFO
+// Decodes a TZif file (RFC 8536) into zone. Version 2 and later files are read from
+// their 64-bit part, and the POSIX TZ string after it becomes the zone's rule.
+// Returns false if the data is not a well-formed TZif file.
+static inline bool DecodeTZif(const unsigned char* data, size_t size, const std::string& name, Timezone& zone) {
+    struct Reader {
+        static long long Int(const unsigned char* p, size_t bytes) {
+            unsigned long long v = 0;
+            for (size_t i = 0; i < bytes; ++i) v = (v << 8) | p[i];
+            if (bytes < 8 && (v >> (8 * bytes - 1))) v -= 1ULL << (8 * bytes);
+            return static_cast<long long>(v);
+        }
+    };
+    const size_t header_size = 44;
+    size_t time_size = 4;
+    const unsigned char* p = data;
+    const unsigned char* end = data + size;
+    unsigned long long counts[6]; // isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt
+    const unsigned char* footer = end;
+    for (;;) {
+        if (static_cast<size_t>(end - p) < header_size || memcmp(p, "TZif", 4) != 0) return false;
+        for (int i = 0; i < 6; ++i) {
+            counts[i] = static_cast<unsigned long long>(Reader::Int(p + 20 + 4 * i, 4)) & 0xffffffffULL;
+        }
+        const unsigned long long body = counts[3] * (time_size + 1) + counts[4] * 6 + counts[5] +
+            counts[2] * (time_size + 4) + counts[1] + counts[0];
+        if (body > static_cast<size_t>(end - p) - header_size) return false;
+        if (p[4] == 0 || time_size == 8) {
+            footer = p + header_size + body;
+            break;
+        }
+        // Skip the 32-bit part of a version 2 file for the 64-bit one after it.
+        p += header_size + body;
+        time_size = 8;
+    }
+    const size_t timecnt = counts[3], typecnt = counts[4], charcnt = counts[5];
+    if (typecnt == 0 || charcnt == 0) return false;
+    const unsigned char* times = p + header_size;
+    const unsigned char* indices = times + timecnt * time_size;
+    const unsigned char* types = indices + timecnt;
+    const char* chars = reinterpret_cast<const char*>(types + typecnt * 6);
+    for (size_t i = 0; i < typecnt; ++i) {
+        if (types[6 * i + 5] >= charcnt) return false;
+    }
+
+    Timezone decoded;
+    decoded.name = name;
+    // Type 0 holds before the first transition.
+    const auto push = [&](long long at, size_t type) {
+        const unsigned char* t = types + 6 * type;
+        const int gmtoff = static_cast<int>(Reader::Int(t, 4));
+        decoded.utc.push_back(static_cast<time_t>(at));
+        decoded.local.push_back(static_cast<time_t>(at + gmtoff));
+        decoded.gmtoff.push_back(gmtoff);
+        decoded.dst.push_back(t[4] != 0);
+        decoded.tzname.push_back(std::string(chars + t[5], strnlen(chars + t[5], charcnt - t[5])));
+    };
+    for (size_t i = 0; i < timecnt; ++i) {
+        if (indices[i] >= typecnt) return false;
+        const long long at = Reader::Int(times + i * time_size, time_size);
+        if (i > 0 && at <= static_cast<long long>(decoded.utc.back())) return false;
+        if (i == 0 && indices[0] != 0) push(at, 0);
+        push(at, indices[i]);
+    }
+    if (timecnt == 0) {
+        push(0, 0);
+        decoded.utc.clear();
+        decoded.local.clear();
+    }
+    // Version 2 and later end with the rule between two newlines.
+    if (time_size == 8 && footer < end && *footer == '\n') {
+        const unsigned char* nl = static_cast<const unsigned char*>(memchr(footer + 1, '\n', end - footer - 1));
+        if (nl != NULL) decoded.rule.assign(reinterpret_cast<const char*>(footer + 1), nl - footer - 1);
+    }
+    zone = decoded;
+    return true;
+}
+
+// Loads the zone called name from the TZif file dir/name, such as
+// /usr/share/zoneinfo/Europe/Berlin. The file is mapped rather than read. Names
+// which could leave dir are refused.
+static inline bool LoadZoneInfo(const std::string& dir, const std::string& name, Timezone& zone) {
+    if (name.empty() || name.size() > 255 || name[0] == '/' || name[0] == '.' ||
+        name.find("..") != std::string::npos) {
+        return false;
+    }
+    for (char c: name) {
+        if (!isalnum(static_cast<unsigned char>(c)) && !strchr("/_+-.", c)) return false;
+    }
+    const std::string path = dir + "/" + name;
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    bool ok = false;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            ok = DecodeTZif(static_cast<const unsigned char*>(data), size, name, zone);
+            munmap(data, size);
+        }
+    }
+    close(fd);
+    return ok;
+}
+#endif /* X_DATETIME_ZONEINFO */
+
+// Process-wide table of time zones. Every zone gets a small TimezoneId handle the
+// first time it is seen, so DateTime only has to carry the handle around instead
+// of a full Timezone. The built-in zones are registered once, on first use, and
+// are never modified afterwards. Zones which are not built in (e.g. constructed
+// by the caller) are appended under a lock, but handles are resolved without one.
+class TimezoneRegistry
+{
+    public:
+        static TimezoneRegistry& getInstance()
+        {
+            static TimezoneRegistry instance; // Guaranteed to be destroyed.
+                                              // Instantiated on first use.
+            return instance;
+        }
+
+        // Returns false if no zone with this name has been registered. This never
+        // touches the file system, so it is what parsing uses for names in the input.
+        bool Find(const std::string& name, TimezoneId& id) {
+            if (FindBuiltin(name, id)) {
+                return true;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = ids.find(name);
+            if (it == ids.end()) {
+                return false;
+            }
+            id = it->second;
+            return true;
+        }
+
+        // Like Find(), but a zone which is not registered yet is loaded from the
+        // zoneinfo directory. The file is read without holding the lock. Names which
+        // were not found are remembered, the most recent max_missing of them, so
+        // that asking again doesn't go to the disk.
+        bool Load(const std::string& name, TimezoneId& id) {
+            if (Find(name, id)) {
+                return true;
+            }
+#ifdef X_DATETIME_ZONEINFO
+            std::string dir;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto m = missing.find(name);
+                if (m != missing.end()) {
+                    missing_order.splice(missing_order.begin(), missing_order, m->second);
+                    return false;
+                }
+                dir = zoneinfo_dir;
+            }
+            Timezone zone;
+            const bool loaded = LoadZoneInfo(dir, name, zone);
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = ids.find(name);
+            if (it != ids.end()) {
+                id = it->second; // another thread loaded it first
+                return true;
+            }
+            if (loaded) {
+                id = Append(zone);
+                ids[name] = id;
+                return true;
+            }
+            if (missing.count(name) == 0) {
+                missing_order.push_front(name);
+                missing[name] = missing_order.begin();
+                if (missing.size() > max_missing) {
+                    missing.erase(missing_order.back());
+                    missing_order.pop_back();
+                }
+            }
+#endif
+            return false;
+        }
+
+#ifdef X_DATETIME_ZONEINFO
+        // Where zones which are not built in are loaded from. This is $TZDIR, or
+        // /usr/share/zoneinfo if it is not set. Zones already loaded stay.
+        void SetZoneInfoDirectory(const std::string& dir) {
+            std::lock_guard<std::mutex> lock(mutex);
+            zoneinfo_dir = dir;
+            missing.clear();
+            missing_order.clear();
+        }
+#endif
+
+        // Returns the handle of a zone equal to `zone`, registering it if necessary.
+        TimezoneId Intern(const Timezone& zone) {
+            TimezoneId builtin;
+            if (FindBuiltin(zone.name, builtin) && SameOffsets(Get(builtin), zone)) {
+                return builtin;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = ids.find(zone.name);
+            if (it != ids.end() && SameOffsets(Get(it->second), zone)) {
+                return it->second;
+            }
+            TimezoneId id = Append(zone);
+            ids[zone.name] = id;
+            return id;
+        }
+
+        const Timezone& Get(TimezoneId id) const { return At(id).zone; }
+
+        const ZoneTransitions& Transitions(TimezoneId id) const { return At(id).transitions; }
+
+        size_t Size() const { return count.load(std::memory_order_acquire); }
+
+        // Length of the longest zone name registered so far.
+        size_t MaxNameLength() const { return max_name_length.load(std::memory_order_acquire); }
+
+        // The names of the built-in zones (abbreviations such as CEST, long names and
+        // the UTC+h:mm offsets), for matching the zone at the start of an input.
+        // The keys are TimezoneIds.
+        static NameTrie BuiltinNames() { return NameTrie(BuiltinNameNodes, BuiltinNameEdges, BuiltinNameLabels); }
+
+    private:
+        static const unsigned chunk_bits = 8;
+        static const unsigned chunk_size = 1 << chunk_bits;
+        static const unsigned max_chunks = 65536 >> chunk_bits;
+        static const size_t max_missing = 4096;
+
+        struct Entry {
+            Timezone zone;
+            ZoneTransitions transitions;
+        };
+
+        // The built-in zones are read from their constant tables the first time
+        // each one is used, so that only the zones a program uses cost anything.
+        mutable std::atomic<Entry*> builtins[BuiltinZoneCount];
+        // Other zones are stored in fixed-size chunks which are never moved, so that
+        // a reference returned by Get() stays valid while other zones are appended.
+        // Their handles follow the built-in ones.
+        std::atomic<Entry*> chunks[max_chunks];
+        std::atomic<size_t> count;
+        std::atomic<size_t> max_name_length;
+        std::map<std::string, TimezoneId> ids; // guarded by mutex
+#ifdef X_DATETIME_ZONEINFO
+        std::string zoneinfo_dir; // guarded by mutex
+        // Names not found in zoneinfo_dir, most recently asked for first.
+        std::list<std::string> missing_order; // guarded by mutex
+        std::map<std::string, std::list<std::string>::iterator> missing; // guarded by mutex
+#endif
+        std::mutex mutex;
+
+        TimezoneRegistry(): count(BuiltinZoneCount), max_name_length(BuiltinNameMaxLength) {
+            for (unsigned i = 0; i < max_chunks; ++i) {
+                chunks[i].store(nullptr, std::memory_order_relaxed);
+            }
+            // The built-in zones take the handles of the TimezoneId enum, so UTC
+            // gets handle 0. Their names are looked up in the generated trie.
+            for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+                builtins[i].store(nullptr, std::memory_order_relaxed);
+            }
+#ifdef X_DATETIME_ZONEINFO
+            const char* tzdir = getenv("TZDIR");
+            zoneinfo_dir = (tzdir != NULL && *tzdir != '\0') ? tzdir : "/usr/share/zoneinfo";
+#endif
+        }
+
+        const Entry& At(TimezoneId id) const {
+            if (id < BuiltinZoneCount) {
+                const Entry* entry = builtins[id].load(std::memory_order_acquire);
+                return entry ? *entry : LoadBuiltin(id);
+            }
+            // Pairs with the store of count in Append(), which comes after the entry is built.
+            count.load(std::memory_order_acquire);
+            const size_t n = id - BuiltinZoneCount;
+            return chunks[n >> chunk_bits].load(std::memory_order_acquire)[n & (chunk_size - 1)];
+        }
+
+        // Threads which get here at once each build the entry, and all but the
+        // first to publish it throw theirs away.
+        const Entry& LoadBuiltin(TimezoneId id) const {
+            Entry* entry = new Entry;
+            entry->zone = BuiltinTimezone(BuiltinZones[id]);
+            entry->transitions = ZoneTransitions(entry->zone);
+            Entry* published = nullptr;
+            if (!builtins[id].compare_exchange_strong(published, entry, std::memory_order_acq_rel)) {
+                delete entry;
+                return *published;
+            }
+            return *entry;
+        }
+
+        static Timezone BuiltinTimezone(const BuiltinZone& builtin) {
+            Timezone zone;
+            zone.name = builtin.name;
+            zone.rule = builtin.rule;
+            if (builtin.count == 0) {
+                zone.gmtoff.push_back(builtin.gmtoff);
+            }
+            for (unsigned i = builtin.first; i < builtin.first + builtin.count; ++i) {
+                const BuiltinTransition& t = BuiltinTransitions[i];
+                zone.utc.push_back(static_cast<time_t>(t.utc));
+                zone.local.push_back(static_cast<time_t>(t.utc + t.gmtoff));
+                zone.tzname.push_back(BuiltinAbbreviations[t.abbr]);
+                zone.dst.push_back(t.dst);
+                zone.gmtoff.push_back(t.gmtoff);
+            }
+            return zone;
+        }
+
+        bool FindBuiltin(const std::string& name, TimezoneId& id) const {
+            const int key = BuiltinNames().Find(name);
+            if (key < 0) {
+                return false;
+            }
+            id = static_cast<TimezoneId>(key);
+            return true;
+        }
+
+        ~TimezoneRegistry() {
+            for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+                delete builtins[i].load(std::memory_order_relaxed);
+            }
+            for (unsigned i = 0; i < max_chunks; ++i) {
+                delete[] chunks[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        static bool SameOffsets(const Timezone& a, const Timezone& b) {
+            return a.gmtoff == b.gmtoff && a.utc == b.utc && a.rule == b.rule;
+        }
+
+        TimezoneId Append(const Timezone& zone) {
+            const size_t id = count.load(std::memory_order_relaxed);
+            if (id >= max_chunks * chunk_size) {
+                throw std::length_error("Too many time zones");
+            }
+            const size_t n = id - BuiltinZoneCount;
+            Entry* chunk = chunks[n >> chunk_bits].load(std::memory_order_relaxed);
+            const bool fresh = chunk == nullptr;
+            if (fresh) {
+                chunk = new Entry[chunk_size];
+            }
+            chunk[n & (chunk_size - 1)].zone = zone;
+            chunk[n & (chunk_size - 1)].transitions = ZoneTransitions(zone);
+            // A new chunk is only published once its first entry is built.
+            if (fresh) {
+                chunks[n >> chunk_bits].store(chunk, std::memory_order_release);
+            }
+            if (zone.name.size() > max_name_length.load(std::memory_order_relaxed)) {
+                max_name_length.store(zone.name.size(), std::memory_order_release);
+            }
+            count.store(id + 1, std::memory_order_release);
+            return static_cast<TimezoneId>(id);
+        }
+
+    public:
+        TimezoneRegistry(TimezoneRegistry const&)   = delete;
+        void operator=(TimezoneRegistry const&)     = delete;
+};
+
+// Resolves a zone name to its handle, loading it from the zoneinfo directory if it
+// is neither built in nor registered yet. Throws std::out_of_range if the zone
+// does not exist. Resolve names once and keep the handle around.
+static inline TimezoneId TZId(const std::string& name) {
+    TimezoneId id;
+    if (!TimezoneRegistry::getInstance().Load(name, id)) {
+        throw std::out_of_range("Timezone not found");
+    }
+    return id;
+}
+
+#ifdef X_DATETIME_ZONEINFO
+// Sets the directory which zones that are not built in, such as "Europe/Berlin",
+// are loaded from by TZId(). The default is $TZDIR or /usr/share/zoneinfo.
+static inline void SetZoneInfoDirectory(const std::string& dir) {
+    TimezoneRegistry::getInstance().SetZoneInfoDirectory(dir);
+}
+#endif
+
+static inline const Timezone& TZ(TimezoneId id) { return TimezoneRegistry::getInstance().Get(id); }
+static inline const Timezone& TZ(const std::string& name) { return TZ(TZId(name)); }
+static inline const ZoneTransitions& TZTransitions(TimezoneId id) {
+    return TimezoneRegistry::getInstance().Transitions(id);
+}
+}
+
 #ifndef X_DATETIME_NO_LOCALES
 #include "x_datetime_locale_data.h"
 #else
@@ -452,23 +1594,10 @@ class LocaleData
         }
 
         static bool IsValidLocaleAltDigit(std::string locale, std::string num) {
-            LocaleData& d = LocaleData::getInstance();
-            std::map<int, std::string> a;
-            try {
-                a = d.data.short_weekdays[locale];
-            }
-            catch (std::out_of_range& e) {
-                throw MalformedDateTime("Locale not found");
-            }
-            for (int i = 0; i < a.size(); ++i) {
-                if (a[i] == num) {
-                    return true;
-                }
-            }
-            return false;
-        }
-
-        static std::string GetAltDigit(std::string locale, int num) {
+            return GetNameIndex(GetAltDigits(locale)).Find(num) >= 0;
+        }
+
+        static std::string GetAltDigit(std::string locale, int num) {
             LocaleData& d = LocaleData::getInstance();
             std::map<int, std::string> a;
             try {
@@ -486,20 +1615,51 @@ class LocaleData
         }
 
         static int GetReverseAltDigit(std::string locale, std::string num) {
-            LocaleData& d = LocaleData::getInstance();
-            std::map<int, std::string> a;
-            try {
-                a = d.data.alt_digits[locale];
-            }
-            catch (std::out_of_range& e) {
-                throw MalformedDateTime("Locale not found");
-            }
-            for (int i = 0; i < a.size(); ++i) {
-                if (d.data.alt_digits[locale][i] == num) {
-                    return i;
-                }
+            int digit = GetNameIndex(GetAltDigits(locale)).Find(num);
+            if (digit < 0) {
+                throw MalformedDateTime("Alternate digit not found");
             }
-            throw MalformedDateTime("Alternate digit not found");
+            return digit;
+        }
+
+        // Whether the locale's tables were compiled in. The accessors below throw
+        // for locales which were not.
+        static bool HasLocale(const std::string& locale) {
+            const _LocaleData& d = LocaleData::getInstance().data;
+            return d.long_months.find(locale) != d.long_months.end();
+        }
+
+        // These return the locale's tables by reference, for callers which cache the
+        // names once instead of looking them up on every call (see FormatPlan).
+        static const std::map<int, std::string>& GetLongMonths(const std::string& locale) {
+            return Find(LocaleData::getInstance().data.long_months, locale);
+        }
+
+        static const std::map<int, std::string>& GetShortMonths(const std::string& locale) {
+            return Find(LocaleData::getInstance().data.short_months, locale);
+        }
+
+        static const std::map<int, std::string>& GetLongWeekdays(const std::string& locale) {
+            return Find(LocaleData::getInstance().data.long_weekdays, locale);
+        }
+
+        static const std::map<int, std::string>& GetShortWeekdays(const std::string& locale) {
+            return Find(LocaleData::getInstance().data.short_weekdays, locale);
+        }
+
+        static const std::map<int, std::string>& GetAltDigits(const std::string& locale) {
+            return Find(LocaleData::getInstance().data.alt_digits, locale);
+        }
+
+        // A NameIndex over one of the tables returned above, built the first time it
+        // is asked for and shared from then on.
+        static const NameIndex& GetNameIndex(const std::map<int, std::string>& names) {
+            static std::mutex m;
+            static std::map<const void*, std::unique_ptr<NameIndex> > indexes;
+            std::lock_guard<std::mutex> guard(m);
+            std::unique_ptr<NameIndex>& index = indexes[&names];
+            if (!index) index.reset(new NameIndex(names));
+            return *index;
         }
 
         template <typename Length>
@@ -516,6 +1676,16 @@ class LocaleData
 
     private:
 	_LocaleData data;
+
+        template <typename T>
+        static const T& Find(const std::map<std::string, T>& m, const std::string& locale) {
+            auto it = m.find(locale);
+            if (it == m.end()) {
+                throw MalformedDateTime("Locale not found");
+            }
+            return it->second;
+        }
+
         LocaleData() {                    // Constructor? (the {} brackets) are needed here.
             InitializeLocaleData(this->data);
         }
@@ -534,2368 +1704,2172 @@ class LocaleData
         //       before deleted status
 };
 
-class GregorianCalendar {
-    //TODO this is a stub.
+// A broken-down date and time, as returned by DateTime::Fields().
+// Use it to read several fields at once; each of the single field accessors
+// (Year(), Month(), ...) has to split the tick count again.
+struct CivilTime {
+    long long year;
+    int month;      // 1-12
+    int day;        // 1-31
+    int yday;       // day of the year, 1-366
+    int wday;       // day of the week, 0 = Sunday as in struct tm (DayOfWeek() is one more than this)
+    int hour;       // 0-23
+    int minute;     // 0-59
+    int second;     // 0-59
+    int nanosecond; // fraction of the second, in nanoseconds
 };
 
-#ifndef X_DATETIME_NO_LOCALES
-#define UTF8_CHAR_LEN( byte ) (( 0xE5000000 >> (( byte >> 3 ) & 0x1e )) & 3 ) + 1
-#endif
-
 template <typename Calendar, typename Clock, typename Period> class DateTime;
-template <typename Ratio> class TimeDelta;
-template <typename Calendar, typename Clock, typename Period> class DateTimePeriod;
-
-template <typename Char, typename Traits, typename Ratio>
-static inline std::basic_ostream<Char, Traits> &
-operator<<(std::basic_ostream<Char, Traits> &os, const TimeDelta<Ratio> &obj);
-
-
-template <typename Char, typename Traits, typename Calendar, typename Clock, typename Period>
-static inline std::basic_ostream<Char, Traits> &
-operator<<(std::basic_ostream<Char, Traits> &os, const DateTime<Calendar, Clock, Period> &obj);
-
-
-template <typename Char, typename Traits, typename Calendar, typename Clock, typename Period>
-static inline std::basic_ostream<Char, Traits> &
-operator<<(std::basic_ostream<Char, Traits> &os, const DateTimePeriod<Calendar, Clock, Period> &obj);
 
-template <typename Ratio>
-static inline TimeDelta<Ratio> operator+(const TimeDelta<Ratio> &a, const TimeDelta<Ratio> &b);
-
-template <typename Ratio>
-static inline TimeDelta<Ratio> operator-(const TimeDelta<Ratio> &a, const TimeDelta<Ratio> &b);
-
-template <typename Calendar, typename Clock, typename Period>
-static inline DateTime<Calendar, Clock, Period> operator+(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b);
-
-template <typename Calendar, typename Clock, typename Period>
-static inline DateTime<Calendar, Clock, Period> operator+(const TimeDelta<Period> &a, const DateTime<Calendar, Clock, Period> &b);
-
-template <typename Calendar, typename Clock, typename Period>
-static inline TimeDelta<Period> operator-(const DateTime<Calendar, Clock, Period> &a, const DateTime<Calendar, Clock, Period> &b);
+// One step of a FormatPlan. Either a run of literal text, or a single conversion.
+struct FormatOp {
+    char spec;              // conversion character, or 0 for literal text
+    bool alt;               // %O: print numbers with the locale's alternative digits
+    unsigned char width;    // minimum number of digits for numeric conversions
+    char pad;               // padding for numeric conversions, '0' or ' '
+    unsigned int offset;    // literal text, as a range in FormatPlan::text
+    unsigned int length;
+};
 
-template <typename Calendar, typename Clock, typename Period>
-static inline DateTime<Calendar, Clock, Period> operator-(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b);
+// A strftime(3) format string compiled for one locale.
+// Compiling checks the format, expands the composite conversions (%c, %x, %D, %T, ...)
+// into their parts, merges adjacent literal text and copies the locale's names, so
+// DateTime::ToString(plan) only has to walk a flat list of ops.
+// Plans are immutable once built and can be shared between threads.
+class FormatPlan {
+public:
+    explicit FormatPlan(const std::string& fmt, const std::string& locale = "C")
+        : locale(locale), has_weekdays(false), has_months(false), has_ampm(false), has_alt_digits(false) {
+        Compile(fmt, 0);
+    }
+
+    const std::string& Locale() const { return locale; }
+
+    // See xDateTime::MaxFormattedSize().
+    size_t MaxFormattedSize() const {
+        size_t size = 0;
+        for (const FormatOp& op: ops) {
+            switch (op.spec) {
+                case 0: size += op.length; break;
+                case 'a': size += Longest(short_weekdays, 7); break;
+                case 'A': size += Longest(long_weekdays, 7); break;
+                case 'b': size += Longest(short_months, 12); break;
+                case 'B': size += Longest(long_months, 12); break;
+                case 'p': size += std::max(am.size(), pm.size()); break;
+                case 'P': size += std::max(am_lower.size(), pm_lower.size()); break;
+                case 'z': size += 5; break;
+                case 'Z': size += TimezoneRegistry::getInstance().MaxNameLength(); break;
+                default: {
+                    size_t digits = std::max<size_t>(MaxDigits(op.spec), op.width);
+                    size_t digit_size = op.alt ? Longest(alt_digits, 10) : 1;
+                    size += 1 + digits * std::max<size_t>(digit_size, 1); // 1 for the sign
+                }
+            }
+        }
+        return size;
+    }
 
-template<typename Ratio = std::nano> class TimeDelta {
 private:
-    std::chrono::duration<long long, Ratio> d;
-
     template <typename Calendar, typename Clock, typename Period>
     friend class DateTime;
 
-public:
-    TimeDelta() { this->d = std::chrono::hours(0); }
+    std::string locale;
+    std::vector<FormatOp> ops;
+    std::string text;
+
+    bool has_weekdays;
+    bool has_months;
+    bool has_ampm;
+    bool has_alt_digits;
+    std::string short_weekdays[7];
+    std::string long_weekdays[7];
+    std::string short_months[12];
+    std::string long_months[12];
+    std::string am, pm, am_lower, pm_lower;
+    std::string alt_digits[10];
+
+    static size_t Longest(const std::string* names, int n) {
+        size_t size = 0;
+        for (int i = 0; i < n; ++i) size = std::max(size, names[i].size());
+        return size;
+    }
+
+    // Most digits a numeric conversion can print, not counting the sign.
+    static size_t MaxDigits(char spec) {
+        switch (spec) {
+            case '1': return 3;
+            case '2': return 6;
+            case '3': return 9;
+            case 'j': return 3;
+            case 'u':
+            case 'w': return 1;
+            case 'C': return 8;
+            case 'G':
+            case 'Y': return 10;
+            case 's': return 19;
+            default: return 2;
+        }
+    }
 
-    template <typename OldRatio = Ratio>
-    TimeDelta(const TimeDelta<OldRatio> &a) : TimeDelta(a.d) {}
+    static std::string Name(const std::map<int, std::string>& names, int key) {
+        auto it = names.find(key);
+        return (it == names.end()) ? std::string() : it->second;
+    }
 
-    template <typename OldRatio = Ratio, typename Length>
-    TimeDelta(const std::chrono::duration<Length, OldRatio>& d) {
-        long long count = static_cast<long long>(d.count());
-        long long q = count / OldRatio::den;
-        long long r = count % OldRatio::den;
-        q *= Ratio::den;
-        if (Ratio::den > OldRatio::den) {
-            r *= Ratio::den / OldRatio::den;
-        }
-        else {
-            r /= OldRatio::den / Ratio::den;
-        }
-        q += r;
-        this->d = std::chrono::duration<long long, Ratio>(q);
+    static std::string Lower(std::string data) {
+        std::transform(data.begin(), data.end(), data.begin(),
+            [](unsigned char c){ return std::tolower(c); });
+        return data;
     }
 
-#ifdef X_DATETIME_WITH_BOOST
-    TimeDelta(const boost::posix_time::time_duration& td) {
-        int FS = 0;
-#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
-        if (Ratio::den > 1000000) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (td.total_nanoseconds() % 1000000000) /
-                        (Ratio::den / 1000000000.0)) % 1000000000);
-        }
-#else
-        if (false) {}
-#endif
-        else if (Ratio::den > 1000) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (td.total_microseconds() % 1000000) /
-                        (Ratio::den / 1000000.0)) % 1000000);
-        }
-        else if (Ratio::den > 1) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (td.total_milliseconds() % 1000) /
-                        (Ratio::den / 1000.0)) % 1000);
-        }
-        *this = TimeDelta(0, td.hours(), td.minutes(), td.seconds(), FS);
+    // Conversions which accept the E and O modifiers.
+    static bool AllowsEra(char c) {
+        return strchr("cCxXyY", c) != NULL;
     }
-#endif
 
-#ifdef X_DATETIME_WITH_ABSEIL
-    TimeDelta(const absl::Duration& t) {
-        if (Ratio::den > 1000000) {
-            *this = TimeDelta(absl::ToChronoNanoseconds(t));
-        }
-        else if (Ratio::den > 1000) {
-            *this = TimeDelta(absl::ToChronoMicroseconds(t));
-        }
-        else if (Ratio::den > 1) {
-            *this = TimeDelta(absl::ToChronoMilliseconds(t));
+    static bool AllowsAlt(char c) {
+        return strchr("123deGgHIjklmMsSuUVwW", c) != NULL;
+    }
+
+    void AddLiteral(const char* p, size_t n) {
+        if (!ops.empty() && ops.back().spec == 0) {
+            ops.back().length += static_cast<unsigned int>(n);
         }
         else {
-            *this = TimeDelta(absl::ToChronoSeconds(t));
+            FormatOp op = {0, false, 0, ' ', static_cast<unsigned int>(text.size()), static_cast<unsigned int>(n)};
+            ops.push_back(op);
         }
+        text.append(p, n);
     }
-#endif
 
-    TimeDelta(long long _days) {
-        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * 60 * 24 * _days);
+    void AddConversion(char spec, bool alt, unsigned char width = 0, char pad = ' ') {
+        FormatOp op = {spec, alt, width, pad, 0, 0};
+        ops.push_back(op);
     }
 
-    TimeDelta(long long _days, long long _hours) {
-        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * 60 *
-                        (_hours + 24 * _days));
+    void AddNumber(char spec, bool alt, unsigned char width, char pad) {
+        if (alt && !has_alt_digits) {
+            const std::map<int, std::string>& digits = LocaleData::GetAltDigits(locale);
+            for (int i = 0; i < 10; ++i) alt_digits[i] = Name(digits, i);
+            has_alt_digits = true;
+        }
+        AddConversion(spec, alt, width, pad);
     }
 
-    TimeDelta(long long _days, long long _hours, long long _minutes) {
-        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * (_minutes + 60 *
-                        (_hours + 24 * _days)));
-    }
+    void Compile(const std::string& fmt, int depth) {
+        // Locale formats only refer to simple conversions, but don't let a bad table recurse forever.
+        if (depth > 4) { throw MalformedDateTime("Bad format specifier"); }
 
-    TimeDelta(long long _days, long long _hours, long long _minutes, long long _seconds) {
-        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * (_seconds + 60 * (_minutes + 60 *
-                        (_hours + 24 * _days))));
+        bool format = false; // Encountered %?
+        bool era = false; // Encountered %E?
+        bool alt = false; // Encountered %O?
+        for (char c: fmt) {
+            if (!format && !alt) {
+                if (c == '%') format = true;
+                else AddLiteral(&c, 1);
+                continue;
+            }
+            if (c == 'E' || c == 'O') {
+                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
+                if (c == 'E') era = true;
+                else { alt = true; format = false; }
+                continue;
+            }
+            if ((era && !AllowsEra(c)) || (alt && !AllowsAlt(c))) {
+                throw MalformedDateTime("Bad format specifier");
+            }
+            // %E has no effect on any of the conversions which allow it.
+            Emit(c, alt, depth);
+            format = era = alt = false;
+        }
     }
 
-    // Note: the precision of _fracseconds depends on the Ratio template.
-    // By default, it is nanoseconds.
-    // However, if you change it to microseconds, or milliseconds, or something else, that
-    // will be its precision.
-    TimeDelta(long long _days, long long _hours, long long _minutes, long long _seconds, long long _fracseconds) {
-        this->d = std::chrono::duration<long long, Ratio>(_fracseconds + Ratio::den * (_seconds + 60 * (_minutes + 60 *
-                        (_hours + 24 * _days))));
-    }
+    void Emit(char c, bool alt, int depth) {
+#ifdef X_DATETIME_NO_LOCALES
+        alt = false;
+#endif
+        switch (c) {
+            case '%': AddLiteral("%", 1); break;
+            case 'n': AddLiteral("\n", 1); break;
+            case 't': AddLiteral("\t", 1); break;
+
+            case 'c': Compile(LocaleData::GetDateTimeFormat(locale), depth + 1); break;
+            case 'x': Compile(LocaleData::GetDateFormat(locale), depth + 1); break;
+            case 'X': Compile(LocaleData::GetTime24Format(locale), depth + 1); break;
+            case 'r': Compile(LocaleData::GetTime12Format(locale), depth + 1); break;
+            case 'R': Compile(LocaleData::GetTime24Format(locale), depth + 1); break;
+            case '+': Compile(LocaleData::GetDate1Format(locale), depth + 1); break;
+            case 'D': Compile("%m/%d/%y", depth + 1); break;
+            case 'F': Compile("%Y-%m-%d", depth + 1); break;
+            case 'T': Compile("%H:%M:%S", depth + 1); break;
+
+            case 'a':
+            case 'A':
+            if (!has_weekdays) {
+                const std::map<int, std::string>& s = LocaleData::GetShortWeekdays(locale);
+                const std::map<int, std::string>& l = LocaleData::GetLongWeekdays(locale);
+                for (int i = 0; i < 7; ++i) { short_weekdays[i] = Name(s, i); long_weekdays[i] = Name(l, i); }
+                has_weekdays = true;
+            }
+            AddConversion(c, false);
+            break;
+
+            case 'b':
+            case 'h':
+            case 'B':
+            if (!has_months) {
+                const std::map<int, std::string>& s = LocaleData::GetShortMonths(locale);
+                const std::map<int, std::string>& l = LocaleData::GetLongMonths(locale);
+                for (int i = 0; i < 12; ++i) { short_months[i] = Name(s, i); long_months[i] = Name(l, i); }
+                has_months = true;
+            }
+            AddConversion(c == 'h' ? 'b' : c, false);
+            break;
+
+            case 'p':
+            case 'P':
+            if (!has_ampm) {
+                am = LocaleData::GetAM(locale);
+                pm = LocaleData::GetPM(locale);
+                am_lower = Lower(am);
+                pm_lower = Lower(pm);
+                has_ampm = true;
+            }
+            AddConversion(c, false);
+            break;
+
+            case 'z':
+            case 'Z':
+            AddConversion(c, false);
+            break;
+
+            case '1': AddNumber(c, alt, 3, '0'); break;
+            case '2': AddNumber(c, alt, 6, '0'); break;
+            case '3': AddNumber(c, alt, 9, '0'); break;
+            case 'C': AddNumber(c, alt, 2, '0'); break;
+            case 'd': AddNumber(c, alt, 2, '0'); break;
+            case 'e': AddNumber(c, alt, 2, ' '); break;
+            case 'G': AddNumber(c, alt, alt ? 4 : 1, '0'); break;
+            case 'g': AddNumber(c, alt, 2, '0'); break;
+            case 'H': AddNumber(c, alt, 2, '0'); break;
+            case 'I': AddNumber(c, alt, 2, '0'); break;
+            case 'j': AddNumber(c, alt, 3, '0'); break;
+            case 'k': AddNumber(c, alt, 2, ' '); break;
+            case 'l': AddNumber(c, alt, 2, ' '); break;
+            case 'm': AddNumber(c, alt, 2, '0'); break;
+            case 'M': AddNumber(c, alt, 2, '0'); break;
+            case 's': AddNumber(c, alt, 1, '0'); break;
+            case 'S': AddNumber(c, alt, 2, '0'); break;
+            case 'u': AddNumber(c, alt, 1, '0'); break;
+            case 'U': AddNumber(c, alt, 2, '0'); break;
+            case 'V': AddNumber(c, alt, 2, '0'); break;
+            case 'w': AddNumber(c, alt, 1, '0'); break;
+            case 'W': AddNumber(c, alt, 2, '0'); break;
+            case 'y': AddNumber(c, alt, 2, '0'); break;
+            case 'Y': AddNumber(c, alt, 4, '0'); break;
 
-    TimeDelta Abs() const {
-        if (d.count() < 0)
-            return TimeDelta(-d);
-        else return *this;
+            default:
+            throw MalformedDateTime("Bad format specifier");
+        }
     }
+};
 
-    std::chrono::duration<long long, Ratio> SinceEpoch() const {
-        return TimeDelta<Ratio>(std::chrono::system_clock::now().time_since_epoch());
-    }
+// Outputs for DateTime::FormatWith() and TimeDelta::FormatWith().
 
-    TimeDelta &operator=(const TimeDelta &other) {
-        // Guard self assignment
-        if (this == &other)
-            return *this;
-        this->d = other.d;
-        return *this;
+// Appends to a std::string.
+struct FormatStringSink {
+    std::string& s;
+    void Append(const char* p, size_t n) { s.append(p, n); }
+};
+
+// Writes into a fixed buffer. Like snprintf, len keeps counting the full
+// output after the buffer is full, but nothing is written past cap.
+struct FormatBufferSink {
+    char* buf;
+    size_t cap;
+    size_t len;
+    void Append(const char* p, size_t n) {
+        if (len < cap) {
+            memcpy(buf + len, p, (n < cap - len) ? n : cap - len);
+        }
+        len += n;
     }
+};
 
-    template <typename Ratio_>
-    friend TimeDelta<Ratio_> operator+(const TimeDelta<Ratio_> &a,
-            const TimeDelta<Ratio_> &b);
+// Writes through an output iterator.
+template <typename OutputIt>
+struct FormatIteratorSink {
+    OutputIt it;
+    void Append(const char* p, size_t n) { it = std::copy(p, p + n, it); }
+};
 
-    template <typename Ratio_>
-    friend TimeDelta<Ratio_> operator-(const TimeDelta<Ratio_> &a,
-            const TimeDelta<Ratio_> &b);
-    TimeDelta<Ratio> &operator+=(const TimeDelta<Ratio> &rhs) {
-        d += rhs.d;
-        return *this;
-    }
-    TimeDelta<Ratio> &operator-=(const TimeDelta<Ratio> &rhs) {
-        d -= rhs.d;
-        return *this;
-    }
+// Prints v in decimal, with a leading '-' when negative.
+template <typename Sink>
+static inline void AppendInteger(Sink& out, long long v) {
+    char buf[20];
+    int n = 20;
+    unsigned long long u = (v < 0) ? 0ULL - static_cast<unsigned long long>(v) : static_cast<unsigned long long>(v);
+    do {
+        buf[--n] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (v < 0) buf[--n] = '-';
+    out.Append(buf + n, static_cast<size_t>(20 - n));
+}
 
-    bool operator==(const TimeDelta<Ratio> &rhs) const { return d == rhs.d; }
-    bool operator!=(const TimeDelta<Ratio> &rhs) const { return d != rhs.d; }
-    bool operator<(const TimeDelta<Ratio> &rhs) const { return d < rhs.d; }
-    bool operator>(const TimeDelta<Ratio> &rhs) const { return d > rhs.d; }
-    bool operator<=(const TimeDelta<Ratio> &rhs) const { return d <= rhs.d; }
-    bool operator>=(const TimeDelta<Ratio> &rhs) const { return d >= rhs.d; }
+// The pairs of decimal digits "00" to "99", for printing two digits at a time.
+static inline const char* DigitPairs() {
+    static const char pairs[201] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    return pairs;
+}
 
-    bool operator!() const { return d.count() == 0; }
-    operator bool() const { return d.count() != 0; }
+// Writes v (0-99) as two digits.
+static inline void PutDigitPair(char* p, unsigned v) {
+    memcpy(p, DigitPairs() + 2 * v, 2);
+}
 
-    int Days() const {
-        return static_cast<int>(d.count() / Ratio::den / 86400);
-    }
+// Upper bound on the number of bytes DateTime::FormatTo() writes for this plan,
+// not counting the terminating NUL. %Z is bounded by the longest zone name
+// registered at the time of the call.
+static inline size_t MaxFormattedSize(const FormatPlan& plan) {
+    return plan.MaxFormattedSize();
+}
 
-    int Hours() const {
-        return static_cast<int>(d.count() / Ratio::den / 3600 % 24);
-    }
+// Fields read from the input by ParsePlan::Scan(), before DateTime combines
+// them. Each has a have_ flag saying whether the format set it.
+struct ParsedFields {
+    long long ms, us, ns;
+    long long d, e, G, g, m, Y, y, C, doy;
+    long long H, I, k, l, M, S, epoch;
+    long long u, U, V, W;
+    long long zhh, zmm;     // both carry the sign of the offset
+    const char* zname;      // %Z, pointing into the input
+    size_t zname_length;
+    unsigned zone;          // handle + 1 of the built-in zone %Z matched, or 0
+
+    bool have_ms, have_us, have_ns;
+    bool have_d, have_e, have_G, have_g, have_m, have_Y, have_y, have_C, have_doy;
+    bool have_H, have_I, have_k, have_l, have_M, have_S, have_epoch;
+    bool have_u, have_U, have_V, have_W;
+    bool have_am, have_pm, have_z, have_Z;
+};
 
-    int Minutes() const {
-        return static_cast<int>(d.count() / Ratio::den / 60 % 60);
-    }
+struct ParseOp {
+    char spec;                  // conversion, or 0 for literal text
+    bool alt;                   // read the locale's alternate digits
+    bool skip_space;            // %e, %k, %l: leading blanks count towards the width
+    unsigned char width;        // most digits to read, or 0 for no limit
+    unsigned int offset;        // literal text in ParsePlan::text
+    unsigned int length;
+    long long ParsedFields::* value;
+    bool ParsedFields::* have;
+};
 
-    int Seconds() const {
-        return static_cast<int>(d.count() / Ratio::den % 60);
+// A strptime-style format compiled for a locale, for parsing many inputs with
+// DateTime::TryFromString() and friends. Compiling expands composite
+// conversions (%c, %D, %T, ...), resolves the E and O modifiers and caches the
+// locale's names, so that parsing only has to scan the input.
+//
+// Unlike FormatPlan, a bad format does not throw here: Error() returns
+// ParseError::BadFormat, and so does every parse through the plan.
+class ParsePlan {
+public:
+    explicit ParsePlan(const std::string& fmt, const std::string& locale = "C")
+        : locale(locale), error(ParseError::None), has_locale(LocaleData::HasLocale(locale)), date_prefix(0),
+          short_weekdays(NULL), long_weekdays(NULL), short_months(NULL), long_months(NULL), alt_digits(NULL) {
+        Compile(fmt, 0);
+        FindDatePrefix();
     }
 
-    int Milliseconds() const {
-        if (Ratio::den < 1000) {
-            return 0;
-        }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000);
+    const std::string& Locale() const { return locale; }
+
+    ParseError Error() const { return error; }
+
+    // Matches the plan against the start of [p, last), storing what it reads
+    // in fields. p is left after the last character matched.
+    ParseError Scan(const char*& p, const char* last, ParsedFields& fields) const {
+        return Scan(p, last, fields, 0, ops.size());
     }
 
-    int Microseconds() const {
-        if (Ratio::den <= 1000) {
-            return 0;
-        }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000);
+    // The same for the ops in [begin, end) only.
+    ParseError Scan(const char*& p, const char* last, ParsedFields& fields, size_t begin, size_t end) const {
+        if (error != ParseError::None) return error;
+        for (size_t i = begin; i < end; ++i) {
+            const ParseOp& op = ops[i];
+            switch (op.spec) {
+                case 0:
+                if (static_cast<size_t>(last - p) < op.length ||
+                        memcmp(p, text.data() + op.offset, op.length) != 0) {
+                    return ParseError::Mismatch;
+                }
+                p += op.length;
+                break;
+
+                case 'a':
+                case 'A': {
+                    int j = MatchName(op.spec == 'a' ? short_weekdays : long_weekdays, p, last);
+                    if (j < 0) return ParseError::Mismatch;
+                    fields.u = j + 1; // 1 = Sunday, like %u
+                    fields.have_u = true;
+                    break;
+                }
+
+                case 'b':
+                case 'B': {
+                    int j = MatchName(op.spec == 'b' ? short_months : long_months, p, last);
+                    if (j < 0) return ParseError::Mismatch;
+                    fields.m = j + 1;
+                    fields.have_m = true;
+                    break;
+                }
+
+                case 'p':
+                case 'P': {
+                    int j = (op.spec == 'p' ? am_pm : am_pm_lower).Match(p, last);
+                    if (j < 0) {
+                        // Locales without AM/PM strings accept nothing here.
+                        if (!am_pm.Empty()) return ParseError::Mismatch;
+                        j = 0;
+                    }
+                    fields.have_am = (j == 0);
+                    fields.have_pm = (j == 1);
+                    break;
+                }
+
+                case 'z': {
+                    if (p == last || (*p != '+' && *p != '-')) return ParseError::Mismatch;
+                    int sign = (*p++ == '-') ? -1 : 1;
+                    ParseOp part = {'z', false, false, 2, 0, 0, NULL, NULL};
+                    if (ReadNumber(part, p, last, fields.zhh) != ParseError::None ||
+                            ReadNumber(part, p, last, fields.zmm) != ParseError::None) {
+                        return ParseError::BadValue;
+                    }
+                    fields.zhh *= sign;
+                    fields.zmm *= sign;
+                    fields.have_z = true;
+                    break;
+                }
+
+                case 'Z': {
+                    // The longest built-in name which doesn't stop in the middle of a
+                    // word or number, and otherwise a run of capitals for a zone
+                    // registered later.
+                    fields.zname = p;
+                    int id = TimezoneRegistry::BuiltinNames().Match(p, last,
+                        [last](const char* end) {
+                            return end == last || !SameKind(end[-1], *end);
+                        });
+                    if (id >= 0) {
+                        fields.zone = static_cast<unsigned>(id) + 1;
+                    }
+                    else {
+                        while (p != last && *p >= 'A' && *p <= 'Z') ++p;
+                    }
+                    fields.zname_length = p - fields.zname;
+                    fields.have_Z = true;
+                    break;
+                }
+
+                default: {
+                    ParseError err = ReadNumber(op, p, last, fields.*op.value);
+                    if (err != ParseError::None) return err;
+                    if (op.spec == 'C') fields.C *= 100;
+                    fields.*op.have = true;
+                }
+            }
+        }
+        return ParseError::None;
     }
 
-    int Nanoseconds() const {
-        if (Ratio::den <= 1000000) {
-            return 0;
+    // Number of leading ops which read the date, or 0 if the plan can't be split
+    // there. Only the time of day and the zone are read after them, so a DateTime
+    // parsed with a ParseContext can reuse the day when the input starts with the
+    // same characters as last time.
+    size_t DatePrefix() const { return date_prefix; }
+
+    size_t Size() const { return ops.size(); }
+
+private:
+    std::string locale;
+    ParseError error;
+    bool has_locale;
+    std::vector<ParseOp> ops;
+    std::string text;
+    size_t date_prefix;
+
+    // The locale's names, shared with other plans (see LocaleData::GetNameIndex()).
+    // They stay NULL until a conversion needs them, and for unknown locales.
+    const NameIndex* short_weekdays;
+    const NameIndex* long_weekdays;
+    const NameIndex* short_months;
+    const NameIndex* long_months;
+    const NameIndex* alt_digits;
+    NameIndex am_pm;
+    NameIndex am_pm_lower;
+
+    // Whether a and b are both digits or both letters.
+    static bool SameKind(char a, char b) {
+        const bool digits = isdigit(static_cast<unsigned char>(a)) && isdigit(static_cast<unsigned char>(b));
+        const bool letters = isalpha(static_cast<unsigned char>(a)) && isalpha(static_cast<unsigned char>(b));
+        return digits || letters;
+    }
+
+    // Index of the longest name which starts [p, last), or -1. p is moved past the name.
+    static int MatchName(const NameIndex* names, const char*& p, const char* last) {
+        return names ? names->Match(p, last) : -1;
+    }
+
+    ParseError ReadNumber(const ParseOp& op, const char*& p, const char* last, long long& out) const {
+        int width = op.width;
+        if (op.skip_space) {
+            while (p != last && isspace(static_cast<unsigned char>(*p))) {
+                ++p;
+                --width;
+            }
+            if (width <= 0) return ParseError::BadValue;
         }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000);
+        // Only %s is allowed past the range of int.
+        const long long limit = (op.spec == 's') ? LLONG_MAX : INT_MAX;
+        long long v = 0;
+        int n = 0;
+        while (p != last && (op.width == 0 || n < width)) {
+            int digit;
+            size_t len = 1;
+            if (!op.alt) {
+                if (*p < '0' || *p > '9') break;
+                digit = *p - '0';
+            }
+            else {
+                const char* q = p;
+                if ((digit = MatchName(alt_digits, q, last)) < 0) break;
+                len = static_cast<size_t>(q - p);
+            }
+            if (v > (limit - digit) / 10) return ParseError::BadValue;
+            v = v * 10 + digit;
+            p += len;
+            ++n;
+        }
+        if (n == 0) return ParseError::BadValue;
+        out = v;
+        return ParseError::None;
     }
 
-    long long DaysW() const {
-        return d.count() / Ratio::den / 86400;
+    static std::string Lower(std::string data) {
+        std::transform(data.begin(), data.end(), data.begin(),
+            [](unsigned char c){ return std::tolower(c); });
+        return data;
     }
 
-    long long HoursW() const {
-        return d.count() / Ratio::den / 3600 % 24;
+    // An unknown locale has no formats or names, so they match nothing rather
+    // than failing the compile.
+    std::string LocaleFormat(std::string (*get)(std::string)) const {
+        return has_locale ? get(locale) : std::string();
     }
 
-    long long MinutesW() const {
-        return d.count() / Ratio::den / 60 % 60;
+    void AddLiteral(const char* p, size_t n) {
+        if (!ops.empty() && ops.back().spec == 0) {
+            ops.back().length += static_cast<unsigned int>(n);
+        }
+        else {
+            ParseOp op = {0, false, false, 0, static_cast<unsigned int>(text.size()),
+                static_cast<unsigned int>(n), NULL, NULL};
+            ops.push_back(op);
+        }
+        text.append(p, n);
     }
 
-    long long SecondsW() const {
-        return d.count() / Ratio::den % 60;
+    void AddConversion(char spec) {
+        ParseOp op = {spec, false, false, 0, 0, 0, NULL, NULL};
+        ops.push_back(op);
     }
 
-    long long MillisecondsW() const {
-        if (Ratio::den < 1000) {
-            return 0;
+    // The date is everything before the first op which reads the time of day or the
+    // zone, if nothing after that reads the date again. %s and alternate digits
+    // (which can be several bytes long) are never split.
+    void FindDatePrefix() {
+        size_t i = 0;
+        bool date = false;
+        for (; i < ops.size() && !ReadsTime(ops[i].spec); ++i) {
+            if (ops[i].spec == 0) continue;
+            if (ops[i].alt || ops[i].spec == 's') return;
+            date = true;
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000;
+        if (!date || i == ops.size()) return;
+        for (size_t j = i; j < ops.size(); ++j) {
+            if (ops[j].spec != 0 && !ReadsTime(ops[j].spec)) return;
+        }
+        date_prefix = i;
     }
 
-    long long MicrosecondsW() const {
-        if (Ratio::den <= 1000) {
-            return 0;
+    static bool ReadsTime(char spec) {
+        return spec != 0 && strchr("HIklMS123pPzZ", spec) != NULL;
+    }
+
+    void AddNumber(bool alt, unsigned char width, long long ParsedFields::* value,
+            bool ParsedFields::* have, char spec, bool skip_space = false) {
+        if (alt && alt_digits == NULL && has_locale) {
+            alt_digits = &LocaleData::GetNameIndex(LocaleData::GetAltDigits(locale));
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000;
+        ParseOp op = {spec, alt, skip_space, width, 0, 0, value, have};
+        ops.push_back(op);
     }
 
-    long long NanosecondsW() const {
-        if (Ratio::den <= 1000000) {
-            return 0;
+    void Compile(const std::string& fmt, int depth) {
+        // Locale formats only refer to simple conversions, but don't let a bad table recurse forever.
+        if (depth > 4) { error = ParseError::BadFormat; return; }
+
+        for (size_t i = 0; i < fmt.size() && error == ParseError::None; ++i) {
+            char c = fmt[i];
+            if (c != '%') {
+                AddLiteral(&c, 1);
+                continue;
+            }
+            if (++i == fmt.size()) { error = ParseError::BadFormat; return; }
+            c = fmt[i];
+            // The padding flags (as in the locales' "%-d") don't change what is accepted.
+            while (c != 0 && strchr("-_0^#", c)) {
+                if (++i == fmt.size()) { error = ParseError::BadFormat; return; }
+                c = fmt[i];
+            }
+            bool era = false;
+            bool alt = false;
+            if (c == 'E' || c == 'O') {
+                era = (c == 'E');
+                alt = (c == 'O');
+                if (++i == fmt.size()) { error = ParseError::BadFormat; return; }
+                c = fmt[i];
+                if (c == 0 || (era && !strchr("cCxXyY", c)) || (alt && !strchr("123deGgHIjklmMsSuUVwW", c))) {
+                    error = ParseError::BadFormat;
+                    return;
+                }
+            }
+            // %EC, %Ey and %EY read alternate digits, %Ec, %Ex and %EX are the same as without E.
+            Emit(c, alt || (era && strchr("CyY", c)), depth);
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000;
     }
 
-    template <typename Calendar_, typename Clock_, typename Period_>
-    friend DateTime<Calendar_, Clock_, Period_> operator+(const DateTime<Calendar_, Clock_, Period_> &a, const TimeDelta<Period_> &b);
+    void Emit(char c, bool alt, int depth) {
+#ifdef X_DATETIME_NO_LOCALES
+        alt = false;
+#endif
+        switch (c) {
+            case '%': AddLiteral("%", 1); break;
+            case 'n': AddLiteral("\n", 1); break;
+            case 't': AddLiteral("\t", 1); break;
+
+            case 'c': Compile(LocaleFormat(LocaleData::GetDateTimeFormat), depth + 1); break;
+            case 'x': Compile(LocaleFormat(LocaleData::GetDateFormat), depth + 1); break;
+            case 'X': Compile(LocaleFormat(LocaleData::GetTime24Format), depth + 1); break;
+            case 'r': Compile(LocaleFormat(LocaleData::GetTime12Format), depth + 1); break;
+            case 'R': Compile(LocaleFormat(LocaleData::GetTime24Format), depth + 1); break;
+            case '+': Compile(LocaleFormat(LocaleData::GetDate1Format), depth + 1); break;
+            case 'D': Compile("%m/%d/%y", depth + 1); break;
+            case 'F': Compile("%Y-%m-%d", depth + 1); break;
+            case 'T': Compile("%H:%M:%S", depth + 1); break;
+
+            case 'a':
+            case 'A':
+            if (short_weekdays == NULL && has_locale) {
+                short_weekdays = &LocaleData::GetNameIndex(LocaleData::GetShortWeekdays(locale));
+                long_weekdays = &LocaleData::GetNameIndex(LocaleData::GetLongWeekdays(locale));
+            }
+            AddConversion(c);
+            break;
+
+            case 'b':
+            case 'h':
+            case 'B':
+            if (short_months == NULL && has_locale) {
+                short_months = &LocaleData::GetNameIndex(LocaleData::GetShortMonths(locale));
+                long_months = &LocaleData::GetNameIndex(LocaleData::GetLongMonths(locale));
+            }
+            AddConversion(c == 'h' ? 'b' : c);
+            break;
+
+            case 'p':
+            case 'P':
+            if (am_pm.Empty() && has_locale) {
+                std::map<int, std::string> names, lower;
+                names[0] = LocaleData::GetAM(locale);
+                names[1] = LocaleData::GetPM(locale);
+                lower[0] = Lower(names[0]);
+                lower[1] = Lower(names[1]);
+                am_pm = NameIndex(names);
+                am_pm_lower = NameIndex(lower);
+            }
+            AddConversion(c);
+            break;
+
+            case 'z':
+            case 'Z':
+            AddConversion(c);
+            break;
+
+            case '1': AddNumber(alt, 3, &ParsedFields::ms, &ParsedFields::have_ms, c); break;
+            case '2': AddNumber(alt, 6, &ParsedFields::us, &ParsedFields::have_us, c); break;
+            case '3': AddNumber(alt, 9, &ParsedFields::ns, &ParsedFields::have_ns, c); break;
+            case 'C': AddNumber(alt, 0, &ParsedFields::C, &ParsedFields::have_C, c); break;
+            case 'd': AddNumber(alt, 2, &ParsedFields::d, &ParsedFields::have_d, c); break;
+            case 'e': AddNumber(alt, 2, &ParsedFields::e, &ParsedFields::have_e, c, true); break;
+            case 'G': AddNumber(alt, 0, &ParsedFields::G, &ParsedFields::have_G, c); break;
+            case 'g': AddNumber(alt, 2, &ParsedFields::g, &ParsedFields::have_g, c); break;
+            case 'H': AddNumber(alt, 2, &ParsedFields::H, &ParsedFields::have_H, c); break;
+            case 'I': AddNumber(alt, 2, &ParsedFields::I, &ParsedFields::have_I, c); break;
+            case 'j': AddNumber(alt, 3, &ParsedFields::doy, &ParsedFields::have_doy, c); break;
+            case 'k': AddNumber(alt, 2, &ParsedFields::k, &ParsedFields::have_k, c, true); break;
+            case 'l': AddNumber(alt, 2, &ParsedFields::l, &ParsedFields::have_l, c, true); break;
+            case 'm': AddNumber(alt, 2, &ParsedFields::m, &ParsedFields::have_m, c); break;
+            case 'M': AddNumber(alt, 2, &ParsedFields::M, &ParsedFields::have_M, c); break;
+            case 's': AddNumber(alt, 0, &ParsedFields::epoch, &ParsedFields::have_epoch, c); break;
+            case 'S': AddNumber(alt, 2, &ParsedFields::S, &ParsedFields::have_S, c); break;
+            case 'u':
+            case 'w': AddNumber(alt, 2, &ParsedFields::u, &ParsedFields::have_u, c); break;
+            case 'U': AddNumber(alt, 2, &ParsedFields::U, &ParsedFields::have_U, c); break;
+            case 'V': AddNumber(alt, 2, &ParsedFields::V, &ParsedFields::have_V, c); break;
+            case 'W': AddNumber(alt, 2, &ParsedFields::W, &ParsedFields::have_W, c); break;
+            case 'y': AddNumber(alt, 2, &ParsedFields::y, &ParsedFields::have_y, c); break;
+            case 'Y': AddNumber(alt, 0, &ParsedFields::Y, &ParsedFields::have_Y, c); break;
 
-    template <typename Calendar_, typename Clock_, typename Period_>
-    friend DateTime<Calendar_, Clock_, Period_> operator+(const TimeDelta<Period_> &a, const DateTime<Calendar_, Clock_, Period_> &b);
+            default:
+            error = ParseError::BadFormat;
+        }
+    }
+};
 
-    template <typename Calendar_, typename Clock_, typename Period_>
-    friend DateTime<Calendar_, Clock_, Period_> operator-(const DateTime<Calendar_, Clock_, Period_> &a, const TimeDelta<Period_> &b);
+// Chooses which formats DateTime(const std::string&) tries for an input, from
+// a single scan over it, instead of running the parser over every candidate
+// in turn.
+//
+// The ISO 8601 candidates are recognised by IsoFormat(), a small state machine
+// over the digit/separator shape of the input which names the one candidate
+// that can match. The locale's own formats are kept, but each is first checked
+// against what its leading conversion needs (a name, a run of digits followed
+// by a separator, or a literal), so that those which are sure to fail are
+// skipped. The result is the same as trying every candidate in order.
+class FormatDetector {
+public:
+    explicit FormatDetector(const std::string& locale_) : locale(locale_) {
+        if (!LocaleData::HasLocale(locale)) {
+            // No formats of its own; only the ISO ones can match.
+            return;
+        }
+        const std::string formats[] = {
+            LocaleData::GetDateTimeFormat(locale),
+            LocaleData::GetDate1Format(locale),
+            LocaleData::GetDateFormat(locale),
+            LocaleData::GetTime24Format(locale),
+            LocaleData::GetTime12Format(locale),
+        };
+        for (const std::string& fmt: formats) {
+            LocaleFormat f = {ParsePlan(fmt, locale), LeadOf(fmt)};
+            locale_formats.push_back(f);
+        }
+    }
 
-    template <typename Calendar_, typename Clock_, typename Period_>
-    friend TimeDelta<Period_> operator-(const DateTime<Calendar_, Clock_, Period_> &a, const DateTime<Calendar_, Clock_, Period_> &b);
+    // Detectors are built once per locale and shared.
+    static const FormatDetector& ForLocale(const std::string& locale) {
+        static std::mutex m;
+        static std::map<std::string, FormatDetector> detectors;
+        std::lock_guard<std::mutex> guard(m);
+        auto it = detectors.find(locale);
+        if (it == detectors.end()) {
+            it = detectors.insert(std::make_pair(locale, FormatDetector(locale))).first;
+        }
+        return it->second;
+    }
+
+    const std::string& Locale() const { return locale; }
+
+    // Calls try_plan(plan) for each candidate that could match [first, last), in
+    // priority order, until one returns true. Returns whether any did.
+    template <typename F>
+    bool Detect(const char* first, const char* last, F try_plan) const {
+        for (const LocaleFormat& f: locale_formats) {
+            if (f.lead.Accepts(first, last) && try_plan(f.plan)) {
+                return true;
+            }
+        }
+        int iso = IsoFormat(first, last);
+        return iso >= 0 && try_plan(IsoPlans()[iso]);
+    }
+
+    // The ISO 8601 and other common formats tried after the locale's own.
+    static const std::string* IsoFormats() {
+        static const std::string formats[IsoFormatCount] = {
+            "%Y-%m-%dT%H:%M:%S.%3Z%z",
+            "%Y-%m-%dT%H:%M:%S.%3Z",
+            "%Y-%m-%d %H:%M:%S.%3",
+            "%Y-%m-%dT%H:%M:%S.%2Z%z",
+            "%Y-%m-%dT%H:%M:%S.%2Z",
+            "%Y-%m-%d %H:%M:%S.%2",
+            "%Y-%m-%dT%H:%M:%S.%1Z%z",
+            "%Y-%m-%dT%H:%M:%S.%1Z",
+            "%Y-%m-%d %H:%M:%S.%1",
+            "%Y-%m-%dT%H:%M:%SZ%z",
+            "%Y-%m-%dT%H:%M:%SZ",
+            "%Y-%m-%d %H:%M:%S",
+            "%Y-%m-%d %H:%M",
+            "%Y-%m-%d",
+        };
+        return formats;
+    }
+
+    static const int IsoFormatCount = 14;
+
+    // IsoFormats() compiled. They don't depend on the locale.
+    static const std::vector<ParsePlan>& IsoPlans() {
+        static const std::vector<ParsePlan> plans(IsoFormats(), IsoFormats() + IsoFormatCount);
+        return plans;
+    }
+
+    // Index into IsoFormats() of the first format that accepts [first, last),
+    // or -1 if none does. The field widths follow the parser: %Y takes any number
+    // of digits, the fraction up to 9 (so the %2 and %1 variants are never the
+    // first to match), and the other fields and both halves of %z up to 2.
+    static int IsoFormat(const char* first, const char* last) {
+        const char* p = first;
+        // Date: %Y-%m-%d
+        if (!Field(p, last, 0, '-') || !Field(p, last, 2, '-') || !Field(p, last, 2, 0)) return -1;
+        if (p == last) return 13;
+        char sep = *p++;
+        if (sep != 'T' && sep != ' ') return -1;
+
+        // Time: %H:%M[:%S[.fraction]]
+        if (!Field(p, last, 2, ':') || !Field(p, last, 2, 0)) return -1;
+        if (p == last) return (sep == ' ') ? 12 : -1;
+        if (*p++ != ':' || !Field(p, last, 2, 0)) return -1;
+        bool fraction = false;
+        if (p != last && *p == '.') {
+            ++p;
+            if (!Field(p, last, 9, 0)) return -1;
+            fraction = true;
+        }
+        if (sep == ' ') {
+            return (p != last) ? -1 : fraction ? 2 : 11;
+        }
+
+        // Zone: Z[%z]
+        if (p == last || *p++ != 'Z') return -1;
+        if (p == last) return fraction ? 1 : 10;
+        if (*p != '+' && *p != '-') return -1;
+        ++p;
+        if (!Field(p, last, 2, 0) || !Field(p, last, 2, 0) || p != last) return -1;
+        return fraction ? 0 : 9;
+    }
 
 private:
+    // What the first element of a format needs to see at the start of the input.
+    struct Lead {
+        enum Kind { Anything, Nothing, Name, Digits, Literal };
+        Kind kind;
+        int width;      // Digits: most digits the conversion reads, 0 for no limit
+        char next;      // Digits: separator that must follow them, 0 if not known
+                        // Literal: the character itself
+
+        bool Accepts(const char* first, const char* last) const {
+            switch (kind) {
+                case Anything: return true;
+                case Nothing: return first == last;
+                case Name: return first != last && !IsDigit(*first);
+                case Literal: return first != last && *first == next;
+                case Digits: {
+                    const char* p = SkipDigits(first, last, width);
+                    if (p == first) return false;
+                    return next == 0 || (p != last && *p == next);
+                }
+            }
+            return true;
+        }
+    };
 
-    struct TimeEncapsulation {
-        long long ns, us, ms, s, min, h, d;
+    struct LocaleFormat {
+        ParsePlan plan;
+        Lead lead;
     };
 
-    TimeEncapsulation Encapsulate() const {
-        TimeEncapsulation e;
-        e.ns = 0;
-        e.us = 0;
-        e.ms = 0;
-        long long count = d.count();
-        if (Ratio::den > 1000000) {
-            e.ns = static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000;
+    std::string locale;
+    std::vector<LocaleFormat> locale_formats;
+
+    static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // Advances over at most max digits (any number if max is 0).
+    static const char* SkipDigits(const char* p, const char* last, int max) {
+        for (int n = 0; p != last && IsDigit(*p) && (max == 0 || n < max); ++n) ++p;
+        return p;
+    }
+
+    static Lead LeadOf(const std::string& fmt) {
+        Lead lead = {Lead::Anything, 0, 0};
+        if (fmt.empty()) {
+            lead.kind = Lead::Nothing;
         }
-        else if (Ratio::den > 1000) {
-            e.us = static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000;
+        else if (fmt[0] != '%') {
+            lead.kind = Lead::Literal;
+            lead.next = fmt[0];
         }
-        else if (Ratio::den > 1) {
-            e.ms = static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000;
+        else if (fmt.size() > 1) {
+            char c = fmt[1];
+            if (strchr("aAbBh", c)) {
+                lead.kind = Lead::Name;
+            }
+            else if (strchr("dgHIjmMSuUVwWy", c)) {
+                lead.kind = Lead::Digits;
+                lead.width = (c == 'j') ? 3 : 2;
+            }
+            else if (strchr("CGsY", c)) {
+                lead.kind = Lead::Digits;
+            }
+            // The separator can be checked when it is a plain character.
+            if (lead.kind == Lead::Digits && fmt.size() > 2 && fmt[2] != '%' && !IsDigit(fmt[2])) {
+                lead.next = fmt[2];
+            }
         }
-        count /= Ratio::den;
-        e.s = count % 60;
-        count /= 60;
-        e.min = count % 60;
-        count /= 60;
-        e.h = count % 24;
-        count /= 24;
-        e.d = count;
-        return e;
+        return lead;
     }
 
-public:
-
-    std::string ToString() const {
-        TimeEncapsulation e = Encapsulate();
-        std::string str;
-        str += std::to_string(e.d) + "d ";
-        str += std::to_string(e.h) + "h ";
-        str += std::to_string(e.min) + "min ";
-        str += std::to_string(e.s) + "s";
+    // Reads a 1 or 2 digit field and then sep (if sep isn't 0).
+    static bool Field(const char*& p, const char* last, int width, char sep) {
+        const char* q = SkipDigits(p, last, width);
+        if (q == p) return false;
+        p = q;
+        if (sep == 0) return true;
+        if (p == last || *p != sep) return false;
+        ++p;
+        return true;
+    }
+};
 
-        // Depending on the range we use, print fractional
-        // seconds in the highest supported resolution.
-        // This won't print anything for any precision coarser
-        // than milliseconds.
-        if (Ratio::den > 1000000) {
-            str += " " + std::to_string(e.ns) + "ns";
-        }
-        else if (Ratio::den > 1000) {
-            str += " " + std::to_string(e.us) + X_DATETIME_UTF8_STR("μs");
+// Remembers the date at the start of the last timestamp parsed through it, and the
+// day it stands for. In log streams the same date is repeated for hours at a time,
+// so when the next input starts with the same characters, only the time of day
+// after them has to be read. Pass one to TryFromChars(), TryFromString() or
+// TryFromISO8601() along with the plan. A context belongs to one thread.
+class ParseContext {
+public:
+    ParseContext() : owner(NULL), length(0), stop(false), days(0), hits(0), misses(0) {}
+
+    // Whether [first, last) starts with the date remembered for owner (the plan);
+    // if so, days is set and length() characters can be skipped.
+    bool Match(const void* owner_, const char* first, const char* last, long long& days_) {
+        const size_t n = length;
+        if (owner_ != owner || static_cast<size_t>(last - first) < n || n == 0 || !Same(first, n)) {
+            ++misses;
+            return false;
         }
-        else if (Ratio::den > 1) {
-            str += " " + std::to_string(e.ms) + "ms";
+        // A number or a name at the end of the date stopped before a different kind of
+        // character last time, so it has to stop in the same place now.
+        if (stop && first + n != last && Kind(first[n]) == Kind(first[n - 1])) {
+            ++misses;
+            return false;
         }
+        ++hits;
+        days_ = days;
+        return true;
+    }
 
-        return str;
+    // Remembers [first, end) as the date of owner, which stands for days. last is
+    // the end of the input.
+    void Remember(const void* owner_, const char* first, const char* end, const char* last, long long days_) {
+        const size_t n = static_cast<size_t>(end - first);
+        if (n > sizeof(prefix)) {
+            length = 0;
+            return;
+        }
+        memcpy(prefix, first, n);
+        owner = owner_;
+        length = n;
+        stop = n > 0 && Kind(end[-1]) != 0 && (end == last || Kind(*end) != Kind(end[-1]));
+        days = days_;
     }
 
+    size_t Length() const { return length; }
+    size_t Hits() const { return hits; }
+    size_t Misses() const { return misses; }
 
-    int TotalDays() const {
-        return static_cast<int>(d.count() / Ratio::den / 86400);
+    // Forgets the date. Call this before reusing the context with another plan
+    // allocated where a destroyed one used to be.
+    void Clear() {
+        owner = NULL;
+        length = 0;
     }
 
-    int TotalHours() const {
-        return static_cast<int>(d.count() / Ratio::den / 3600);
+private:
+    const void* owner;
+    size_t length;
+    bool stop;
+    long long days;
+    size_t hits;
+    size_t misses;
+    char prefix[64];
+
+    // 1 for digits, 2 for letters (or bytes of a UTF-8 name) and 0 for anything else.
+    static int Kind(char c) {
+        if (c >= '0' && c <= '9') return 1;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c & 0x80)) return 2;
+        return 0;
+    }
+
+    // Dates of 8 to 16 characters, such as YYYY-MM-DD, are compared as two overlapping words.
+    bool Same(const char* p, size_t n) const {
+        if (n < 8 || n > 16) return memcmp(p, prefix, n) == 0;
+        uint64_t a, b, c, d;
+        memcpy(&a, p, 8);
+        memcpy(&b, p + n - 8, 8);
+        memcpy(&c, prefix, 8);
+        memcpy(&d, prefix + n - 8, 8);
+        return ((a ^ c) | (b ^ d)) == 0;
     }
+};
 
-    int TotalMinutes() const {
-        return static_cast<int>(d.count() / Ratio::den / 60);
+// Fields of an RFC 3339 / ISO 8601 timestamp, as read by ISO8601Parser::Scan().
+struct ISO8601Fields {
+    int year;       // 0000-9999
+    int month;      // 1-12
+    int day;        // 1-31, checked against the month
+    int hour;       // 0-23
+    int minute;     // 0-59
+    int second;     // 0-60; a leap second carries over into the next minute
+    int nanosecond; // the fraction, truncated to nanoseconds
+    int offset;     // UTC offset in seconds, 0 for Z or when there is no offset
+};
+
+// Parser for the fixed layout YYYY-MM-DDTHH:MM:SS[.fffffffff][Z|+hh:mm|-hh:mm], which is
+// what DateTime::FormatISO8601() writes. The date and time may also be separated by a
+// 't' or a space, as RFC 3339 allows, and the fraction may have any number of digits.
+//
+// Since every field is at a known position, there is no need to go through a ParsePlan
+// one conversion at a time. The 19 characters of the date and time are checked and
+// converted together: with SSE2, as two overlapping 16-byte vectors, and otherwise with
+// SWAR arithmetic on three 64-bit words. The fraction is read 8 digits at a time.
+class ISO8601Parser {
+public:
+    // Length of YYYY-MM-DDTHH:MM:SS.
+    static const int DateTimeLength = 19;
+
+    // Length of YYYY-MM-DD, which ParseContext remembers.
+    static const int DateLength = 10;
+
+    // Reads the timestamp at the start of [p, last) and leaves p after it. On failure p
+    // is left at the start if the date and time are bad, and where matching stopped otherwise.
+    static ParseError Scan(const char*& p, const char* last, ISO8601Fields& f) {
+        if (last - p < DateTimeLength) return ParseError::Mismatch;
+        if (p[10] != 'T' && p[10] != 't' && p[10] != ' ') return ParseError::Mismatch;
+#ifdef X_DATETIME_SSE2
+        ParseError err = ScanDateTimeSSE2(p, f);
+#else
+        ParseError err = ScanDateTimeSWAR(p, f);
+#endif
+        if (err != ParseError::None) return err;
+        p += DateTimeLength;
+        return ScanRest(p, last, f);
+    }
+
+    // The same, but the date at p is already known, so only the time of day and what
+    // follows it are read. The year, month and day of f are not set.
+    static ParseError ScanTime(const char*& p, const char* last, ISO8601Fields& f) {
+        if (last - p < DateTimeLength) return ParseError::Mismatch;
+        if (p[10] != 'T' && p[10] != 't' && p[10] != ' ') return ParseError::Mismatch;
+        const uint64_t c = Load64(p + 11);
+        const uint64_t c_digits = 0xFFFF00FFFF00FFFFULL;
+        if ((c & ~c_digits) != 0x00003A00003A0000ULL) return ParseError::Mismatch;
+        if (!AllDigits(c, c_digits)) return ParseError::BadValue;
+        const uint64_t tc = Pairs(c, c_digits);
+        f.hour = static_cast<int>(tc & 0xFF);
+        f.minute = static_cast<int>(tc >> 24 & 0xFF);
+        f.second = static_cast<int>(tc >> 48 & 0xFF);
+        if (f.hour > 23 || f.minute > 59 || f.second > 60) return ParseError::BadValue;
+        p += DateTimeLength;
+        return ScanRest(p, last, f);
+    }
+
+    // A key for the ISO 8601 dates in a ParseContext, which can't come from any plan.
+    static const void* ContextKey() {
+        static const char key = 0;
+        return &key;
+    }
+
+    // The fraction and the offset after the seconds.
+    static ParseError ScanRest(const char*& p, const char* last, ISO8601Fields& f) {
+        f.nanosecond = 0;
+        if (p != last && *p == '.') {
+            ++p;
+            if (!ReadFraction(p, last, f.nanosecond)) return ParseError::BadValue;
+        }
+
+        f.offset = 0;
+        if (p != last && (*p == 'Z' || *p == 'z')) {
+            ++p;
+        }
+        else if (p != last && (*p == '+' || *p == '-')) {
+            if (last - p > 3 && p[3] != ':') return ParseError::Mismatch;
+            if (last - p < 6) return ParseError::BadValue;
+            int hh, mm;
+            if (!ReadPair(p + 1, hh) || !ReadPair(p + 4, mm) || hh > 23 || mm > 59) {
+                return ParseError::BadValue;
+            }
+            f.offset = (hh * 3600 + mm * 60) * (*p == '-' ? -1 : 1);
+            p += 6;
+        }
+        return ParseError::None;
+    }
+
+    // Checks and converts YYYY-MM-DD?HH:MM:SS at p, which must have at least
+    // DateTimeLength readable characters; the separator at p[10] is not looked at.
+    static ParseError ScanDateTimeSWAR(const char* p, ISO8601Fields& f) {
+        // "YYYY-MM-", "DDTHH:MM" and "HH:MM:SS", with the first character in the low byte.
+        const uint64_t a = Load64(p);
+        const uint64_t b = Load64(p + 8);
+        const uint64_t c = Load64(p + 11);
+        const uint64_t a_digits = 0x00FFFF00FFFFFFFFULL;
+        const uint64_t bc_digits = 0xFFFF00FFFF00FFFFULL;
+        const uint64_t b_seps = 0x0000FF0000000000ULL;
+        if ((a & ~a_digits) != 0x2D00002D00000000ULL ||
+                (b & b_seps) != 0x00003A0000000000ULL ||
+                (c & ~bc_digits) != 0x00003A00003A0000ULL) {
+            return ParseError::Mismatch;
+        }
+        if (!AllDigits(a, a_digits) || !AllDigits(b, bc_digits) || !AllDigits(c, bc_digits)) {
+            return ParseError::BadValue;
+        }
+        // Byte k of each word becomes 10 * digit k + digit k+1.
+        const uint64_t ta = Pairs(a, a_digits);
+        const uint64_t tb = Pairs(b, bc_digits);
+        const uint64_t tc = Pairs(c, bc_digits);
+        f.year = static_cast<int>((ta & 0xFF) * 100 + (ta >> 16 & 0xFF));
+        f.month = static_cast<int>(ta >> 40 & 0xFF);
+        f.day = static_cast<int>(tb & 0xFF);
+        f.hour = static_cast<int>(tb >> 24 & 0xFF);
+        f.minute = static_cast<int>(tb >> 48 & 0xFF);
+        f.second = static_cast<int>(tc >> 48 & 0xFF);
+        return CheckRanges(f);
+    }
+
+#ifdef X_DATETIME_SSE2
+    // The same as ScanDateTimeSWAR(), with SSE2.
+    static ParseError ScanDateTimeSSE2(const char* p, ISO8601Fields& f) {
+        // "YYYY-MM-DDTHH:MM" and, three characters on, "Y-MM-DDTHH:MM:SS".
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3));
+        const __m128i a_digits = _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+        const __m128i b_digits = _mm_setr_epi8(-1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+        // Everything but the separators is set to 0xFF before comparing, the 'T' included.
+        const __m128i a_keep = _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, 0, -1, -1, -1, -1, -1, 0, -1, -1);
+        const __m128i b_keep = _mm_setr_epi8(-1, 0, -1, -1, 0, -1, -1, -1, -1, -1, 0, -1, -1, 0, -1, -1);
+        const __m128i a_seps = _mm_setr_epi8(-1, -1, -1, -1, '-', -1, -1, '-', -1, -1, -1, -1, -1, ':', -1, -1);
+        const __m128i b_seps = _mm_setr_epi8(-1, '-', -1, -1, '-', -1, -1, -1, -1, -1, ':', -1, -1, ':', -1, -1);
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(a, a_keep), a_seps)) &
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(b, b_keep), b_seps))) != 0xFFFF) {
+            return ParseError::Mismatch;
+        }
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_andnot_si128(IsDigit(a), a_digits),
+                        _mm_andnot_si128(IsDigit(b), b_digits))) != 0) {
+            return ParseError::BadValue;
+        }
+        // 16-bit lane k becomes 10 * digit 2k + digit 2k+1. The month and hour are at odd
+        // positions in a, so they are paired up after shifting it by a byte.
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i da = _mm_sub_epi8(a, zero);
+        const __m128i db = _mm_sub_epi8(b, zero);
+        // Lanes 0, 1, 4 and 7 of a already line up; take lanes 2 and 5 from a shifted by a
+        // byte, and put the seconds (lane 7 of b) into the unused lane 3.
+        const __m128i odd = _mm_setr_epi16(0, 0, -1, 0, 0, -1, 0, 0);
+        const __m128i lane3 = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, 0);
+        __m128i d = _mm_or_si128(_mm_andnot_si128(odd, da), _mm_and_si128(odd, _mm_srli_si128(da, 1)));
+        d = _mm_or_si128(_mm_andnot_si128(lane3, d), _mm_and_si128(lane3, _mm_srli_si128(db, 8)));
+        uint16_t v[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(v), Pairs(d));
+        f.year = v[0] * 100 + v[1];
+        f.month = v[2];
+        f.second = v[3];
+        f.day = v[4];
+        f.hour = v[5];
+        f.minute = v[7];
+        return CheckRanges(f);
     }
+#endif
 
-    int TotalSeconds() const {
-        return static_cast<int>(d.count() / Ratio::den);
+private:
+    // Reads 8 characters as a little-endian word, whatever the byte order of the machine.
+    static uint64_t Load64(const char* p) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        return v;
     }
 
-    int TotalMilliseconds() const {
-        if (Ratio::den < 1000) {
-            return 0;
-        }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000.0)));
+    // Whether every byte of v selected by mask is an ASCII digit: its high nibble
+    // is 3, and stays 3 when 6 is added to it.
+    static bool AllDigits(uint64_t v, uint64_t mask) {
+        const uint64_t high = 0xF0F0F0F0F0F0F0F0ULL & mask;
+        const uint64_t threes = 0x3030303030303030ULL & mask;
+        return (v & high) == threes && ((v + 0x0606060606060606ULL) & high) == threes;
     }
 
-    int TotalMicroseconds() const {
-        if (Ratio::den <= 1000) {
-            return 0;
-        }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000.0)));
+    // The digits selected by mask as values 0-9, with byte k replaced by
+    // 10 * byte k + byte k+1. No byte can carry into the next.
+    static uint64_t Pairs(uint64_t v, uint64_t mask) {
+        const uint64_t d = (v & mask) - (0x3030303030303030ULL & mask);
+        return d * 10 + (d >> 8);
     }
 
-    int TotalNanoseconds() const {
-        if (Ratio::den <= 1000000) {
-            return 0;
-        }
-        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)));
+    static int CountTrailingZeros(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        int n = 0;
+        while (!(v & 1)) { v >>= 1; ++n; }
+        return n;
+#endif
     }
 
-    long long TotalDaysW() const {
-        return d.count() / Ratio::den / 86400;
+#ifdef X_DATETIME_SSE2
+    // 0xFF for each byte of v which is an ASCII digit.
+    static __m128i IsDigit(__m128i v) {
+        return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
     }
 
-    long long TotalHoursW() const {
-        return d.count() / Ratio::den / 3600;
+    static __m128i Pairs(__m128i d) {
+        return _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(d, _mm_set1_epi16(0xFF)), _mm_set1_epi16(10)),
+                _mm_srli_epi16(d, 8));
     }
+#endif
 
-    long long TotalMinutesW() const {
-        return d.count() / Ratio::den / 60;
+    static ParseError CheckRanges(const ISO8601Fields& f) {
+        if (f.month < 1 || f.month > 12 || f.day < 1 || f.day > GregorianCalendar::DaysInMonth(f.year, f.month) ||
+                f.hour > 23 || f.minute > 59 || f.second > 60) {
+            return ParseError::BadValue;
+        }
+        return ParseError::None;
+    }
+
+    static bool ReadPair(const char* p, int& v) {
+        if (p[0] < '0' || p[0] > '9' || p[1] < '0' || p[1] > '9') return false;
+        v = (p[0] - '0') * 10 + (p[1] - '0');
+        return true;
+    }
+
+    // Reads the digits of a fraction of a second, keeping the first 9 as nanoseconds.
+    // Returns false if there are none.
+    static bool ReadFraction(const char*& p, const char* last, int& ns) {
+        static const unsigned scale[10] = {1000000000, 100000000, 10000000, 1000000,
+            100000, 10000, 1000, 100, 10, 1};
+        uint64_t v = 0;
+        int n = 0;
+        if (last - p >= 8) {
+            // Find the first non-digit in 8 characters: a byte has its top bit set after
+            // subtracting '0' if it was below '0', or after adding 0x76 if it was above '9'.
+            // Borrows and carries only go upwards, from a non-digit, so they can't hide it.
+            uint64_t x = Load64(p) - 0x3030303030303030ULL;
+            const uint64_t non_digits = (x | (x + 0x7676767676767676ULL)) & 0x8080808080808080ULL;
+            n = non_digits ? CountTrailingZeros(non_digits) / 8 : 8;
+            if (n > 0) {
+                // Drop what follows the digits, leaving zeros in front of them, and
+                // combine the 8 digits pairwise.
+                x <<= 8 * (8 - n);
+                x = x * 10 + (x >> 8);
+                x = ((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+                        ((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+                v = x;
+                p += n;
+            }
+            if (n < 8) {
+                if (n == 0) return false;
+                ns = static_cast<int>(v * scale[n]);
+                return true;
+            }
+        }
+        for (; p != last && *p >= '0' && *p <= '9'; ++p, ++n) {
+            if (n < 9) v = v * 10 + static_cast<unsigned>(*p - '0');
+        }
+        if (n == 0) return false;
+        ns = static_cast<int>(v * scale[n < 9 ? n : 9]);
+        return true;
     }
+};
 
-    long long TotalSecondsW() const {
-        return d.count() / Ratio::den;
+// A fixed set of worker threads for DateTime::ParseMany(). Keep one around and pass it
+// in ParseManyOptions to reuse its threads across calls; otherwise ParseMany() starts
+// threads for the duration of the call.
+class ThreadPool {
+public:
+    // threads is the total number of threads to run tasks on, counting the one which
+    // calls Run(). 0 means one per hardware thread.
+    explicit ThreadPool(unsigned threads = 0) : generation(0), tasks(0), next(0), pending(0), stopping(false) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.push_back(std::thread(&ThreadPool::Work, this));
+        }
     }
 
-    long long TotalMillisecondsW() const {
-        if (Ratio::den < 1000) {
-            return 0;
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000.0));
+        wake.notify_all();
+        for (std::thread& t: workers) t.join();
     }
 
-    long long TotalMicrosecondsW() const {
-        if (Ratio::den <= 1000) {
-            return 0;
+    unsigned Size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Runs task(i) for every i in [0, n), on the workers and the calling thread, and
+    // returns when all of them are done. Only one Run() executes at a time.
+    void Run(size_t n, const std::function<void(size_t)>& task) {
+        std::lock_guard<std::mutex> serial(run_mutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &task;
+            tasks = n;
+            next.store(0, std::memory_order_relaxed);
+            pending = workers.size();
+            ++generation;
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000000.0));
+        wake.notify_all();
+        Drain(task, n);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        current = NULL;
     }
 
-    long long TotalNanosecondsW() const {
-        if (Ratio::den <= 1000000) {
-            return 0;
+    ThreadPool(const ThreadPool&) = delete;
+    void operator=(const ThreadPool&) = delete;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex run_mutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* current;
+    unsigned long long generation;
+    size_t tasks;
+    std::atomic<size_t> next;
+    size_t pending; // workers which have not finished the current generation
+    bool stopping;
+
+    void Drain(const std::function<void(size_t)>& task, size_t n) {
+        for (size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            task(i);
         }
-        return static_cast<long long>(d.count() / (Ratio::den / 1000000000.0));
     }
 
-    void AddDays(long long _days) {
-        long long a = _days * 86400 * Ratio::den;
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
+    void Work() {
+        unsigned long long seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* task;
+            size_t n;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                task = current;
+                n = tasks;
+            }
+            Drain(*task, n);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
         }
-        d += std::chrono::duration<long long, Ratio>(a);
     }
+};
 
-    void AddHours(long long _hours) {
-        long long a = _hours * 3600 * Ratio::den;
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+// How DateTime::ParseMany() splits up its work.
+struct ParseManyOptions {
+    unsigned threads;       // threads to parse on, 0 for one per hardware thread; ignored if pool is set
+    size_t min_chunk_size;  // buffers are not split into chunks smaller than this many bytes
+    ThreadPool* pool;       // workers to use instead of starting threads, or NULL
 
-    void AddMinutes(long long _minutes) {
-        long long a = _minutes * 60 * Ratio::den;
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+    ParseManyOptions() : threads(0), min_chunk_size(1 << 20), pool(NULL) {}
+};
 
-    void AddSeconds(long long _seconds) {
-        long long a = _seconds * Ratio::den;
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+struct ParseManyResult {
+    size_t rows;    // rows in the buffer, including any beyond the capacity of the output
+    size_t errors;  // rows which failed to parse
+};
 
-    void AddMilliseconds(long long _milliseconds) {
-        if (Ratio::den <= 1) return;
-        long long a = static_cast<long long>(_milliseconds * (Ratio::den / 1000));
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+#ifndef X_DATETIME_NO_LOCALES
+#define UTF8_CHAR_LEN( byte ) (( 0xE5000000 >> (( byte >> 3 ) & 0x1e )) & 3 ) + 1
+#endif
 
-    void AddMicroseconds(long long _microseconds) {
-        if (Ratio::den <= 1000) return;
-        long long a = static_cast<long long>(_microseconds * (Ratio::den / 1000000));
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+template <typename Ratio> class TimeDelta;
+template <typename Calendar, typename Clock, typename Period> class DateTimePeriod;
 
-    void AddNanoseconds(long long _nanoseconds) {
-        if (Ratio::den <= 1000000) return;
-        long long a = static_cast<long long>(_nanoseconds * (Ratio::den / 1000000000));
-        auto count = d.count();
-        if (a > 0 &&
-                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
-                || a < 0 &&
-                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
-                ) {
-            throw MalformedDateTime("Overflow during add/sub days");
-        }
-        d += std::chrono::duration<long long, Ratio>(a);
-    }
+template <typename Char, typename Traits, typename Ratio>
+static inline std::basic_ostream<Char, Traits> &
+operator<<(std::basic_ostream<Char, Traits> &os, const TimeDelta<Ratio> &obj);
 
-    void SubDays(long long _days) { AddDays(-_days); }
 
-    void SubHours(long long _hours) { AddHours(-_hours); }
+template <typename Char, typename Traits, typename Calendar, typename Clock, typename Period>
+static inline std::basic_ostream<Char, Traits> &
+operator<<(std::basic_ostream<Char, Traits> &os, const DateTime<Calendar, Clock, Period> &obj);
 
-    void SubMinutes(long long _minutes) { AddMinutes(-_minutes); }
 
-    void SubSeconds(long long _seconds) { AddSeconds(-_seconds); }
+template <typename Char, typename Traits, typename Calendar, typename Clock, typename Period>
+static inline std::basic_ostream<Char, Traits> &
+operator<<(std::basic_ostream<Char, Traits> &os, const DateTimePeriod<Calendar, Clock, Period> &obj);
 
-    void SubMilliseconds(long long _milliseconds) { AddMilliseconds(-_milliseconds); }
+template <typename Ratio>
+static inline TimeDelta<Ratio> operator+(const TimeDelta<Ratio> &a, const TimeDelta<Ratio> &b);
 
-    void SubMicroseconds(long long _microseconds) { AddMicroseconds(-_microseconds); }
+template <typename Ratio>
+static inline TimeDelta<Ratio> operator-(const TimeDelta<Ratio> &a, const TimeDelta<Ratio> &b);
 
-    void SubNanoseconds(long long _nanoseconds) { AddNanoseconds(-_nanoseconds); }
+template <typename Calendar, typename Clock, typename Period>
+static inline DateTime<Calendar, Clock, Period> operator+(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b);
 
-    template <typename NewRatio = Ratio>
-    std::chrono::duration<long long, NewRatio> ToChrono() const {
-        long long count = d.count();
-        long long q = count / Ratio::den;
-        long long r = count % Ratio::den;
-        if (q > LLONG_MAX/NewRatio::den || q < LLONG_MIN/NewRatio::den) {
-            throw MalformedDateTime("Conversion to std::chrono::duration is not possible without overflow.");
-        }
+template <typename Calendar, typename Clock, typename Period>
+static inline DateTime<Calendar, Clock, Period> operator+(const TimeDelta<Period> &a, const DateTime<Calendar, Clock, Period> &b);
+
+template <typename Calendar, typename Clock, typename Period>
+static inline TimeDelta<Period> operator-(const DateTime<Calendar, Clock, Period> &a, const DateTime<Calendar, Clock, Period> &b);
+
+template <typename Calendar, typename Clock, typename Period>
+static inline DateTime<Calendar, Clock, Period> operator-(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b);
+
+template<typename Ratio = std::nano> class TimeDelta {
+private:
+    std::chrono::duration<long long, Ratio> d;
+
+    template <typename Calendar, typename Clock, typename Period>
+    friend class DateTime;
+
+public:
+    TimeDelta() { this->d = std::chrono::hours(0); }
+
+    template <typename OldRatio = Ratio>
+    TimeDelta(const TimeDelta<OldRatio> &a) : TimeDelta(a.d) {}
+
+    template <typename OldRatio = Ratio, typename Length>
+    TimeDelta(const std::chrono::duration<Length, OldRatio>& d) {
+        long long count = static_cast<long long>(d.count());
+        long long q = count / OldRatio::den;
+        long long r = count % OldRatio::den;
         q *= Ratio::den;
-        if (Ratio::den > NewRatio::den) {
-            r /= Ratio::den / NewRatio::den;
+        if (Ratio::den > OldRatio::den) {
+            r *= Ratio::den / OldRatio::den;
         }
         else {
-            r *= NewRatio::den / Ratio::den;
-        }
-        if (q > LLONG_MAX - r || q < LLONG_MIN + r) {
-            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
+            r /= OldRatio::den / Ratio::den;
         }
         q += r;
-        return std::chrono::duration<long long, NewRatio>(q);
+        this->d = std::chrono::duration<long long, Ratio>(q);
     }
 
 #ifdef X_DATETIME_WITH_BOOST
-    boost::posix_time::time_duration ToBoostTimeDuration() const {
-        TimeEncapsulation e = Encapsulate();
-        boost::posix_time::time_duration td;
-        td += boost::posix_time::hours(e.h + 24 * e.d);
-        td += boost::posix_time::minutes(e.min);
-        td += boost::posix_time::seconds(e.s);
-
+    TimeDelta(const boost::posix_time::time_duration& td) {
+        int FS = 0;
 #ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
-        if (e.ns != 0) {
-            td += boost::posix_time::nanoseconds(e.ns);
+        if (Ratio::den > 1000000) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (td.total_nanoseconds() % 1000000000) /
+                        (Ratio::den / 1000000000.0)) % 1000000000);
         }
+#else
+        if (false) {}
 #endif
-        if (e.us != 0) {
-            td += boost::posix_time::microseconds(e.us);
+        else if (Ratio::den > 1000) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (td.total_microseconds() % 1000000) /
+                        (Ratio::den / 1000000.0)) % 1000000);
         }
-        if (e.ms != 0) {
-            td += boost::posix_time::milliseconds(e.ms);
+        else if (Ratio::den > 1) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (td.total_milliseconds() % 1000) /
+                        (Ratio::den / 1000.0)) % 1000);
         }
-
-        return td;
+        *this = TimeDelta(0, td.hours(), td.minutes(), td.seconds(), FS);
     }
 #endif
 
 #ifdef X_DATETIME_WITH_ABSEIL
-    absl::Duration ToAbseilDuration() const {
-        return absl::FromChrono(ToChrono());
+    TimeDelta(const absl::Duration& t) {
+        if (Ratio::den > 1000000) {
+            *this = TimeDelta(absl::ToChronoNanoseconds(t));
+        }
+        else if (Ratio::den > 1000) {
+            *this = TimeDelta(absl::ToChronoMicroseconds(t));
+        }
+        else if (Ratio::den > 1) {
+            *this = TimeDelta(absl::ToChronoMilliseconds(t));
+        }
+        else {
+            *this = TimeDelta(absl::ToChronoSeconds(t));
+        }
     }
 #endif
 
-    template<typename Char, typename Traits, typename Ratio_>
-    friend std::basic_ostream<Char, Traits> &operator<<(std::basic_ostream<Char, Traits> &os, const TimeDelta<Ratio_> &obj);
-
-};
+    TimeDelta(long long _days) {
+        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * 60 * 24 * _days);
+    }
 
+    TimeDelta(long long _days, long long _hours) {
+        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * 60 *
+                        (_hours + 24 * _days));
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Days(long long a) {
-    return TimeDelta<Ratio>(a, 0, 0, 0, 0);
-}
+    TimeDelta(long long _days, long long _hours, long long _minutes) {
+        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * 60 * (_minutes + 60 *
+                        (_hours + 24 * _days)));
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Hours(long long a) {
-    return TimeDelta<Ratio>(0, a, 0, 0, 0);
-}
+    TimeDelta(long long _days, long long _hours, long long _minutes, long long _seconds) {
+        this->d = std::chrono::duration<long long, Ratio>(Ratio::den * (_seconds + 60 * (_minutes + 60 *
+                        (_hours + 24 * _days))));
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Minutes(long long a) {
-    return TimeDelta<Ratio>(0, 0, a, 0, 0);
-}
+    // Note: the precision of _fracseconds depends on the Ratio template.
+    // By default, it is nanoseconds.
+    // However, if you change it to microseconds, or milliseconds, or something else, that
+    // will be its precision.
+    TimeDelta(long long _days, long long _hours, long long _minutes, long long _seconds, long long _fracseconds) {
+        this->d = std::chrono::duration<long long, Ratio>(_fracseconds + Ratio::den * (_seconds + 60 * (_minutes + 60 *
+                        (_hours + 24 * _days))));
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Seconds(long long a) {
-    return TimeDelta<Ratio>(0, 0, 0, a, 0);
-}
+    TimeDelta Abs() const {
+        if (d.count() < 0)
+            return TimeDelta(-d);
+        else return *this;
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Milliseconds(long long a) {
-    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000);
-}
+    std::chrono::duration<long long, Ratio> SinceEpoch() const {
+        return TimeDelta<Ratio>(std::chrono::system_clock::now().time_since_epoch());
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Microseconds(long long a) {
-    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000000);
-}
+    TimeDelta &operator=(const TimeDelta &other) {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+        this->d = other.d;
+        return *this;
+    }
 
-template<typename Ratio = std::nano>
-inline static TimeDelta<Ratio> Nanoseconds(long long a) {
-    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000000000);
-}
+    template <typename Ratio_>
+    friend TimeDelta<Ratio_> operator+(const TimeDelta<Ratio_> &a,
+            const TimeDelta<Ratio_> &b);
 
-// Calculates the offset of Clock2 relative to Clock1, in seconds.
-// Assumes the fractional seconds part of the epoches for Clock1 and Clock2 are both zero.
-template <typename Clock1, typename Clock2>
-long long ClockOffset() {
-        auto now1clock = Clock1::now();
-        auto now2clock = Clock2::now();
+    template <typename Ratio_>
+    friend TimeDelta<Ratio_> operator-(const TimeDelta<Ratio_> &a,
+            const TimeDelta<Ratio_> &b);
+    TimeDelta<Ratio> &operator+=(const TimeDelta<Ratio> &rhs) {
+        d += rhs.d;
+        return *this;
+    }
+    TimeDelta<Ratio> &operator-=(const TimeDelta<Ratio> &rhs) {
+        d -= rhs.d;
+        return *this;
+    }
 
-        // We have no idea at what second the template clock starts on. But this method works on an important
-        // assumption: that the fractional seconds part of both clocks' epoch are zero.
-        std::chrono::duration<long long, std::milli> now1 = std::chrono::duration_cast<std::chrono::milliseconds>(now1clock.time_since_epoch());
-        std::chrono::duration<long long, std::milli> now2 = std::chrono::duration_cast<std::chrono::milliseconds>(now2clock.time_since_epoch());
+    bool operator==(const TimeDelta<Ratio> &rhs) const { return d == rhs.d; }
+    bool operator!=(const TimeDelta<Ratio> &rhs) const { return d != rhs.d; }
+    bool operator<(const TimeDelta<Ratio> &rhs) const { return d < rhs.d; }
+    bool operator>(const TimeDelta<Ratio> &rhs) const { return d > rhs.d; }
+    bool operator<=(const TimeDelta<Ratio> &rhs) const { return d <= rhs.d; }
+    bool operator>=(const TimeDelta<Ratio> &rhs) const { return d >= rhs.d; }
 
-        long long dur1 = static_cast<long long>(now1.count());
-        long long dur2 = static_cast<long long>(now2.count());
+    bool operator!() const { return d.count() == 0; }
+    operator bool() const { return d.count() != 0; }
 
-        if (dur1 % 1000 > dur2 % 1000) {
-            // The clock's second hand changed in between libc calls. 
-            // Increase the second hand.
-            dur1 += 1000;
+    int Days() const {
+        return static_cast<int>(d.count() / Ratio::den / 86400);
+    }
 
-            // Convert to seconds (truncating division)
-            dur1 /= 1000;
-            dur2 /= 1000;
-        }
+    int Hours() const {
+        return static_cast<int>(d.count() / Ratio::den / 3600 % 24);
+    }
 
-        // Calculate the number of seconds we must add to the time_point to align with "dur2"'s epoch.
-        long long offset = dur2 - dur1;
-        return offset;
-}
+    int Minutes() const {
+        return static_cast<int>(d.count() / Ratio::den / 60 % 60);
+    }
 
+    int Seconds() const {
+        return static_cast<int>(d.count() / Ratio::den % 60);
+    }
 
-template <typename Calendar = GregorianCalendar, typename Clock = std::chrono::system_clock,
-         typename Period = typename std::chrono::time_point<Clock>::period>
-class DateTime {
-private:
-    std::chrono::time_point<Clock> tp;
-    const long long unix_offset; // number of seconds this clock differs from Unix time. (0 for system_clock)
-    Timezone tz; // initialize like this: UTC_Timezone().tz
-    using time_point = typename std::chrono::time_point<Clock>;
-    using clock_duration = typename time_point::duration;
-    typedef typename time_point::period ClockPeriod;
+    int Milliseconds() const {
+        if (Ratio::den < 1000) {
+            return 0;
+        }
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000);
+    }
 
-    void assertValidPeriod() {
-        if (ClockPeriod::den < Period::den) {
-            throw MalformedDateTime("Specified duration must not be more granular than clock's duration)");
+    int Microseconds() const {
+        if (Ratio::den <= 1000) {
+            return 0;
         }
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000);
     }
 
-public:
-    DateTime(Timezone zone = UTC_Timezone().tz)
-        : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone) {
-        assertValidPeriod();
-        tp = time_point(clock_duration(unix_offset * (ClockPeriod::den)));
+    int Nanoseconds() const {
+        if (Ratio::den <= 1000000) {
+            return 0;
+        }
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000);
     }
-    DateTime(const DateTime<Calendar, Clock, Period> &a) : tp(a.tp), unix_offset(a.unix_offset), tz(a.tz) {}
 
-    explicit DateTime(time_t t, Timezone zone = UTC_Timezone().tz)
-        : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone) {
-        assertValidPeriod();
-        tp = time_point(clock_duration((t + unix_offset) * Period::den));
+    long long DaysW() const {
+        return d.count() / Ratio::den / 86400;
     }
-    DateTime(struct tm *tm): DateTime(mktime(tm)) {}
 
-    // 00:00 UTC+0
-    DateTime(int y, int m, int d, Timezone zone = UTC_Timezone().tz)
-        : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone) {
-        assertValidPeriod();
-        struct tm t;
-        memset(&t, 0, sizeof(struct tm));
-        t.tm_year = y - 1900;
-        t.tm_mon = m - 1;
-        t.tm_mday = d;
-        tp = time_point(clock_duration((mktime(&t) + unix_offset) * Period::den));
+    long long HoursW() const {
+        return d.count() / Ratio::den / 3600 % 24;
     }
 
-    DateTime(int y, int m, int d, int H, int M, int S, Timezone zone = UTC_Timezone().tz)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone){
-        assertValidPeriod();
-        struct tm t;
-        memset(&t, 0, sizeof(struct tm));
-        t.tm_year = y - 1900;
-        t.tm_mon = m - 1;
-        t.tm_mday = d;
-        t.tm_hour = H;
-        t.tm_min = M;
-        t.tm_sec = S;
-        tp = time_point(clock_duration((mktime(&t) + unix_offset) * Period::den));
-    }
-
-    DateTime(int y, int m, int d, int H, int M, int S, int FS, Timezone zone = UTC_Timezone().tz)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone){
-        assertValidPeriod();
-        struct tm t;
-        memset(&t, 0, sizeof(struct tm));
-        t.tm_year = y - 1900;
-        t.tm_mon = m - 1;
-        t.tm_mday = d;
-        t.tm_hour = H;
-        t.tm_min = M;
-        t.tm_sec = S;
+    long long MinutesW() const {
+        return d.count() / Ratio::den / 60 % 60;
+    }
 
-        tp = time_point(clock_duration((mktime(&t) + unix_offset) * Period::den + FS));
+    long long SecondsW() const {
+        return d.count() / Ratio::den % 60;
     }
 
-    explicit DateTime(const std::string &s, const std::string &locale = "C")
-        : unix_offset(ClockOffset<std::chrono::system_clock, Clock>())
-    {
-        assertValidPeriod();
-        //Use the local representation first and then ISO 8601 and other common formats.
-
-        std::vector<std::string> datetime_strs;
-        datetime_strs.push_back(LocaleData::GetDateTimeFormat(locale.c_str()));
-        datetime_strs.push_back(LocaleData::GetDate1Format(locale.c_str()));
-        datetime_strs.push_back(LocaleData::GetDateFormat(locale.c_str()));
-        datetime_strs.push_back(LocaleData::GetTime24Format(locale.c_str()));
-        datetime_strs.push_back(LocaleData::GetTime12Format(locale.c_str()));
-
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%3Z%z");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%3Z");
-        datetime_strs.push_back("%Y-%m-%d %H:%M:%S.%3");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%2Z%z");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%2Z");
-        datetime_strs.push_back("%Y-%m-%d %H:%M:%S.%2");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%1Z%z");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%S.%1Z");
-        datetime_strs.push_back("%Y-%m-%d %H:%M:%S.%1");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%SZ%z");
-        datetime_strs.push_back("%Y-%m-%dT%H:%M:%SZ");
-        datetime_strs.push_back("%Y-%m-%d %H:%M:%S");
-        datetime_strs.push_back("%Y-%m-%d %H:%M");
-        datetime_strs.push_back("%Y-%m-%d");
-
-        /***************  BEWARE ******************
-         *
-         * struct tm's tm_year field stores years
-         * since 1900. It does NOT store the exact
-         * year. tm_month is also between 0 and 11.
-         *
-         */
-        bool was_imported = false;
-        for (auto fmt: datetime_strs) {
-            try {
-                FromString(s, fmt);
-                was_imported = true;
-                break;
-            }
-            catch (const MalformedDateTime&) {}
+    long long MillisecondsW() const {
+        if (Ratio::den < 1000) {
+            return 0;
         }
-        if (!was_imported) {
-            throw MalformedDateTime("None of the ISO8601 or supplied locale formats could interpret the string.");
+        return static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000;
+    }
+
+    long long MicrosecondsW() const {
+        if (Ratio::den <= 1000) {
+            return 0;
         }
+        return static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000;
     }
 
-    DateTime(const std::chrono::time_point<Clock> &_tp, Timezone zone = UTC_Timezone().tz) :
-    unix_offset(ClockOffset<std::chrono::system_clock, Clock>()), tz(zone) {
-        assertValidPeriod();
-        long long count = static_cast<long long>(_tp.time_since_epoch().count());
-        long long q = count / ClockPeriod::den;
-        long long r = count % ClockPeriod::den;
-        q += unix_offset;
-        q *= Period::den;
-        if (Period::den > ClockPeriod::den) {
-            r *= Period::den / ClockPeriod::den;
+    long long NanosecondsW() const {
+        if (Ratio::den <= 1000000) {
+            return 0;
         }
-        else {
-            r /= ClockPeriod::den / Period::den;
+        return static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000;
+    }
+
+    template <typename Calendar_, typename Clock_, typename Period_>
+    friend DateTime<Calendar_, Clock_, Period_> operator+(const DateTime<Calendar_, Clock_, Period_> &a, const TimeDelta<Period_> &b);
+
+    template <typename Calendar_, typename Clock_, typename Period_>
+    friend DateTime<Calendar_, Clock_, Period_> operator+(const TimeDelta<Period_> &a, const DateTime<Calendar_, Clock_, Period_> &b);
+
+    template <typename Calendar_, typename Clock_, typename Period_>
+    friend DateTime<Calendar_, Clock_, Period_> operator-(const DateTime<Calendar_, Clock_, Period_> &a, const TimeDelta<Period_> &b);
+
+    template <typename Calendar_, typename Clock_, typename Period_>
+    friend TimeDelta<Period_> operator-(const DateTime<Calendar_, Clock_, Period_> &a, const DateTime<Calendar_, Clock_, Period_> &b);
+
+private:
+
+    struct TimeEncapsulation {
+        long long ns, us, ms, s, min, h, d;
+    };
+
+    TimeEncapsulation Encapsulate() const {
+        TimeEncapsulation e;
+        e.ns = 0;
+        e.us = 0;
+        e.ms = 0;
+        long long count = d.count();
+        if (Ratio::den > 1000000) {
+            e.ns = static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)) % 1000000000;
         }
-        q += r;
-        tp = time_point(clock_duration(q));
-        
+        else if (Ratio::den > 1000) {
+            e.us = static_cast<long long>(d.count() / (Ratio::den / 1000000.0)) % 1000000;
+        }
+        else if (Ratio::den > 1) {
+            e.ms = static_cast<long long>(d.count() / (Ratio::den / 1000.0)) % 1000;
+        }
+        count /= Ratio::den;
+        e.s = count % 60;
+        count /= 60;
+        e.min = count % 60;
+        count /= 60;
+        e.h = count % 24;
+        count /= 24;
+        e.d = count;
+        return e;
+    }
+
+public:
 
+    std::string ToString() const {
+        std::string str;
+        FormatStringSink sink = {str};
+        FormatWith(sink);
+        return str;
     }
-    
-    DateTime(const TimeDelta<Period> &td, Timezone zone = UTC_Timezone().tz)
-    : unix_offset(0 /* i.e. TimeDelta uses system_clock */), tz(zone) {
-        assertValidPeriod();
-        tp = std::chrono::system_clock::now() + td.ToChrono();
+
+    // Writes the same text as ToString() without allocating, with the same
+    // conventions as DateTime::FormatTo(). 128 bytes is always enough.
+    size_t FormatTo(char* buf, size_t cap) const {
+        FormatBufferSink sink = {buf, cap ? cap - 1 : 0, 0};
+        FormatWith(sink);
+        if (cap) buf[(sink.len < cap - 1) ? sink.len : cap - 1] = '\0';
+        return sink.len;
     }
 
-#ifdef X_DATETIME_WITH_BOOST
-    DateTime(const boost::posix_time::ptime& p)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        auto date = p.date();
-        auto tod = p.time_of_day();
-        int FS = 0;
-#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
+    template <typename OutputIt>
+    OutputIt FormatTo(OutputIt out) const {
+        FormatIteratorSink<OutputIt> sink = {out};
+        FormatWith(sink);
+        return sink.it;
+    }
+
+    template <typename Sink>
+    void FormatWith(Sink& out) const {
+        TimeEncapsulation e = Encapsulate();
+        AppendInteger(out, e.d);
+        out.Append("d ", 2);
+        AppendInteger(out, e.h);
+        out.Append("h ", 2);
+        AppendInteger(out, e.min);
+        out.Append("min ", 4);
+        AppendInteger(out, e.s);
+        out.Append("s", 1);
+
+        // Depending on the range we use, print fractional
+        // seconds in the highest supported resolution.
+        // This won't print anything for any precision coarser
+        // than milliseconds.
         if (Ratio::den > 1000000) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (tod.total_nanoseconds() % 1000000000) /
-                        (Period::den / 1000000000.0)) % 1000000000);
+            out.Append(" ", 1);
+            AppendInteger(out, e.ns);
+            out.Append("ns", 2);
         }
-#else
-        if (false) {}
-#endif
-        else if (Period::den > 1000) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (tod.total_microseconds() % 1000000) /
-                        (Period::den / 1000000.0)) % 1000000);
+        else if (Ratio::den > 1000) {
+            const char* us = X_DATETIME_UTF8_STR("μs");
+            out.Append(" ", 1);
+            AppendInteger(out, e.us);
+            out.Append(us, strlen(us));
         }
-        else if (Period::den > 1) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (tod.total_milliseconds() % 1000) /
-                        (Period::den / 1000.0)) % 1000);
+        else if (Ratio::den > 1) {
+            out.Append(" ", 1);
+            AppendInteger(out, e.ms);
+            out.Append("ms", 2);
         }
-        *this = DateTime(static_cast<int>(date.year()),
-                static_cast<int>(date.month()),
-                static_cast<int>(date.day()),
-                static_cast<int>(tod.hours()),
-                static_cast<int>(tod.minutes()),
-                static_cast<int>(tod.seconds()), FS);
     }
-#endif /* X_DATETIME_WITH_BOOST */
 
-#ifdef X_DATETIME_WITH_ABSEIL
-    DateTime(const absl::CivilSecond& civ)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        *this = DateTime(civ.year(), civ.month(), civ.day(),
-                civ.hour(), civ.minute(), civ.second(), 0);
+
+    int TotalDays() const {
+        return static_cast<int>(d.count() / Ratio::den / 86400);
     }
 
-    DateTime(const absl::CivilMinute& civ)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        *this = DateTime(civ.year(), civ.month(), civ.day(),
-                civ.hour(), civ.minute(), 0, 0);
+    int TotalHours() const {
+        return static_cast<int>(d.count() / Ratio::den / 3600);
     }
 
-    DateTime(const absl::CivilHour& civ)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        *this = DateTime(civ.year(), civ.month(), civ.day(),
-                civ.hour(), 0, 0, 0);
+    int TotalMinutes() const {
+        return static_cast<int>(d.count() / Ratio::den / 60);
     }
 
-    DateTime(const absl::CivilDay& civ)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        *this = DateTime(civ.year(), civ.month(), civ.day(),
-                0, 0, 0, 0);
+    int TotalSeconds() const {
+        return static_cast<int>(d.count() / Ratio::den);
     }
 
-    DateTime(const absl::Time& t)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        *this = DateTime(absl::ToChronoTime(t));
+    int TotalMilliseconds() const {
+        if (Ratio::den < 1000) {
+            return 0;
+        }
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000.0)));
     }
-#endif /* X_DATETIME_WITH_ABSEIL */
 
-#ifdef X_DATETIME_WITH_POCO
-    DateTime(const Poco::DateTime& p)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        assertValidPeriod();
-        int FS = 0;
-        if (Period::den > 1000) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (p.microsecond() % 1000000) /
-                        (Period::den / 1000000.0)) % 1000000);
-        }
-        else if (Period::den > 1) {
-            FS = static_cast<int>(static_cast<long long>(
-                        (p.millisecond() % 1000) /
-                        (Period::den / 1000.0)) % 1000);
+    int TotalMicroseconds() const {
+        if (Ratio::den <= 1000) {
+            return 0;
         }
-        *this = DateTime(p.year(), p.month(), p.day(),
-                p.hour(), p.minute(), p.second(), FS);
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000.0)));
     }
-#endif /* X_DATETIME_WITH_POCO */
 
-#ifdef X_DATETIME_WITH_GLIB
-    DateTime(GDateTime* datetime)
-    : unix_offset(ClockOffset<std::chrono::system_clock, Clock>()) {
-        *this = DateTime(static_cast<time_t>(g_date_time_to_unix(datetime)));
-        AddMicroseconds(g_date_time_get_microsecond(datetime));
+    int TotalNanoseconds() const {
+        if (Ratio::den <= 1000000) {
+            return 0;
+        }
+        return static_cast<int>(static_cast<long long>(d.count() / (Ratio::den / 1000000000.0)));
     }
-#endif /* X_DATETIME_WITH_GLIB */
-
-    void FromString(const std::string& input, const std::string &fmt, const std::string& locale = "C") {
-        int i = 0;
-        int ms = 0;
-        int us = 0;
-        int ns = 0;
-        int d = 0;
-        int e = 0;
-        int G = 0;
-        int g = 0;
-        int m = 0;
-        int Y = 0;
-        int H = 0;
-        int I = 0;
-        int M = 0;
-        long long ssepoch = true;
-        int S = 0;
-        int u = 0;
-        int U = 0;
-        int V = 0;
-        int W = 0;
-        int y = 0;
-        int C = 0;
-        int doy = 0;
-        int k = 0;
-        int l = 0;
-        int zhh = 0;
-        int zmm = 0;
-        std::string zname;
-        bool have_am = false;
-        bool have_pm = false;
-        bool have_ms = false;
-        bool have_us = false;
-        bool have_ns = false;
-        bool have_d = false;
-        bool have_e = false;
-        bool have_G = false;
-        bool have_g = false;
-        bool have_m = false;
-        bool have_Y = false;
-        bool have_H = false;
-        bool have_I = false;
-        bool have_M = false;
-        bool have_ssepoch = false;
-        bool have_S = false;
-        bool have_u = false;
-        bool have_U = false;
-        bool have_V = false;
-        bool have_W = false;
-        bool have_y = false;
-        bool have_C = false;
-        bool have_doy = false;
-        bool have_k = false;
-        bool have_l = false;
-        bool have_z = false;
-        bool have_Z = false;
-
-        bool format = false; // Encountered %?
-        bool era = false; // Encountered %E?
-        bool alt = false; // Encountered %O?
-                          
-        std::string s = input;
-        std::string this_format = fmt;
-        std::string old_format;
-        int old_ci = -1;
-        int ci = 0;
-
-        if (s.empty()) return;
-
-nested_junction:
-        for (; ci < this_format.size(); ++ci) {
-            char c = this_format[ci];
-            switch (c) {
-                case '%':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    // ignore literal characters
-                    format = false;
-                }
-                else {
-                    format = true;
-                    break;
-                }
-                if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                ++i;
-                break;
-
-                case '1':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxms = 3;
-                    std::string tmp;
-                    for (int j = 0; j < maxms; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    ms = std::stoi(tmp);
-                    have_ms = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxms = 3;
-                    std::string tmp;
-                    for (int j = 0; j < maxms; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    ms = std::stoi(tmp);
-                    have_ms = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
 
-                case '2':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxus = 6;
-                    std::string tmp;
-                    for (int j = 0; j < maxus; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    us = std::stoi(tmp);
-                    have_us = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxus = 6;
-                    std::string tmp;
-                    for (int j = 0; j < maxus; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    us = std::stoi(tmp);
-                    have_us = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    long long TotalDaysW() const {
+        return d.count() / Ratio::den / 86400;
+    }
 
-                case '3':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxns = 9;
-                    std::string tmp;
-                    for (int j = 0; j < maxns; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    us = std::stoi(tmp);
-                    have_ns = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxns = 9;
-                    std::string tmp;
-                    for (int j = 0; j < maxns; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    ns = std::stoi(tmp);
-                    have_ns = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    long long TotalHoursW() const {
+        return d.count() / Ratio::den / 3600;
+    }
 
-                case 'a':
-                // We should make a rule that says all locales are required to have exactly 7 days in a week.
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    for (int j = 0; j < 7; ++j) {
-                        std::string _a = LocaleData::GetShortWeekday(locale.c_str(), j);
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            u = j;
-                            have_u = true;
-                            i += strlen(_a.data());
-                            break;
-                        }
-                    }
-                    if (!have_u) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    long long TotalMinutesW() const {
+        return d.count() / Ratio::den / 60;
+    }
 
+    long long TotalSecondsW() const {
+        return d.count() / Ratio::den;
+    }
 
-                case 'A':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    for (int j = 0; j < 7; ++j) {
-                        std::string _a = LocaleData::GetLongWeekday(locale.c_str(), j);
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            u = j;
-                            have_u = true;
-                            i += strlen(_a.data());
-                            break;
-                        }
-                    }
-                    if (!have_u) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    long long TotalMillisecondsW() const {
+        if (Ratio::den < 1000) {
+            return 0;
+        }
+        return static_cast<long long>(d.count() / (Ratio::den / 1000.0));
+    }
 
+    long long TotalMicrosecondsW() const {
+        if (Ratio::den <= 1000) {
+            return 0;
+        }
+        return static_cast<long long>(d.count() / (Ratio::den / 1000000.0));
+    }
 
-                case 'b':
-                case 'h':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    for (int j = 0; j < 12; ++j) {
-                        std::string _a = LocaleData::GetShortMonth(locale.c_str(), j);
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            m = j+1;
-                            have_m = true;
-                            i += strlen(_a.data());
-                            break;
-                        }
-                    }
-                    if (!have_m) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    long long TotalNanosecondsW() const {
+        if (Ratio::den <= 1000000) {
+            return 0;
+        }
+        return static_cast<long long>(d.count() / (Ratio::den / 1000000000.0));
+    }
 
+    void AddDays(long long _days) {
+        long long a = _days * 86400 * Ratio::den;
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'B':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    for (int j = 0; j < 12; ++j) {
-                        std::string _a = LocaleData::GetLongMonth(locale.c_str(), j);
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            m = j;
-                            have_m = true;
-                            i += strlen(_a.data());
-                            break;
-                        }
-                    }
-                    if (!have_m) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
-                
-
-                case 'c':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format || era) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetDateTimeFormat(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void AddHours(long long _hours) {
+        long long a = _hours * 3600 * Ratio::den;
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'C':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    std::string tmp;
-                    for (int j = 0 ; /* true */ ; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    C = std::stoi(tmp) * 100;
-                    have_C = true;
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    std::string tmp;
-                    for (int j = 0; /* true */; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    C = std::stoi(tmp);
-                    have_C = true;
-                    era = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void AddMinutes(long long _minutes) {
+        long long a = _minutes * 60 * Ratio::den;
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'd':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxd = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxd; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    d = std::stoi(tmp);
-                    have_d = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxd = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxd; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    d = std::stoi(tmp);
-                    have_d = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void AddSeconds(long long _seconds) {
+        long long a = _seconds * Ratio::den;
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'D':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = "%m/%d/%y";
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void AddMilliseconds(long long _milliseconds) {
+        if (Ratio::den <= 1) return;
+        long long a = static_cast<long long>(_milliseconds * (Ratio::den / 1000));
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'e':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxe = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0 ; j < maxe - spacer; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    e = std::stoi(tmp);
-                    have_e = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxe = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0; j < maxe - spacer; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    e = std::stoi(tmp);
-                    have_e = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void AddMicroseconds(long long _microseconds) {
+        if (Ratio::den <= 1000) return;
+        long long a = static_cast<long long>(_microseconds * (Ratio::den / 1000000));
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
+    void AddNanoseconds(long long _nanoseconds) {
+        if (Ratio::den <= 1000000) return;
+        long long a = static_cast<long long>(_nanoseconds * (Ratio::den / 1000000000));
+        auto count = d.count();
+        if (a > 0 &&
+                (count > 0 && count > LLONG_MAX - a || count < 0 && count < LLONG_MIN + a)
+                || a < 0 &&
+                (count > 0 && count > LLONG_MAX + a || count < 0 && count < LLONG_MIN - a)
+                ) {
+            throw MalformedDateTime("Overflow during add/sub days");
+        }
+        d += std::chrono::duration<long long, Ratio>(a);
+    }
 
-                case 'E':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                   era = true;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubDays(long long _days) { AddDays(-_days); }
 
-                case 'F':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = "%Y-%m-%d";
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubHours(long long _hours) { AddHours(-_hours); }
 
-                case 'G':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    std::string tmp;
-                    for (int j = 0 ; /* true */; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    G = std::stoi(tmp);
-                    have_G = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    std::string tmp;
-                    for (int j = 0; /* true */; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    G = std::stoi(tmp);
-                    have_G = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubMinutes(long long _minutes) { AddMinutes(-_minutes); }
 
-                case 'g':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxg = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxg; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    g = std::stoi(tmp);
-                    have_g = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxg = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxg; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    g = std::stoi(tmp);
-                    have_g = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubSeconds(long long _seconds) { AddSeconds(-_seconds); }
 
-                case 'H':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxH = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxH; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    H = std::stoi(tmp);
-                    have_H = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxH = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxH; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    g = std::stoi(tmp);
-                    have_g = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
-                
-                case 'I':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxI = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxI; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    I = std::stoi(tmp);
-                    have_I = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxI = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxI; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    I = std::stoi(tmp);
-                    have_I = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubMilliseconds(long long _milliseconds) { AddMilliseconds(-_milliseconds); }
 
-                case 'j':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxdoy = 3;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxdoy; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    doy = std::stoi(tmp);
-                    have_doy = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxdoy = 3;
-                    std::string tmp;
-                    for (int j = 0; j < maxdoy; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    doy = std::stoi(tmp);
-                    have_doy = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubMicroseconds(long long _microseconds) { AddMicroseconds(-_microseconds); }
 
-                case 'k':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxk = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0 ; j < maxk - spacer; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    k = std::stoi(tmp);
-                    have_k = true;
-                    format = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxk = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0 ; j < maxk - spacer; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                        if (altdig != -1) tmp += (char) (altdig + '0');
-                        else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    k = std::stoi(tmp);
-                    have_k = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    void SubNanoseconds(long long _nanoseconds) { AddNanoseconds(-_nanoseconds); }
 
-                case 'l':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxl = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0 ; j < maxl - spacer; ++j, ++i) {
-                        if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                        else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    l = std::stoi(tmp);
-                    have_l = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxl = 2;
-                    std::string tmp;
-                    int spacer = 0;
-                    while (isspace(s[i])) ++i, ++spacer;
-                    for (int j = 0 ; j < maxl - spacer; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                        if (altdig != -1) tmp += (char) (altdig + '0');
-                        else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    l = std::stoi(tmp);
-                    have_l = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    template <typename NewRatio = Ratio>
+    std::chrono::duration<long long, NewRatio> ToChrono() const {
+        long long count = d.count();
+        long long q = count / Ratio::den;
+        long long r = count % Ratio::den;
+        if (q > LLONG_MAX/NewRatio::den || q < LLONG_MIN/NewRatio::den) {
+            throw MalformedDateTime("Conversion to std::chrono::duration is not possible without overflow.");
+        }
+        q *= Ratio::den;
+        if (Ratio::den > NewRatio::den) {
+            r /= Ratio::den / NewRatio::den;
+        }
+        else {
+            r *= NewRatio::den / Ratio::den;
+        }
+        if (q > LLONG_MAX - r || q < LLONG_MIN + r) {
+            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
+        }
+        q += r;
+        return std::chrono::duration<long long, NewRatio>(q);
+    }
 
-                case 'm':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxm = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxm; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    m = std::stoi(tmp);
-                    have_m = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxm = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxm; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    m = std::stoi(tmp);
-                    have_m = true;
-                    alt = false;
-                }
+#ifdef X_DATETIME_WITH_BOOST
+    boost::posix_time::time_duration ToBoostTimeDuration() const {
+        TimeEncapsulation e = Encapsulate();
+        boost::posix_time::time_duration td;
+        td += boost::posix_time::hours(e.h + 24 * e.d);
+        td += boost::posix_time::minutes(e.min);
+        td += boost::posix_time::seconds(e.s);
+
+#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
+        if (e.ns != 0) {
+            td += boost::posix_time::nanoseconds(e.ns);
+        }
 #endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+        if (e.us != 0) {
+            td += boost::posix_time::microseconds(e.us);
+        }
+        if (e.ms != 0) {
+            td += boost::posix_time::milliseconds(e.ms);
+        }
 
-                case 'M':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
+        return td;
+    }
 #endif
-                        ) {
-                    int maxM = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxM; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    M = std::stoi(tmp);
-                    have_M = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxM = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxM; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    M = std::stoi(tmp);
-                    have_M = true;
-                    alt = false;
-                }
+
+#ifdef X_DATETIME_WITH_ABSEIL
+    absl::Duration ToAbseilDuration() const {
+        return absl::FromChrono(ToChrono());
+    }
 #endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
 
-                case 'n':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    if (s[i] != '\n') { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
-                
-                case 'O':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    alt = true;
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    template<typename Char, typename Traits, typename Ratio_>
+    friend std::basic_ostream<Char, Traits> &operator<<(std::basic_ostream<Char, Traits> &os, const TimeDelta<Ratio_> &obj);
 
-                case 'p':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    std::string _a = LocaleData::GetAM(locale.c_str());
-                    if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                        // They match
-                        have_am = true;
-                        i += _a.length();
-                    }
-                    else {
-                        _a = LocaleData::GetPM(locale.c_str());
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            have_pm = true;
-                            i += _a.length();
-                        }
-                        else {
-                            { throw MalformedDateTime("Bad format string and/or input values"); }
-                        }
-                    }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+};
 
-                case 'P':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    std::string _a = LocaleData::GetAM(locale.c_str());
-                    std::transform(_a.begin(), _a.end(), _a.begin(),
-                        [](unsigned char c){ return std::tolower(c); });
-
-                    if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                        // They match
-                        have_am = true;
-                        i += _a.length();
-                    }
-                    else {
-                        _a = LocaleData::GetPM(locale.c_str());
-                    std::transform(_a.begin(), _a.end(), _a.begin(),
-                        [](unsigned char c){ return std::tolower(c); });
-
-                        if (!strncmp(s.data()+i, _a.data(), _a.length())) {
-                            // They match
-                            have_pm = true;
-                            i += _a.length();
-                        }
-                        else {
-                            { throw MalformedDateTime("Bad format string and/or input values"); }
-                        }
-                    }
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
 
-                case 'r':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetTime12Format(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Days(long long a) {
+    return TimeDelta<Ratio>(a, 0, 0, 0, 0);
+}
 
-                case 'R':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetTime24Format(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Hours(long long a) {
+    return TimeDelta<Ratio>(0, a, 0, 0, 0);
+}
 
-                case 's':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    std::string tmp;
-                    for (int j = 0 ; /* true */; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    ssepoch = std::stoll(tmp);
-                    have_ssepoch = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxS = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxS; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    ssepoch = std::stoll(tmp);
-                    have_ssepoch = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Minutes(long long a) {
+    return TimeDelta<Ratio>(0, 0, a, 0, 0);
+}
 
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Seconds(long long a) {
+    return TimeDelta<Ratio>(0, 0, 0, a, 0);
+}
 
-                case 'S':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxS = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxS; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    S = std::stoi(tmp);
-                    have_S = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxS = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxS; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    S = std::stoi(tmp);
-                    have_S = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Milliseconds(long long a) {
+    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000);
+}
 
-                case 't':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    if (s[i] != '\t') { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Microseconds(long long a) {
+    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000000);
+}
 
-                case 'T':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = "%H:%M:%S";
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template<typename Ratio = std::nano>
+inline static TimeDelta<Ratio> Nanoseconds(long long a) {
+    return TimeDelta<Ratio>(0, 0, 0, 0, a*Ratio::den/1000000000);
+}
 
-                case 'u':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxu = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxu; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    u = std::stoi(tmp);
-                    have_u = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxu = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxu; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    u = std::stoi(tmp);
-                    if (u == 0)
-                        u = 7;
-                    have_u = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+// Calculates the offset of Clock2 relative to Clock1, in seconds.
+// Assumes the fractional seconds part of the epoches for Clock1 and Clock2 are both zero.
+template <typename Clock1, typename Clock2>
+long long ClockOffset() {
+        auto now1clock = Clock1::now();
+        auto now2clock = Clock2::now();
 
-                case 'U':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxU = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxU; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    U = std::stoi(tmp);
-                    have_U = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxU = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxU; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    U = std::stoi(tmp);
-                    have_U = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+        // We have no idea at what second the template clock starts on. But this method works on an important
+        // assumption: that the fractional seconds part of both clocks' epoch are zero.
+        std::chrono::duration<long long, std::milli> now1 = std::chrono::duration_cast<std::chrono::milliseconds>(now1clock.time_since_epoch());
+        std::chrono::duration<long long, std::milli> now2 = std::chrono::duration_cast<std::chrono::milliseconds>(now2clock.time_since_epoch());
 
-                case 'V':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxV = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxV; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    V = std::stoi(tmp);
-                    have_V = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxV = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxV; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    V = std::stoi(tmp);
-                    have_V = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+        long long dur1 = static_cast<long long>(now1.count());
+        long long dur2 = static_cast<long long>(now2.count());
 
-                case 'w':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxu = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxu; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    u = std::stoi(tmp);
-                    have_u = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxu = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxu; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    u = std::stoi(tmp);
-                    have_u = true;
-                    alt = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+        if (dur1 % 1000 > dur2 % 1000) {
+            // The clock's second hand changed in between libc calls. 
+            // Increase the second hand.
+            dur1 += 1000;
+        }
 
+        // Convert to seconds (truncating division)
+        dur1 /= 1000;
+        dur2 /= 1000;
 
-                case 'W':
-                if (era) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int maxW = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxW; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    W = std::stoi(tmp);
-                    have_W = true;
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int maxW = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxW; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    W = std::stoi(tmp);
-                    have_W = true;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+        // Calculate the number of seconds we must add to the time_point to align with "dur2"'s epoch.
+        long long offset = dur2 - dur1;
+        return offset;
+}
 
-                case 'x':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format || era) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetDateFormat(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+// Offset of Clock's epoch from the Unix epoch, in seconds.
+// ClockOffset() reads both clocks, so for an arbitrary Clock it is measured once on first
+// use and cached. system_clock counts from the Unix epoch, so that offset is known at compile time.
+template <typename Clock>
+struct UnixEpochOffset {
+    static long long Get() {
+        static const long long offset = ClockOffset<std::chrono::system_clock, Clock>();
+        return offset;
+    }
+};
 
-                case 'X':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format || era) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetTime24Format(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template <>
+struct UnixEpochOffset<std::chrono::system_clock> {
+    static constexpr long long Get() { return 0; }
+};
 
-                case 'y':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    int maxy = 2;
-                    std::string tmp;
-                    for (int j = 0 ; j < maxy; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    y = std::stoi(tmp);
-                    have_y = true;
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    int maxy = 2;
-                    std::string tmp;
-                    for (int j = 0; j < maxy; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    y = std::stoi(tmp);
-                    have_y = true;
-                    era = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
 
-                case 'Y':
-                if (alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    std::string tmp;
-                    for (int j = 0 ; /* true */; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmp += s[i];
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    Y = std::stoi(tmp);
-                    have_Y = true;
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    std::string tmp;
-                    for (int j = 0; /* true */; ++j, ++i) {
-                        int altdig = LocaleData::GetReverseAltDigit(locale.c_str(), &s[i]);
-                       if (altdig != -1) tmp += (char) (altdig + '0');
-                       else break;
-                    }
-                    if (tmp.empty()) { throw MalformedDateTime("Bad input value"); }
-                    Y = std::stoi(tmp);
-                    have_Y = true;
-                    era = false;
-                }
-#endif
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+template <typename Calendar = GregorianCalendar, typename Clock = std::chrono::system_clock,
+         typename Period = typename std::chrono::time_point<Clock>::period>
+class DateTime {
+private:
+    // DateTime is kept trivially copyable and no larger than 16 bytes, so that it can be
+    // stored in bulk and copied with memcpy. Don't add members with non-trivial copies here.
+    long long ticks; // number of Periods since the Unix epoch, in the zone's local time.
+    TimezoneId tz; // handle into the TimezoneRegistry
+    // Whether a local time which happens twice is the first of the two. Set by
+    // ToTimeZone(), which knows the instant; everything else takes the later one.
+    bool earlier = false;
+    using time_point = typename std::chrono::time_point<Clock>;
+    using clock_duration = typename time_point::duration;
+    typedef typename time_point::period ClockPeriod;
+
+    void assertValidPeriod() {
+        if (ClockPeriod::den < Period::den) {
+            throw MalformedDateTime("Specified duration must not be more granular than clock's duration)");
+        }
+    }
 
-                case 'z':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    int maxzpart = 2;
-                    std::string tmphh, tmpmm;
-                    int sign = 1;
-                    if (s[i] == '+') sign = 1;
-                    else if (s[i] == '-') sign = -1;
-                    else { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                    for (int j = 0 ; j < maxzpart; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmphh += s[i];
-                       else break;
-                    }
-                    for (int j = 0 ; j < maxzpart; ++j, ++i) {
-                       if (s[i] >= '0' && s[i] <= '9') tmpmm += s[i];
-                       else break;
-                    }
-                    if (tmphh.empty() || tmpmm.empty()) { throw MalformedDateTime("Bad input value"); }
-                    zhh = std::stoi(tmphh) * sign;
-                    zmm = std::stoi(tmpmm);
-                    have_z = true;
-                    format = false;
-                    alt = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    static TimezoneId InternZone(const Timezone& zone) {
+        return TimezoneRegistry::getInstance().Intern(zone);
+    }
 
-                case 'Z':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    for (zname = ""; isupper(s[i]); ++i) {
-                        zname += s[i];
-                    }
-                    have_Z = true;
-                    format = false;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    // Whole seconds, days and leftover ticks since the epoch, rounded towards the past.
+    long long SecondsSinceEpoch() const { return Calendar::FloorDiv(ticks, Period::den); }
+    long long DaysSinceEpoch() const { return Calendar::FloorDiv(ticks, Period::den * Calendar::SecondsPerDay); }
+    long long SecondOfDay() const { return SecondsSinceEpoch() - DaysSinceEpoch() * Calendar::SecondsPerDay; }
+    long long FractionalTicks() const { return ticks - SecondsSinceEpoch() * Period::den; }
 
-                case '+':
-                if (era || alt) { throw MalformedDateTime("Bad format string and/or input values"); }
-                if (format) {
-                    old_format = this_format;
-                    old_ci = ci + 1; // also advance old ptr to next char
-                    this_format = LocaleData::GetDate1Format(locale.c_str());
-                    ci = 0;
-                    format = false;
-                    era = false;
-                    goto nested_junction;
-                }
-                else {
-                    if (s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                    ++i;
-                }
-                break;
+    // What holds in the zone at this local time. Each thread remembers the interval
+    // of its last lookup, so a run of nearby times doesn't search every time.
+    ZoneTransitions::Info LocalInfo() const {
+        static thread_local ZoneTransitions::Hint hint;
+        if (earlier) return TZTransitions(tz).AtLocalFirst(SecondsSinceEpoch());
+        return TZTransitions(tz).AtLocal(SecondsSinceEpoch(), hint);
+    }
 
-                default:
-                if (format || s[i] != c) { throw MalformedDateTime("Bad format string and/or input values"); }
-                ++i;
+    template <typename Sink>
+    static void AppendText(Sink& out, const std::string& s) {
+        out.Append(s.data(), s.size());
+    }
 
-            }
-        }
+    // Prints v with at least op.width digits, and a leading '-' when negative.
+    template <typename Sink>
+    static void AppendNumber(Sink& out, long long v, const FormatOp& op, const FormatPlan& plan) {
+        char digits[20];
+        int n = 0;
+        unsigned long long u = (v < 0) ? 0ULL - static_cast<unsigned long long>(v) : static_cast<unsigned long long>(v);
+        do {
+            digits[n++] = static_cast<char>('0' + u % 10);
+            u /= 10;
+        } while (u > 0);
 
-        if (old_ci != -1) {
-            ci = old_ci;
-            this_format = old_format;
-            old_ci = -1;
-            old_format = "";
-            goto nested_junction;
+        if (!op.alt) {
+            char buf[48];
+            int len = 0;
+            if (v < 0) buf[len++] = '-';
+            for (int i = n; i < op.width; ++i) buf[len++] = op.pad;
+            while (n > 0) buf[len++] = digits[--n];
+            out.Append(buf, static_cast<size_t>(len));
+            return;
         }
-
-        if (i != s.length()) {
-            throw MalformedDateTime("Trailing characters are not allowed");
+        if (v < 0) out.Append("-", 1);
+        for (int i = n; i < op.width; ++i) {
+            if (op.pad == ' ') out.Append(" ", 1);
+            else AppendText(out, plan.alt_digits[0]);
         }
-
+        while (n > 0) AppendText(out, plan.alt_digits[digits[--n] - '0']);
+    }
+
+    // Prints a UTC offset in seconds as +hhmm.
+    template <typename Sink>
+    static void AppendOffset(Sink& out, int gmtoff) {
+        int minutes = gmtoff / 60;
+        char buf[5];
+        buf[0] = (minutes < 0) ? '-' : '+';
+        if (minutes < 0) minutes = -minutes;
+        int hh = minutes / 60 % 100;
+        int mm = minutes % 60;
+        buf[1] = static_cast<char>('0' + hh / 10);
+        buf[2] = static_cast<char>('0' + hh % 10);
+        buf[3] = static_cast<char>('0' + mm / 10);
+        buf[4] = static_cast<char>('0' + mm % 10);
+        out.Append(buf, 5);
+    }
+
+    // Combines the fields read by a ParsePlan into *this. The fields go straight to a
+    // tick count through the calendar arithmetic, without building intermediate
+    // DateTimes, and fields which are out of range are rejected with BadValue.
+    // If known_days is given, it is used instead of the date fields.
+    ParseError FromFields(const ParsedFields& f, const long long* known_days = NULL) {
         // PRECEDENCE RULES:
         // Z before z
         // s before anything else - if s is present, then check for ms/us/ns and
@@ -2919,158 +3893,736 @@ nested_junction:
         // or j were specified.
         // For the time components of the date, default to zero if not present.
         
-        Timezone zone;
-        if (have_z) {
-            zone = Timezone(Timezone::CalcOffset(zhh, zmm), zhh, zmm);
-        }
-        else if (have_Z) {
-            zone = TZ(zname);
+        TimezoneId zone = UTC_TimezoneId;
+        if (f.have_z) {
+            if (f.zhh < -23 || f.zhh > 23 || f.zmm < -59 || f.zmm > 59) {
+                return ParseError::BadValue;
+            }
+            zone = OffsetZone(static_cast<int>(f.zhh * 3600 + f.zmm * 60));
         }
-        else {
-            zone = UTC_Timezone().tz;
+        else if (f.have_Z) {
+            if (f.zone != 0) {
+                zone = static_cast<TimezoneId>(f.zone - 1);
+            }
+            else if (!TimezoneRegistry::getInstance().Find(std::string(f.zname, f.zname_length), zone)) {
+                return ParseError::UnknownTimezone;
+            }
         }
 
-        // all datetimes are initialized to the clock's epoch.
-        DateTime<Calendar, Clock, Period> dt(zone);
-
-        if (have_ssepoch) {
-            dt.AddSeconds(ssepoch);
+        // The fraction of the second, in nanoseconds. The widths of %1, %2 and %3 keep it below a second.
+        long long fraction = 0;
+        if (f.have_ms) {
+            fraction = f.ms * 1000000;
+        }
+        else if (f.have_us) {
+            fraction = f.us * 1000;
+        }
+        else if (f.have_ns) {
+            fraction = f.ns;
+        }
 
-            if (have_ms) {
-                dt.AddMilliseconds(ms);
+        long long seconds;
+        if (f.have_epoch) {
+            seconds = f.epoch;
+        }
+        else {
+            long long days;
+            if (known_days != NULL) {
+                days = *known_days;
             }
-
-            else if (have_us) {
-                dt.AddMicroseconds(us);
+            else {
+                ParseError err = DaysFromFields(f, days);
+                if (err != ParseError::None) return err;
             }
 
-            else if (have_ns) {
-                dt.AddNanoseconds(us);
+            // Time-based units like hour, minute, etc. start at zero.
+            // Just assume AM for %I and %l if neither am or pm is set.
+            long long hour = 0;
+            if (f.have_H || (!f.have_I && f.have_k)) {
+                hour = f.have_H ? f.H : f.k;
+                if (hour > 23) return ParseError::BadValue;
             }
+            else if (f.have_I || f.have_l) {
+                hour = f.have_I ? f.I : f.l;
+                if (hour < 1 || hour > 12) return ParseError::BadValue;
+                hour = hour % 12 + (f.have_pm ? 12 : 0);
+            }
+            const long long minute = f.have_M ? f.M : 0;
+            const long long second = f.have_S ? f.S : 0;
+            // A leap second carries over into the next minute.
+            if (minute > 59 || second > 60) {
+                return ParseError::BadValue;
+            }
+            seconds = days * Calendar::SecondsPerDay + hour * 3600 + minute * 60 + second;
+        }
 
-            *this = dt;
-            return;
+        if (seconds > LLONG_MAX / Period::den - 1 || seconds < LLONG_MIN / Period::den + 1) {
+            return ParseError::BadValue;
+        }
+        ticks = seconds * Period::den + fraction * Period::den / 1000000000LL;
+        tz = zone;
+        earlier = false;
+        return ParseError::None;
+    }
+
+    // The day (since the epoch) named by the date fields, following the precedence
+    // rules in FromFields().
+    static ParseError DaysFromFields(const ParsedFields& f, long long& days) {
+        // A missing year leaves the date at the epoch.
+        long long year = 1970;
+        if (f.have_Y) {
+            year = f.Y;
+        }
+        else if (f.have_y) {
+            year = f.have_C ? f.C + f.y : TwoDigitYear(f.y);
+        }
+        else if (f.have_G) {
+            year = f.G;
+        }
+        else if (f.have_g) {
+            year = f.have_C ? f.C + f.g : TwoDigitYear(f.g);
         }
 
-        if (have_Y) {
-            dt.AddYears(Y - 1970);
+        const long long jan1 = Calendar::DaysFromCivil(year, 1, 1);
+        days = jan1;
+        if (f.have_m) {
+            // Start the day at 1 if it isn't given.
+            const long long d = f.have_d ? f.d : f.have_e ? f.e : 1;
+            if (f.m < 1 || f.m > 12 || d < 1 || d > Calendar::DaysInMonth(year, static_cast<int>(f.m))) {
+                return ParseError::BadValue;
+            }
+            days = Calendar::DaysFromCivil(year, static_cast<int>(f.m), static_cast<int>(d));
         }
-        else if (have_y) {
-            if (have_C) {
-                dt.AddYears(C + y);
+        else if (f.have_V || f.have_U || f.have_W) {
+            // %u counts from 1 = Sunday, the same as DayOfWeek(). Without it, take
+            // the first day of the week.
+            if (f.have_u && (f.u < 1 || f.u > 7)) {
+                return ParseError::BadValue;
+            }
+            const long long sunday_based = f.have_u ? f.u - 1 : 0;
+            const long long monday_based = f.have_u ? (f.u + 5) % 7 : 0;
+            const long long jan1_wday = Calendar::WeekdayFromDays(jan1);
+            if (f.have_V) {
+                // ISO week 1 is the week (starting on Monday) with January 4th in it.
+                if (f.V < 1 || f.V > 53) return ParseError::BadValue;
+                const long long week1 = jan1 + 3 - (jan1_wday + 2) % 7;
+                days = week1 + (f.V - 1) * 7 + monday_based;
+            }
+            else if (f.have_U) {
+                // Week 1 starts on the first Sunday; the days before it are in week 0.
+                if (f.U > 53) return ParseError::BadValue;
+                const long long week1 = jan1 + (7 - jan1_wday) % 7;
+                days = week1 + (f.U - 1) * 7 + sunday_based;
             }
             else {
-                if (X_DATETIME_2_YEAR_START % 100 > y) {
-                    y += 100;
-                }
-                y += X_DATETIME_2_YEAR_START / 100 * 100;
-                dt.AddYears(y - 1970);
+                // The same, starting on the first Monday.
+                if (f.W > 53) return ParseError::BadValue;
+                const long long week1 = jan1 + (8 - jan1_wday) % 7;
+                days = week1 + (f.W - 1) * 7 + monday_based;
             }
         }
-        else if (have_G) {
-            dt.AddYears(G);
+        else if (f.have_doy) {
+            if (f.doy < 1 || f.doy > (Calendar::IsLeap(year) ? 366 : 365)) {
+                return ParseError::BadValue;
+            }
+            days = jan1 + f.doy - 1;
+        }
+
+        return ParseError::None;
+    }
+
+    // Behind the TryFromChars() overloads with a ParseContext. Without consumed, all
+    // of [first, last) has to match.
+    ParseError ParseWithContext(const char* first, const char* last, const ParsePlan& plan, ParseContext& ctx,
+            size_t* consumed) {
+        const size_t prefix = plan.DatePrefix();
+        if (prefix == 0 || first == last) {
+            return consumed ? TryFromChars(first, last, plan, *consumed) : TryFromChars(first, last, plan);
         }
-        else if (have_g) {
-            if (have_C) {
-                dt.AddYears(C + g);
+        long long days;
+        ParsedFields f = ParsedFields();
+        if (ctx.Match(&plan, first, last, days)) {
+            const char* p = first + ctx.Length();
+            if (plan.Scan(p, last, f, prefix, plan.Size()) == ParseError::None && (consumed || p == last)) {
+                if (consumed != NULL) {
+                    *consumed = static_cast<size_t>(p - first);
+                }
+                return FromFields(f, &days);
             }
-            else {
-                if (X_DATETIME_2_YEAR_START % 100 > g) {
-                    g += 100;
+            // Let the full parse report the error.
+            f = ParsedFields();
+        }
+        const char* p = first;
+        ParseError err = plan.Scan(p, last, f, 0, prefix);
+        const char* date_end = p;
+        if (err == ParseError::None) {
+            err = plan.Scan(p, last, f, prefix, plan.Size());
+        }
+        if (consumed != NULL) {
+            *consumed = static_cast<size_t>(p - first);
+        }
+        if (err != ParseError::None) {
+            return err;
+        }
+        if (consumed == NULL && p != last) {
+            return ParseError::TrailingCharacters;
+        }
+        err = DaysFromFields(f, days);
+        if (err != ParseError::None) {
+            return err;
+        }
+        ctx.Remember(&plan, first, date_end, last, days);
+        return FromFields(f, &days);
+    }
+
+    // Behind the TryFromISO8601() overloads. Without consumed, all of [first, last)
+    // has to match. *this is only written on success.
+    ParseError ParseISO8601(const char* first, const char* last, size_t* consumed, ParseContext* ctx) {
+        const char* p = first;
+        ISO8601Fields f;
+        long long days;
+        ParseError err;
+        if (ctx != NULL && ctx->Match(ISO8601Parser::ContextKey(), first, last, days)) {
+            err = ISO8601Parser::ScanTime(p, last, f);
+        }
+        else {
+            err = ISO8601Parser::Scan(p, last, f);
+            if (err == ParseError::None) {
+                days = Calendar::DaysFromCivil(f.year, f.month, f.day);
+                if (ctx != NULL) {
+                    ctx->Remember(ISO8601Parser::ContextKey(), first, first + ISO8601Parser::DateLength, last, days);
                 }
-                g += X_DATETIME_2_YEAR_START / 100 * 100;
-                dt.AddYears(g - 1970);
             }
-            dt.AddYears(g);
         }
-        // Else just leave it at epoch
+        if (consumed != NULL) {
+            *consumed = static_cast<size_t>(p - first);
+        }
+        if (err != ParseError::None) {
+            return err;
+        }
+        if (consumed == NULL && p != last) {
+            return ParseError::TrailingCharacters;
+        }
+        const long long seconds = days * Calendar::SecondsPerDay + f.hour * 3600 + f.minute * 60 + f.second;
+        if (seconds > LLONG_MAX / Period::den - 1 || seconds < LLONG_MIN / Period::den + 1) {
+            return ParseError::BadValue;
+        }
+        tz = (f.offset == 0) ? UTC_TimezoneId : OffsetZone(f.offset);
+        ticks = seconds * Period::den + static_cast<long long>(f.nanosecond) * Period::den / 1000000000LL;
+        earlier = false;
+        return ParseError::None;
+    }
+
+    // A two digit year, counted from X_DATETIME_2_YEAR_START.
+    static long long TwoDigitYear(long long y) {
+        if (X_DATETIME_2_YEAR_START % 100 > y) {
+            y += 100;
+        }
+        return y + X_DATETIME_2_YEAR_START / 100 * 100;
+    }
+
+    // The zone for a UTC offset in seconds, named like the built-in "UTC+5:30" zones.
+    // Offsets of whole minutes below a day are remembered, so that parsing many
+    // timestamps with the same offset doesn't look the name up every time. Other
+    // threads may take the handle from there, so it is published with release.
+    static TimezoneId OffsetZone(int gmtoff) {
+        static std::atomic<unsigned> known[2 * 24 * 60]; // handle + 1, or 0
+        const bool cacheable = gmtoff % 60 == 0 && gmtoff > -86400 && gmtoff < 86400;
+        const int slot = gmtoff / 60 + 24 * 60;
+        if (cacheable) {
+            unsigned id = known[slot].load(std::memory_order_acquire);
+            if (id != 0) return static_cast<TimezoneId>(id - 1);
+        }
+        const int hours = gmtoff / 3600;
+        const int minutes = gmtoff / 60 % 60;
+        std::string name = Timezone::CalcOffset(hours, minutes < 0 ? -minutes : minutes);
+        // CalcOffset() takes the sign from the hours, which are 0 below an hour.
+        if (gmtoff < 0 && hours == 0) name[3] = '-';
+        TimezoneId zone;
+        if (!TimezoneRegistry::getInstance().Find(name, zone) || TZ(zone).gmtoff[0] != gmtoff) {
+            zone = InternZone(Timezone(name, hours, minutes));
+        }
+        if (cacheable) known[slot].store(zone + 1u, std::memory_order_release);
+        return zone;
+    }
+
+    // The part of ParseMany() which doesn't depend on the parser. A first pass counts the
+    // rows of each chunk, so that each chunk knows where its rows go in out_ticks, and a
+    // second one parses them. Failed rows are collected per chunk and only put into the
+    // bitmap at the end, since chunks can share a word of it.
+    template <typename Parse>
+    static ParseManyResult ParseRows(const char* buf, size_t len, char delim, long long* out_ticks,
+            size_t capacity, uint64_t* errors, const ParseManyOptions& options, Parse parse) {
+        std::unique_ptr<ThreadPool> own_pool;
+        ThreadPool* pool = options.pool;
+        size_t threads = pool ? pool->Size() : (options.threads ? options.threads : std::thread::hardware_concurrency());
+        const size_t min_chunk = options.min_chunk_size ? options.min_chunk_size : 1;
+        size_t chunks = std::max<size_t>(1, std::min<size_t>(threads * 4, len / min_chunk));
+        if (chunks > 1 && pool == NULL) {
+            own_pool.reset(new ThreadPool(static_cast<unsigned>(std::min(threads, chunks))));
+            pool = own_pool.get();
+        }
 
-        if (have_m) {
-            dt.AddMonths(m-1);
-            if (have_d) {
-                dt.AddDays(d-1);
+        // Chunk k is [bounds[k], bounds[k + 1]); every chunk but the last ends just after a delimiter.
+        std::vector<size_t> bounds(chunks + 1, len);
+        bounds[0] = 0;
+        for (size_t k = 1; k < chunks; ++k) {
+            size_t at = std::max(bounds[k - 1], len / chunks * k);
+            const void* d = (at < len) ? memchr(buf + at, delim, len - at) : NULL;
+            bounds[k] = d ? static_cast<const char*>(d) - buf + 1 : len;
+        }
+
+        std::vector<size_t> first_row(chunks + 1, 0);
+        std::vector<std::vector<size_t> > failed(chunks);
+        auto count = [&](size_t k) {
+            const char* p = buf + bounds[k];
+            const char* end = buf + bounds[k + 1];
+            size_t n = (p != end && end[-1] != delim) ? 1 : 0;
+            while ((p = static_cast<const char*>(memchr(p, delim, end - p))) != NULL) {
+                ++n;
+                ++p;
             }
-            else if (have_e) {
-                dt.AddDays(e-1);
+            first_row[k + 1] = n;
+        };
+        auto parse_chunk = [&](size_t k) {
+            const char* p = buf + bounds[k];
+            const char* end = buf + bounds[k + 1];
+            ParseContext ctx;
+            for (size_t row = first_row[k]; p != end && row < capacity; ++row) {
+                const char* eol = static_cast<const char*>(memchr(p, delim, end - p));
+                const char* last = eol ? eol : end;
+                if (delim == '\n' && last != p && last[-1] == '\r') --last;
+                DateTime dt;
+                if (last != p && parse(dt, p, last, ctx) == ParseError::None) {
+                    out_ticks[row] = dt.UTCTicks();
+                }
+                else {
+                    out_ticks[row] = 0;
+                    failed[k].push_back(row);
+                }
+                p = eol ? eol + 1 : end;
             }
-            // Else just start the day at 1
+        };
+
+        if (chunks == 1) {
+            count(0);
+        }
+        else {
+            pool->Run(chunks, count);
+        }
+        for (size_t k = 0; k < chunks; ++k) {
+            first_row[k + 1] += first_row[k];
+        }
+        if (chunks == 1) {
+            parse_chunk(0);
+        }
+        else {
+            pool->Run(chunks, parse_chunk);
         }
-        else if (have_V) {
-            // find the day of the first ISO week.
-            // This means we look for the first sunday.
-            int _d = 1;
-            for (; DateTime::DayOfWeek(Y, 1, _d) != 0 && _d < 7; ++_d) {}
-            dt.AddDays(_d-1 + V*7 + (have_u) ? u-1 : 0 );
+
+        ParseManyResult result = {first_row[chunks], 0};
+        const size_t parsed = std::min(result.rows, capacity);
+        if (errors != NULL) {
+            std::fill(errors, errors + (parsed + 63) / 64, 0);
+        }
+        for (const std::vector<size_t>& rows: failed) {
+            result.errors += rows.size();
+            if (errors == NULL) continue;
+            for (size_t row: rows) {
+                errors[row / 64] |= 1ULL << (row % 64);
+            }
         }
-        else if (have_U) {
-            // find the day of the first Sunday week.
-            int _d = 1;
-            for (; DateTime::DayOfWeek(Y, 1, _d) != 0 && _d < 7; ++_d) {}
-            dt.AddDays(_d-1 + U*7 + (have_u) ? u-1 : 0 );
+        return result;
+    }
+
+    // Number of seconds this clock differs from Unix time. (0 for system_clock)
+    static long long UnixOffset() {
+        return UnixEpochOffset<Clock>::Get();
+    }
+
+public:
+    // Every constructor which takes a TimezoneId also has an overload taking a Timezone.
+    // The Timezone overloads have to intern the zone in the TimezoneRegistry first, so
+    // resolve the handle once with TZId() if you are constructing many DateTimes.
+    DateTime(TimezoneId zone = UTC_TimezoneId)
+        : ticks(0), tz(zone) {
+        assertValidPeriod();
+    }
+    DateTime(const Timezone& zone) : DateTime(InternZone(zone)) {}
+
+    explicit DateTime(time_t t, TimezoneId zone = UTC_TimezoneId)
+        : ticks(static_cast<long long>(t) * Period::den), tz(zone) {
+        assertValidPeriod();
+    }
+    DateTime(time_t t, const Timezone& zone) : DateTime(t, InternZone(zone)) {}
+    // The fields of tm are taken as they are, and are not converted from the process's local time.
+    DateTime(struct tm *tm)
+        : DateTime(static_cast<time_t>(Calendar::SecondsFromCivil(tm->tm_year + 1900LL, tm->tm_mon + 1LL,
+                        tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec))) {}
+
+    // 00:00 UTC+0
+    DateTime(int y, int m, int d, const Timezone& zone) : DateTime(y, m, d, InternZone(zone)) {}
+    DateTime(int y, int m, int d, TimezoneId zone = UTC_TimezoneId)
+        : tz(zone) {
+        assertValidPeriod();
+        ticks = Calendar::SecondsFromCivil(y, m, d, 0, 0, 0) * Period::den;
+    }
+
+    DateTime(int y, int m, int d, int H, int M, int S, const Timezone& zone)
+    : DateTime(y, m, d, H, M, S, InternZone(zone)) {}
+    DateTime(int y, int m, int d, int H, int M, int S, TimezoneId zone = UTC_TimezoneId)
+    : tz(zone) {
+        assertValidPeriod();
+        ticks = Calendar::SecondsFromCivil(y, m, d, H, M, S) * Period::den;
+    }
+
+    DateTime(int y, int m, int d, int H, int M, int S, int FS, const Timezone& zone)
+    : DateTime(y, m, d, H, M, S, FS, InternZone(zone)) {}
+    DateTime(int y, int m, int d, int H, int M, int S, int FS, TimezoneId zone = UTC_TimezoneId)
+    : tz(zone) {
+        assertValidPeriod();
+        ticks = Calendar::SecondsFromCivil(y, m, d, H, M, S) * Period::den + FS;
+    }
+
+    explicit DateTime(const std::string &s, const std::string &locale = "C")
+        : ticks(0), tz(UTC_TimezoneId)
+    {
+        assertValidPeriod();
+        ParseError err = TryParse(s, *this, locale);
+        if (err != ParseError::None) {
+            throw MalformedDateTime(ParseErrorString(err));
         }
-        else if (have_W) {
-            // find the day of the first Monday week.
-            int _d = 1;
-            for (; DateTime::DayOfWeek(Y, 1, _d) != 1 && _d < 7; ++_d) {}
-            int _u = u-1;
-            if (_u < 0) u = 6;
-            dt.AddDays(_d-1 + U*7 + (have_u) ? u-1 : 0 );
+    }
+
+    DateTime(const std::chrono::time_point<Clock> &_tp, const Timezone& zone)
+    : DateTime(_tp, InternZone(zone)) {}
+    DateTime(const std::chrono::time_point<Clock> &_tp, TimezoneId zone = UTC_TimezoneId) :
+    tz(zone) {
+        assertValidPeriod();
+        long long count = static_cast<long long>(_tp.time_since_epoch().count());
+        long long q = count / ClockPeriod::den;
+        long long r = count % ClockPeriod::den;
+        q -= UnixOffset();
+        q *= Period::den;
+        if (Period::den > ClockPeriod::den) {
+            r *= Period::den / ClockPeriod::den;
         }
-        else if (have_doy) {
-            // Day is already at 1 and not 0 so we should not try to add the 1-based day
-            // as it is, take 1 away from that amount (applies to above logic for weekdays
-            // as well, and months, and month-days).
-            dt.AddDays(doy-1);
+        else {
+            r /= ClockPeriod::den / Period::den;
         }
+        q += r;
+        ticks = q;
+    }
+    
+    DateTime(const TimeDelta<Period> &td, const Timezone& zone)
+    : DateTime(td, InternZone(zone)) {}
+    DateTime(const TimeDelta<Period> &td, TimezoneId zone = UTC_TimezoneId)
+    : tz(zone) {
+        assertValidPeriod();
+        // TimeDelta is always relative to system_clock.
+        ticks = std::chrono::duration_cast<std::chrono::duration<long long, Period>>(
+                std::chrono::system_clock::now().time_since_epoch()).count() + td.d.count();
+    }
 
-        // Time-based units like hour, minute, etc. start at zero.
-        if (have_H) {
-            dt.AddHours(H);
+#ifdef X_DATETIME_WITH_BOOST
+    DateTime(const boost::posix_time::ptime& p)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        auto date = p.date();
+        auto tod = p.time_of_day();
+        int FS = 0;
+#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
+        if (Ratio::den > 1000000) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (tod.total_nanoseconds() % 1000000000) /
+                        (Period::den / 1000000000.0)) % 1000000000);
+        }
+#else
+        if (false) {}
+#endif
+        else if (Period::den > 1000) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (tod.total_microseconds() % 1000000) /
+                        (Period::den / 1000000.0)) % 1000000);
         }
-        else if (have_I) {
-            // Just assume AM if neither am or pm is set.
-            // no need to test for have_am in this context
-            // - it's implied in the 'else' condition.
-            if (I == 12) I = 0;
-            dt.AddHours(I + (have_pm) ? 12 : 0);
+        else if (Period::den > 1) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (tod.total_milliseconds() % 1000) /
+                        (Period::den / 1000.0)) % 1000);
         }
-        else if (have_k) {
-            dt.AddHours(k);
+        *this = DateTime(static_cast<int>(date.year()),
+                static_cast<int>(date.month()),
+                static_cast<int>(date.day()),
+                static_cast<int>(tod.hours()),
+                static_cast<int>(tod.minutes()),
+                static_cast<int>(tod.seconds()), FS);
+    }
+#endif /* X_DATETIME_WITH_BOOST */
+
+#ifdef X_DATETIME_WITH_ABSEIL
+    DateTime(const absl::CivilSecond& civ)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        *this = DateTime(civ.year(), civ.month(), civ.day(),
+                civ.hour(), civ.minute(), civ.second(), 0);
+    }
+
+    DateTime(const absl::CivilMinute& civ)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        *this = DateTime(civ.year(), civ.month(), civ.day(),
+                civ.hour(), civ.minute(), 0, 0);
+    }
+
+    DateTime(const absl::CivilHour& civ)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        *this = DateTime(civ.year(), civ.month(), civ.day(),
+                civ.hour(), 0, 0, 0);
+    }
+
+    DateTime(const absl::CivilDay& civ)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        *this = DateTime(civ.year(), civ.month(), civ.day(),
+                0, 0, 0, 0);
+    }
+
+    DateTime(const absl::Time& t)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        *this = DateTime(absl::ToChronoTime(t));
+    }
+#endif /* X_DATETIME_WITH_ABSEIL */
+
+#ifdef X_DATETIME_WITH_POCO
+    DateTime(const Poco::DateTime& p)
+    : ticks(0), tz(UTC_TimezoneId) {
+        assertValidPeriod();
+        int FS = 0;
+        if (Period::den > 1000) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (p.microsecond() % 1000000) /
+                        (Period::den / 1000000.0)) % 1000000);
         }
-        else if (have_l) {
-            dt.AddHours(l + (have_pm) ? 12 : 0);
+        else if (Period::den > 1) {
+            FS = static_cast<int>(static_cast<long long>(
+                        (p.millisecond() % 1000) /
+                        (Period::den / 1000.0)) % 1000);
         }
+        *this = DateTime(p.year(), p.month(), p.day(),
+                p.hour(), p.minute(), p.second(), FS);
+    }
+#endif /* X_DATETIME_WITH_POCO */
+
+#ifdef X_DATETIME_WITH_GLIB
+    DateTime(GDateTime* datetime)
+    : ticks(0), tz(UTC_TimezoneId) {
+        *this = DateTime(static_cast<time_t>(g_date_time_to_unix(datetime)));
+        AddMicroseconds(g_date_time_get_microsecond(datetime));
+    }
+#endif /* X_DATETIME_WITH_GLIB */
+
+    // Parses input with a format compiled for a locale. On failure *this is left
+    // as it was.
+    ParseError TryFromString(const std::string& input, const std::string &fmt, const std::string& locale = "C") {
+        return TryFromString(input, ParsePlan(fmt, locale));
+    }
+
+    ParseError TryFromString(const std::string& input, const ParsePlan& plan) {
+        return TryFromChars(input.data(), input.data() + input.size(), plan);
+    }
+
+    ParseError TryFromString(const std::string& input, const ParsePlan& plan, ParseContext& ctx) {
+        return TryFromChars(input.data(), input.data() + input.size(), plan, ctx);
+    }
 
-        if (have_M) {
-            dt.AddMinutes(M);
+    // The same for the characters in [first, last), which must all be matched.
+    ParseError TryFromChars(const char* first, const char* last, const ParsePlan& plan) {
+        if (first == last) return ParseError::None;
+        const char* p = first;
+        ParsedFields f = ParsedFields();
+        ParseError err = plan.Scan(p, last, f);
+        if (err != ParseError::None) {
+            return err;
         }
-        
-        if (have_S) {
-            dt.AddSeconds(S);
+        if (p != last) {
+            return ParseError::TrailingCharacters;
         }
-        
-        if (have_ms) {
-            dt.AddMilliseconds(ms);
+        return FromFields(f);
+    }
+
+    // The same, but if the input starts with the date remembered in ctx, only the
+    // time of day after it is read (see ParseContext). Plans whose DatePrefix() is 0
+    // are always parsed in full. The result is the same as without ctx.
+    ParseError TryFromChars(const char* first, const char* last, const ParsePlan& plan, ParseContext& ctx) {
+        return ParseWithContext(first, last, plan, ctx, NULL);
+    }
+
+    // Parses the timestamp at the start of [first, last), such as one embedded
+    // in a log record, and leaves whatever follows it. consumed is set to the
+    // number of characters matched; on failure, to where matching stopped.
+    ParseError TryFromChars(const char* first, const char* last, const ParsePlan& plan, size_t& consumed) {
+        const char* p = first;
+        ParsedFields f = ParsedFields();
+        ParseError err = plan.Scan(p, last, f);
+        consumed = static_cast<size_t>(p - first);
+        if (err != ParseError::None) {
+            return err;
+        }
+        return FromFields(f);
+    }
+
+    ParseError TryFromChars(const char* first, const char* last, const ParsePlan& plan, size_t& consumed,
+            ParseContext& ctx) {
+        return ParseWithContext(first, last, plan, ctx, &consumed);
+    }
+
+    // Throwing wrappers around TryFromString.
+    void FromString(const std::string& input, const std::string &fmt, const std::string& locale = "C") {
+        FromString(input, ParsePlan(fmt, locale));
+    }
+
+    void FromString(const std::string& input, const ParsePlan& plan) {
+        ParseError err = TryFromString(input, plan);
+        if (err != ParseError::None) {
+            throw MalformedDateTime(ParseErrorString(err));
         }
+    }
+
+    // Parses input with fmt into out. out is only written on success.
+    static ParseError TryParse(const std::string& input, const std::string& fmt, DateTime& out,
+            const std::string& locale = "C") {
+        return out.TryFromString(input, fmt, locale);
+    }
+
+    static ParseError TryParse(const std::string& input, const ParsePlan& plan, DateTime& out) {
+        return out.TryFromString(input, plan);
+    }
+
+    static ParseError TryParse(const char* first, const char* last, const ParsePlan& plan, DateTime& out) {
+        return out.TryFromChars(first, last, plan);
+    }
 
-        else if (have_us) {
-            dt.AddMicroseconds(us);
+    static ParseError TryParse(const char* first, const char* last, const ParsePlan& plan, DateTime& out,
+            size_t& consumed) {
+        return out.TryFromChars(first, last, plan, consumed);
+    }
+
+    // Tries the locale's own representations first and then ISO 8601 and other
+    // common formats, stopping at the first one that matches. FormatDetector
+    // narrows these down from the shape of the input, so usually only the
+    // format that matches is parsed.
+    static ParseError TryParse(const std::string& input, DateTime& out, const std::string& locale = "C") {
+        return out.TryFromChars(input.data(), input.data() + input.size(), locale);
+    }
+
+    ParseError TryFromChars(const char* first, const char* last, const std::string& locale = "C") {
+        if (first == last) {
+            // Every format accepts an empty string and leaves *this as it is.
+            return ParseError::None;
         }
+        const FormatDetector& detector = FormatDetector::ForLocale(locale);
+        bool matched = detector.Detect(first, last,
+            [&](const ParsePlan& plan) {
+                return TryFromChars(first, last, plan) == ParseError::None;
+            });
+        return matched ? ParseError::None : ParseError::NoMatchingFormat;
+    }
+
+    // Parses an RFC 3339 / ISO 8601 timestamp such as 2021-03-04T05:06:07.123+01:00, the
+    // layout written by FormatISO8601(), with ISO8601Parser. This is much faster than
+    // a ParsePlan for the same layout. A timestamp without an offset is taken as UTC.
+    ParseError TryFromISO8601(const std::string& input) {
+        return ParseISO8601(input.data(), input.data() + input.size(), NULL, NULL);
+    }
+
+    ParseError TryFromISO8601(const char* first, const char* last) {
+        return ParseISO8601(first, last, NULL, NULL);
+    }
+
+    // Like TryFromChars(first, last, plan, consumed), leaves whatever follows the timestamp.
+    ParseError TryFromISO8601(const char* first, const char* last, size_t& consumed) {
+        return ParseISO8601(first, last, &consumed, NULL);
+    }
+
+    // With a ParseContext, a timestamp on the same date as the last one only has its
+    // time of day read.
+    ParseError TryFromISO8601(const std::string& input, ParseContext& ctx) {
+        return ParseISO8601(input.data(), input.data() + input.size(), NULL, &ctx);
+    }
+
+    ParseError TryFromISO8601(const char* first, const char* last, ParseContext& ctx) {
+        return ParseISO8601(first, last, NULL, &ctx);
+    }
+
+    ParseError TryFromISO8601(const char* first, const char* last, size_t& consumed, ParseContext& ctx) {
+        return ParseISO8601(first, last, &consumed, &ctx);
+    }
 
-        else if (have_ns) {
-            dt.AddNanoseconds(us);
+    void FromISO8601(const std::string& input) {
+        ParseError err = TryFromISO8601(input);
+        if (err != ParseError::None) {
+            throw MalformedDateTime(ParseErrorString(err));
         }
+    }
 
-        *this = dt;
+#if __cplusplus >= 201703L
+    // The const char* overloads keep string literals from being ambiguous
+    // between std::string and std::string_view.
+    static ParseError TryParse(std::string_view input, const std::string& fmt, DateTime& out,
+            const std::string& locale = "C") {
+        return TryParse(input, ParsePlan(fmt, locale), out);
+    }
+    static ParseError TryParse(const char* input, const std::string& fmt, DateTime& out,
+            const std::string& locale = "C") {
+        return TryParse(std::string_view(input), fmt, out, locale);
+    }
+    static ParseError TryParse(std::string_view input, const ParsePlan& plan, DateTime& out) {
+        return out.TryFromChars(input.data(), input.data() + input.size(), plan);
+    }
+    static ParseError TryParse(const char* input, const ParsePlan& plan, DateTime& out) {
+        return TryParse(std::string_view(input), plan, out);
+    }
+    static ParseError TryParse(std::string_view input, const ParsePlan& plan, DateTime& out, size_t& consumed) {
+        return out.TryFromChars(input.data(), input.data() + input.size(), plan, consumed);
+    }
+    static ParseError TryParse(std::string_view input, DateTime& out, const std::string& locale = "C") {
+        return out.TryFromChars(input.data(), input.data() + input.size(), locale);
+    }
+    static ParseError TryParse(const char* input, DateTime& out, const std::string& locale = "C") {
+        return TryParse(std::string_view(input), out, locale);
     }
+#endif
 
-    DateTime &operator=(const DateTime<Calendar, Clock, Period> &other) {
-        // Guard self assignment
-        if (this == &other)
-            return *this;
-        this->tp = other.tp;
-        this->tz = other.tz;
-        return *this;
+    // Parses a buffer of timestamps separated by delim, such as a column read from a CSV
+    // or log file, into UTC ticks (see UTCTicks()). Each row is parsed with
+    // TryFromChars(first, last, plan), except that an empty row is an error, and
+    // each chunk keeps a ParseContext for the rows in it. When
+    // delim is '\n', a '\r' ending a row is dropped, and a delimiter at the end of
+    // the buffer does not start another row.
+    //
+    // out_ticks has room for capacity rows; rows past it are counted but not parsed.
+    // If errors isn't NULL, bit i % 64 of errors[i / 64] is set for each row which
+    // failed and cleared for the others, and the tick of a failed row is 0. Large
+    // buffers are split into chunks at delimiters and parsed on several threads.
+    static ParseManyResult ParseMany(const char* buf, size_t len, char delim, const ParsePlan& plan,
+            long long* out_ticks, size_t capacity, uint64_t* errors = NULL,
+            const ParseManyOptions& options = ParseManyOptions()) {
+        return ParseRows(buf, len, delim, out_ticks, capacity, errors, options,
+            [&plan](DateTime& dt, const char* first, const char* last, ParseContext& ctx) {
+                return dt.TryFromChars(first, last, plan, ctx);
+            });
+    }
+
+    // The same with TryFromISO8601() for every row.
+    static ParseManyResult ParseManyISO8601(const char* buf, size_t len, char delim,
+            long long* out_ticks, size_t capacity, uint64_t* errors = NULL,
+            const ParseManyOptions& options = ParseManyOptions()) {
+        return ParseRows(buf, len, delim, out_ticks, capacity, errors, options,
+            [](DateTime& dt, const char* first, const char* last, ParseContext& ctx) {
+                return dt.TryFromISO8601(first, last, ctx);
+            });
     }
 
     static DateTime Now() {
@@ -3078,8 +4630,9 @@ nested_junction:
         return DateTime(now);
     }
 
+    // Number of Periods since the Unix epoch.
     long long TimeSinceEpoch() const {
-        return static_cast<long long>(tp.time_since_epoch) - unix_offset;
+        return ticks;
     };
 
     // Our epoch is always the same as Unix epoch.
@@ -3180,1303 +4733,479 @@ nested_junction:
         return (doy+offset)/7 + 1;
     }
 
-    Timezone TimeZone() const { return tz; }
-
-    int Year() const {
-        // time_t uses a 64-bit type on modern Windows (compiled with VS >= 2005),
-        // modern MacOS, modern 64-bit Linux and Unix flavors[1], and 32-bit Linux since 5.x.
-        // Some 32-bit BSD flavors are still using 32-bit time-t though, but this is the most
-        // portable solution.
-        //
-        // In other words, this should be safe from the Year 2038 problem.
-        //
-        // We only use time_t for date primitives (e.g. year, month, day, week), not time primitives
-        // such as hour, minute, second.
-        //
-        // [0] https://learn.microsoft.com/en-us/cpp/c-runtime-library/time-management?view=msvc-170
-        // [1] https://en.wikipedia.org/wiki/Year_2038_problem
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_year + 1900;
-        //TODO ideally we should be checking that the year is not zero
-        //because that is invalid in the Gregorian calendar, but people will
-        //only encounter this problem with very ancient dates, and also, such
-        //a check should be designated to a future Gregorian calendar class.
-    }
-
-    int Month() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_mon + 1; // month is zero-based
-    }
-
-    std::string MonthString(const std::string& locale = "C") const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return LocaleData::GetLongMonth(locale.c_str(), tm_.tm_mon);
-    }
-
-    std::string MonthShortString(const std::string& locale = "C") const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return LocaleData::GetShortMonth(locale.c_str(), tm_.tm_mon);
-    }
-
-    int EndOfMonthDay() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return GetDaysInMonth(tm_.tm_mon, tm_.tm_year);
-    }
-
-    int Week() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return DateTime::ISOWeek(tm_.tm_year + 1900, tm_.tm_mon + 1, tm_.tm_mday);
-    }
-
-    int Day() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_mday; // day is one-based
-    }
-
-    int DayOfWeek() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_wday + 1; // week day is zero-based
-    }
-
-    std::string DayOfWeekString(const std::string& locale = "C") const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        int first_weekday = LocaleData::GetFirstWeekday(locale.c_str());
-        return LocaleData::GetLongWeekday(locale.c_str(), (tm_.tm_wday + first_weekday - 1) % 7);
-    }
-
-    std::string DayOfWeekShortString(const std::string& locale = "C") const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        int first_weekday = LocaleData::GetFirstWeekday(locale.c_str());
-        return LocaleData::GetShortWeekday(locale.c_str(), (tm_.tm_wday + first_weekday - 1) % 7);
-    }
-
-    int DayOfYear() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return static_cast<int>(tm_.tm_yday + 1); // week day is zero-based
-    }
-
-    int Hour() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_hour;
-    }
-
-    int Minute() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_min;
-    }
-
-    int Second() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(
-                    tp.time_since_epoch().count())/Period::den - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_.tm_sec;
-    }
-
-    int Millisecond() const {
-        if (Period::den < 1000) return 0;
-        return static_cast<int>(tp.time_since_epoch().count() / (Period::den/1000) % 1000);
-    }
-
-    int Microsecond() const {
-        if (Period::den < 1000000) return 0;
-        return static_cast<int>(tp.time_since_epoch().count() / (Period::den/1000000) % 1000000);
-    }
-
-    int Nanosecond() const {
-        if (Period::den < 1000000000) return 0;
-        return static_cast<int>(tp.time_since_epoch().count() / (Period::den/1000000000) % 1000000000);
-    }
-
-    DateTime<Calendar, Clock, Period> ToUTC() const {
-        int gmtoff = tz.gmtoff[0]; // in seconds
-        DateTime d = *this;
-        d.tz = UTC_Timezone().tz;
-        d.SubSeconds(gmtoff);
-        return d;
-    }
-
-    DateTime<Calendar, Clock, Period> ToTimeZone(Timezone newtz) const {
-        int gmtoff = tz.gmtoff[0]; // in seconds
-        int newgmtoff = newtz.gmtoff[0]; // in seconds
-        DateTime d = *this;
-        d.tz = newtz;
-        // d.SubSeconds(gmtoff).AddSeconds(newgmtoff);
-        d.AddSeconds(newgmtoff - gmtoff); // Should be equivalent
-        return d;
-    }
-
-    std::string ToDateTime(const std::string& locale = "C") const {
-        std::string _format = LocaleData::GetDateTimeFormat(locale.c_str());
-        return ToString(_format);
-    }
-
-
-    // Prints the string in date(1) format.
-    std::string ToDate1(const std::string& locale = "C") const {
-        std::string _format = LocaleData::GetDate1Format(locale.c_str());
-        return ToString(_format);
-    }
-
-    // C locale uses %y, which is unsafe for old&new dates.
-    // If you want 4-digit years should use en_US or another locale.
-    std::string ToDate(const std::string& locale = "C") const {
-        std::string _format = LocaleData::GetDateFormat(locale.c_str());
-        return ToString(_format);
-    }
-
-    std::string ToTime24(const std::string& locale = "C") const {
-        std::string _format = LocaleData::GetTime24Format(locale.c_str());
-        return ToString(_format);
-    }
-
-    std::string ToTime12(const std::string& locale = "C") const {
-        std::string _format = LocaleData::GetTime12Format(locale.c_str());
-        return ToString(_format);
-    }
-    
-    // Defaults to ISO8601
-    std::string ToISO8601String() const { return ToString("%Y-%m-%dT%H:%M:%SZ%z"); }
-    std::string ToString() const { return ToISO8601String(); }
-
-    std::string toDate() const { return ToString("%Y-%m-%d"); }
-
-    // This function will throw away fractional seconds.
-    time_t ToTimeT() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(tp.time_since_epoch().count()) - unix_offset);
-        return t;
-    }
-
-    // This function will throw away fractional seconds.
-    struct tm ToTimeTM() const {
-        time_t t = static_cast<time_t>(static_cast<long long>(tp.time_since_epoch()) - unix_offset);
-        struct tm tm_;
-        gmtime_r(&t, &tm_);
-        return tm_;
-    }
-
-#ifdef X_DATETIME_WITH_BOOST
-    boost::posix_time::ptime ToBoostPTime() const {
-        boost::posix_time::ptime p = boost::posix_time::from_time_t(ToTimeT());
-#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
-        p += boost::posix_time::nanoseconds(Nanosecond());
-#else
-        p += boost::posix_time::microseconds(Microsecond());
-#endif /* BOOOST_DATE_TIME_HAS_NANOSECONDS */
-        return p;
-    }
-#endif /* X_DATETIME_WITH_BOOST */
-
-#ifdef X_DATETIME_WITH_ABSEIL
-    absl::CivilSecond ToAbseilCivilSecond() const {
-        absl::CivilSecond civ(Year(), Month(), Day(),
-                Hour(), Minute(), Second());
-        return civ;
-    }
-
-    absl::CivilMinute ToAbseilCivilMinute() const {
-        absl::CivilMinute civ(Year(), Month(), Day(),
-                Hour(), Minute());
-        return civ;
-    }
-
-    absl::CivilHour ToAbseilCivilHour() const {
-        absl::CivilHour civ(Year(), Month(), Day(), Hour());
-        return civ;
-    }
-
-    absl::CivilDay ToAbseilCivilDay() const {
-        absl::CivilDay civ(Year(), Month(), Day());
-        return civ;
-    }
-
-    absl::Time ToAbseilTime() const {
-        return absl::FromChrono(ToChrono());
-    }
-#endif /* X_DATETIME_WITH_ABSEIL */
-
-#ifdef X_DATETIME_WITH_POCO
-    Poco::DateTime ToPoco() const {
-        Poco::DateTime p(Year(), Month(), Day(),
-                Hour(), Minute(), Second(),
-                Microsecond()/1000, Microsecond() % 1000);
-        return p;
-    }
-#endif /* X_DATETIME_WITH_POCO */
-
-
-#ifdef X_DATETIME_WITH_GLIB
-    GDateTime* ToGLib() const {
-        return g_date_time_new_utc(Year(), Month(), Day(),
-                Hour(), Minute(), Second());
-    }
-#endif
-
-    std::chrono::time_point<Clock> ToChrono() const {
-        auto tp_ = tp;
-        long long count = static_cast<long long>(tp.time_since_epoch().count());
-        long long q = count / Period::den;
-        long long r = count % Period::den;
-        q -= unix_offset;
-        if (q > LLONG_MAX/ClockPeriod::den || q < LLONG_MIN/ClockPeriod::den) {
-            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
-        }
-        q *= ClockPeriod::den;
-        if (Period::den > ClockPeriod::den) {
-            r /= Period::den / ClockPeriod::den;
-        }
-        else {
-            r *= ClockPeriod::den / Period::den;
-        }
-        if (q > LLONG_MAX - r || q < LLONG_MIN + r) {
-            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
-        }
-        q += r;
-        return time_point(clock_duration(q));
-    }
-
-    // Convert a date and time to string, strictly following strftime(3) format conventions.
-    // This string is encoded at UTF8 which means that characters could take more than 1 byte.
-    // However, it is guarenteed that only the ASCII characters will use bytes 0x00 to 0x7F.
-    std::string ToString(const std::string &fmt, const std::string& locale = "C") const {
-        std::string s;
-
-
-        bool format = false; // Encountered %?
-        bool era = false; // Encountered %E?
-        bool alt = false; // Encountered %O?
-        for (char c: fmt) {
-            switch (c) {
-                case '%':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += c;
-                    format = false;
-                }
-                else {
-                    format = true;
-                }
-                break;
-
-                case '1':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int ms = Millisecond();
-                    if (ms < 100) s += "0";
-                    if (ms < 10) s += "0";
-                    s += std::to_string(ms);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int ms = Millisecond();
-                    if (ms < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ms < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), ms);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
-
-                case '2':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int us = Microsecond();
-                    if (us < 100000) s += "0";
-                    if (us < 10000) s += "0";
-                    if (us < 1000) s += "0";
-                    if (us < 100) s += "0";
-                    if (us < 10) s += "0";
-                    s += std::to_string(us);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int us = Microsecond();
-                    if (us < 100000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (us < 10000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (us < 1000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (us < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (us < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), us);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
-
-                case '3':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int ns = Nanosecond();
-                    if (ns < 100000000) s += "0";
-                    if (ns < 10000000) s += "0";
-                    if (ns < 1000000) s += "0";
-                    if (ns < 100000) s += "0";
-                    if (ns < 10000) s += "0";
-                    if (ns < 1000) s += "0";
-                    if (ns < 100) s += "0";
-                    if (ns < 10) s += "0";
-                    s += std::to_string(ns);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int ns = Nanosecond();
-                    if (ns < 100000000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 10000000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 1000000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 100000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 10000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 1000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (ns < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), ns);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
-
-                case 'a':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += DayOfWeekShortString();
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    const Timezone& TimeZone() const { return TZ(tz); }
 
+    TimezoneId TimeZoneId() const { return tz; }
 
-                case 'A':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += DayOfWeekString();
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // The date and time accessors below never go through time_t or the C library; they
+    // split the tick count with integer arithmetic and hand the day number to the Calendar.
+    // This keeps them independent of the TZ environment variable, free of the Year 2038
+    // problem, and correct for dates before 1970.
+    int Year() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return static_cast<int>(y);
+        //TODO ideally we should be checking that the year is not zero
+        //because that is invalid in the Gregorian calendar, but people will
+        //only encounter this problem with very ancient dates, and also, such
+        //a check should be designated to a future Gregorian calendar class.
+    }
 
+    int Month() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return m;
+    }
 
-                case 'b':
-                case 'h':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += MonthShortString();
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    std::string MonthString(const std::string& locale = "C") const {
+        return LocaleData::GetLongMonth(locale.c_str(), Month() - 1);
+    }
 
+    std::string MonthShortString(const std::string& locale = "C") const {
+        return LocaleData::GetShortMonth(locale.c_str(), Month() - 1);
+    }
 
-                case 'B':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += MonthString();
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
-                
-
-                case 'c':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format || era) {
-                    s += ToString(LocaleData::GetDateTimeFormat(locale.c_str()), locale);
-                    format = false;
-                    era = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    int EndOfMonthDay() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return Calendar::DaysInMonth(y, m);
+    }
 
-                case 'C':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    int year = Year() / 100;
-                    if (year < 10) s += "0";
-                    s += std::to_string(year);
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    int year = Year() / 100;
-                    if (year < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), year);
-                    era = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Week() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return DateTime::ISOWeek(static_cast<int>(y), m, d);
+    }
 
-                case 'd':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    if (day < 10) s += "0";
-                    s += std::to_string(day);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    if (day < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), day);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Day() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return d;
+    }
 
-                case 'D':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString("%m/%d/%y", locale);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    int DayOfWeek() const {
+        return Calendar::WeekdayFromDays(DaysSinceEpoch()) + 1; // week day is zero-based
+    }
 
-                case 'e':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    if (day < 10) s += " ";
-                    s += std::to_string(day);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    std::string tmp = LocaleData::GetNumber(locale.c_str(), Day());
-                    std::string cmp = LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (!strncmp(tmp.data(), cmp.data(), cmp.length())) tmp[0] = ' ';
-                    s += tmp;
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    std::string DayOfWeekString(const std::string& locale = "C") const {
+        // The locale tables always start on Sunday, whatever the locale's first weekday is.
+        int wday = Calendar::WeekdayFromDays(DaysSinceEpoch());
+        return LocaleData::GetLongWeekday(locale.c_str(), wday);
+    }
 
+    std::string DayOfWeekShortString(const std::string& locale = "C") const {
+        // The locale tables always start on Sunday, whatever the locale's first weekday is.
+        int wday = Calendar::WeekdayFromDays(DaysSinceEpoch());
+        return LocaleData::GetShortWeekday(locale.c_str(), wday);
+    }
 
-                case 'E':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                   era = true;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    int DayOfYear() const {
+        long long y;
+        int m, d;
+        Calendar::CivilFromDays(DaysSinceEpoch(), y, m, d);
+        return Calendar::DayOfYear(y, m, d);
+    }
 
-                case 'F':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString("%Y-%m-%d", locale);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    int Hour() const {
+        return static_cast<int>(SecondOfDay() / 3600);
+    }
 
-                case 'G':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day);
-                    if (week >= 52 && day < 7) {
-                        // This is January of the next year, %G wants us to
-                        // make it the previous year.
-                        --year;
-                    }
-                    s += std::to_string(year);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day);
-                    if (week >= 52 && day < 7) {
-                        // This is January of the next year, %G wants us to
-                        // make it the previous year.
-                        --year;
-                    }
-                    if (year < 0) { s += "-"; year = -year; }
-                    if (year < 1000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (year < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (year < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), year);
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Minute() const {
+        return static_cast<int>(SecondOfDay() / 60 % 60);
+    }
 
-                case 'g':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day);
-                    if (week >= 52 && day < 7) {
-                        // This is January of the next year, %G wants us to
-                        // make it the previous year.
-                        --year;
-                    }
-                    year =  year % 100;
-                    if (year < 10) s += "0";
-                    s += std::to_string(year);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day);
-                    if (week >= 52 && day < 7) {
-                        // This is January of the next year, %G wants us to
-                        // make it the previous year.
-                        --year;
-                    }
-                    year =  year % 100;
-                    if (year < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), year);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Second() const {
+        return static_cast<int>(SecondOfDay() % 60);
+    }
 
-                case 'H':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int hour = Hour();
-                    if (hour < 10) s += "0";
-                    s += std::to_string(hour);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int hour = Hour();
-                    if (hour < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), hour);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
-                
-                case 'I':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int hour = Hour() % 12;
-                    if (hour == 0) hour = 12;
-                    if (hour < 10) s += "0";
-                    s += std::to_string(hour);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int hour = Hour() % 12;
-                    if (hour == 0) hour = 12;
-                    if (hour < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), hour);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    // Computes all of the date and time fields at once.
+    CivilTime Fields() const {
+        CivilTime f;
+        const long long days = DaysSinceEpoch();
+        const long long sod = SecondOfDay();
+        Calendar::CivilFromDays(days, f.year, f.month, f.day);
+        f.yday = static_cast<int>(days - Calendar::DaysFromCivil(f.year, 1, 1)) + 1;
+        f.wday = Calendar::WeekdayFromDays(days);
+        f.hour = static_cast<int>(sod / 3600);
+        f.minute = static_cast<int>(sod / 60 % 60);
+        f.second = static_cast<int>(sod % 60);
+        f.nanosecond = static_cast<int>(FractionalTicks() * 1000000000LL / Period::den);
+        return f;
+    }
 
-                case 'j':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int doy = DayOfYear();
-                    if (doy < 100) s += "0";
-                    if (doy < 10) s += "0";
-                    s += std::to_string(doy);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int doy = DayOfYear();
-                    if (doy < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (doy < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), doy);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Millisecond() const {
+        if (Period::den < 1000) return 0;
+        return static_cast<int>(FractionalTicks() / (Period::den/1000));
+    }
 
-                case 'k':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int hour = Hour();
-                    if (hour < 10) s += " ";
-                    s += std::to_string(hour);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int hour = Hour();
-                    if (hour < 10) s += " ";
-                    s += LocaleData::GetNumber(locale.c_str(), hour);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Microsecond() const {
+        if (Period::den < 1000000) return 0;
+        return static_cast<int>(FractionalTicks() / (Period::den/1000000));
+    }
 
-                case 'l':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int hour = Hour() % 12;
-                    if (hour == 0) hour = 12;
-                    if (hour < 10) s += " ";
-                    s += std::to_string(hour);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int hour = Hour() % 12;
-                    if (hour == 0) hour = 12;
-                    if (hour < 10) s += " ";
-                    s += LocaleData::GetNumber(locale.c_str(), hour);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    int Nanosecond() const {
+        if (Period::den < 1000000000) return 0;
+        return static_cast<int>(FractionalTicks() / (Period::den/1000000000));
+    }
 
-                case 'm':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int month = Month();
-                    if (month < 10) s += "0";
-                    s += std::to_string(month);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int month = Month();
-                    if (month < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), month);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    DateTime<Calendar, Clock, Period> ToUTC() const {
+        int gmtoff = UTCOffset(); // in seconds
+        DateTime d = *this;
+        d.tz = UTC_TimezoneId;
+        d.earlier = false;
+        d.SubSeconds(gmtoff);
+        return d;
+    }
 
-                case 'M':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int minute = Minute();
-                    if (minute < 10) s += "0";
-                    s += std::to_string(minute);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int minute = Minute();
-                    if (minute < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), minute);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    DateTime<Calendar, Clock, Period> ToTimeZone(const Timezone& newtz) const {
+        return ToTimeZone(InternZone(newtz));
+    }
 
-                case 'n':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += "\n";
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
-                
-                case 'O':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    alt = true;
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    DateTime<Calendar, Clock, Period> ToTimeZone(TimezoneId newtz) const {
+        const long long utc = UTCTicks();
+        static thread_local ZoneTransitions::Hint hint, local_hint;
+        const ZoneTransitions& zone = TZTransitions(newtz);
+        int newgmtoff = zone.AtUTC(Calendar::FloorDiv(utc, Period::den), hint).gmtoff; // in seconds
+        DateTime d = *this;
+        d.tz = newtz;
+        d.ticks = utc;
+        d.AddSeconds(newgmtoff);
+        // Read back, a repeated local time would get the later offset.
+        d.earlier = zone.AtLocal(d.SecondsSinceEpoch(), local_hint).gmtoff != newgmtoff;
+        return d;
+    }
 
-                case 'p':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    // first get the 24-hour time
-                    int hour = Hour();
-                    if (hour < 12) {
-                        s += LocaleData::GetAM(locale.c_str());
-                    }
-                    else {
-                        s += LocaleData::GetPM(locale.c_str());
-                    }
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // Offset of the zone from UTC at this time, in seconds, and whether it is
+    // daylight saving time. These follow the zone's transitions. A time which
+    // happens twice gets the later offset, unless it came from ToTimeZone() at
+    // the first.
+    int UTCOffset() const {
+        return LocalInfo().gmtoff;
+    }
 
-                case 'P':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    // first get the 24-hour time
-                    int hour = Hour();
-                    if (hour < 12) {
-                        std::string data = LocaleData::GetAM(locale.c_str());
-                        std::transform(data.begin(), data.end(), data.begin(),
-                            [](unsigned char c){ return std::tolower(c); });
-                        s += data;
-                    }
-                    else {
-                        std::string data = LocaleData::GetPM(locale.c_str());
-                        std::transform(data.begin(), data.end(), data.begin(),
-                            [](unsigned char c){ return std::tolower(c); });
-                        s += data;
-                    }
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    bool IsDST() const {
+        return LocalInfo().dst != 0;
+    }
 
-                case 'r':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString(LocaleData::GetTime12Format(locale.c_str()), locale);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    std::string ToDateTime(const std::string& locale = "C") const {
+        std::string _format = LocaleData::GetDateTimeFormat(locale.c_str());
+        return ToString(_format);
+    }
+
+
+    // Prints the string in date(1) format.
+    std::string ToDate1(const std::string& locale = "C") const {
+        std::string _format = LocaleData::GetDate1Format(locale.c_str());
+        return ToString(_format);
+    }
 
-                case 'R':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString(LocaleData::GetTime24Format(locale.c_str()), locale);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // C locale uses %y, which is unsafe for old&new dates.
+    // If you want 4-digit years should use en_US or another locale.
+    std::string ToDate(const std::string& locale = "C") const {
+        std::string _format = LocaleData::GetDateFormat(locale.c_str());
+        return ToString(_format);
+    }
 
-                case 's':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    time_t ssepoch = ToTimeT();
-                    s += std::to_string(ssepoch);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    time_t ssepoch;
-                    s += LocaleData::GetNumber(locale.c_str(), ssepoch);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    std::string ToTime24(const std::string& locale = "C") const {
+        std::string _format = LocaleData::GetTime24Format(locale.c_str());
+        return ToString(_format);
+    }
 
+    std::string ToTime12(const std::string& locale = "C") const {
+        std::string _format = LocaleData::GetTime12Format(locale.c_str());
+        return ToString(_format);
+    }
+    
+    // Defaults to ISO8601
+    std::string ToISO8601String() const {
+        static const FormatPlan plan("%Y-%m-%dT%H:%M:%SZ%z");
+        return ToString(plan);
+    }
+    std::string ToString() const { return ToISO8601String(); }
 
-                case 'S':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int second = Second();
-                    if (second < 10) s += "0";
-                    s += std::to_string(second);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int second = Second();
-                    if (second < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), second);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    std::string toDate() const { return ToString("%Y-%m-%d"); }
 
-                case 't':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += "\t";
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // This function will throw away fractional seconds.
+    time_t ToTimeT() const {
+        time_t t = static_cast<time_t>(SecondsSinceEpoch());
+        return t;
+    }
 
-                case 'T':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString("%H:%M:%S", locale);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // This function will throw away fractional seconds.
+    struct tm ToTimeTM() const {
+        CivilTime f = Fields();
+        struct tm tm_;
+        memset(&tm_, 0, sizeof(struct tm));
+        tm_.tm_year = static_cast<int>(f.year - 1900);
+        tm_.tm_mon = f.month - 1;
+        tm_.tm_mday = f.day;
+        tm_.tm_hour = f.hour;
+        tm_.tm_min = f.minute;
+        tm_.tm_sec = f.second;
+        tm_.tm_wday = f.wday;
+        tm_.tm_yday = f.yday - 1;
+        return tm_;
+    }
 
-                case 'u':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    // 'u' must account that Sunday is 7 and other weekdays are the same as 'w'.
-                    int dow = DayOfWeek();
-                    if (dow == 0) dow == 7;
-                    s += std::to_string(dow);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    s += LocaleData::GetNumber(locale.c_str(), DayOfWeek());
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+#ifdef X_DATETIME_WITH_BOOST
+    boost::posix_time::ptime ToBoostPTime() const {
+        boost::posix_time::ptime p = boost::posix_time::from_time_t(ToTimeT());
+#ifdef BOOST_DATE_TIME_HAS_NANOSECONDS
+        p += boost::posix_time::nanoseconds(Nanosecond());
+#else
+        p += boost::posix_time::microseconds(Microsecond());
+#endif /* BOOOST_DATE_TIME_HAS_NANOSECONDS */
+        return p;
+    }
+#endif /* X_DATETIME_WITH_BOOST */
 
-                case 'U':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::SundayWeek(year, Month(), day)-1;
-                    if (week < 10) s += "0";
-                    s += std::to_string(week);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::SundayWeek(year, Month(), day)-1;
-                    if (week < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), week);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+#ifdef X_DATETIME_WITH_ABSEIL
+    absl::CivilSecond ToAbseilCivilSecond() const {
+        CivilTime f = Fields();
+        absl::CivilSecond civ(f.year, f.month, f.day,
+                f.hour, f.minute, f.second);
+        return civ;
+    }
 
-                case 'V':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day)-1;
-                    if (week < 10) s += "0";
-                    s += std::to_string(week);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::ISOWeek(year, Month(), day)-1;
-                    if (week < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), week);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    absl::CivilMinute ToAbseilCivilMinute() const {
+        CivilTime f = Fields();
+        absl::CivilMinute civ(f.year, f.month, f.day,
+                f.hour, f.minute);
+        return civ;
+    }
 
-                case 'w':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    s += std::to_string(DayOfWeek());
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    s += LocaleData::GetNumber(locale.c_str(), DayOfWeek());
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    absl::CivilHour ToAbseilCivilHour() const {
+        CivilTime f = Fields();
+        absl::CivilHour civ(f.year, f.month, f.day, f.hour);
+        return civ;
+    }
 
-                case 'W':
-                if (era) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || alt
-#endif
-                        ) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::MondayWeek(year, Month(), day)-1;
-                    if (week < 10) s += "0";
-                    s += std::to_string(week);
-                    format = false;
-                    alt = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (alt) {
-                    int day = Day();
-                    int year = Year();
-                    int week = DateTime::MondayWeek(year, Month(), day)-1;
-                    if (week < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), week);
-                    alt = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
+    absl::CivilDay ToAbseilCivilDay() const {
+        CivilTime f = Fields();
+        absl::CivilDay civ(f.year, f.month, f.day);
+        return civ;
+    }
 
-                case 'x':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format || era) {
-                    s += ToString(LocaleData::GetDateFormat(locale.c_str()), locale);
-                    format = false;
-                    era = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    absl::Time ToAbseilTime() const {
+        return absl::FromChrono(ToChrono());
+    }
+#endif /* X_DATETIME_WITH_ABSEIL */
 
-                case 'X':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format || era) {
-                    s += ToString(LocaleData::GetTime24Format(locale.c_str()), locale);
-                    format = false;
-                    era = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+#ifdef X_DATETIME_WITH_POCO
+    Poco::DateTime ToPoco() const {
+        CivilTime f = Fields();
+        int us = f.nanosecond / 1000;
+        Poco::DateTime p(static_cast<int>(f.year), f.month, f.day,
+                f.hour, f.minute, f.second,
+                us / 1000, us % 1000);
+        return p;
+    }
+#endif /* X_DATETIME_WITH_POCO */
 
-                case 'y':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    int year = Year() % 100;
-                    if (year < 0) { s += "-"; year = -year; }
-                    if (year < 10) s += "0";
-                    s += std::to_string(year);
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    int year = Year() % 100;
-                    if (year < 0) { s += "-"; year = -year; }
-                    if (year < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), year);
-                    era = false;
-                }
-#endif
-                else {
-                    s += c;
-                }
-                break;
 
-                case 'Y':
-                if (alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format
-#ifdef X_DATETIME_NO_LOCALES
-                    || era
-#endif
-                        ) {
-                    int year = Year();
-                    if (year < 0) { s += "-"; year = -year; }
-                    if (year < 1000) s += "0";
-                    if (year < 100) s += "0";
-                    if (year < 10) s += "0";
-                    s += std::to_string(year);
-                    format = false;
-                    era = false;
-                }
-#ifndef X_DATETIME_NO_LOCALES
-                else if (era) {
-                    int year = Year();
-                    if (year < 0) { s += "-"; year = -year; }
-                    if (year < 1000) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (year < 100) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    if (year < 10) s += LocaleData::GetAltDigit(locale.c_str(), 0);
-                    s += LocaleData::GetNumber(locale.c_str(), year);
-                    era = false;
-                }
+#ifdef X_DATETIME_WITH_GLIB
+    GDateTime* ToGLib() const {
+        CivilTime f = Fields();
+        return g_date_time_new_utc(static_cast<gint>(f.year), f.month, f.day,
+                f.hour, f.minute, f.second + f.nanosecond / 1000 / 1000000.0);
+    }
 #endif
-                else {
-                    s += c;
-                }
-                break;
 
+    std::chrono::time_point<Clock> ToChrono() const {
+        long long q = ticks / Period::den;
+        long long r = ticks % Period::den;
+        q += UnixOffset();
+        if (q > LLONG_MAX/ClockPeriod::den || q < LLONG_MIN/ClockPeriod::den) {
+            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
+        }
+        q *= ClockPeriod::den;
+        if (Period::den > ClockPeriod::den) {
+            r /= Period::den / ClockPeriod::den;
+        }
+        else {
+            r *= ClockPeriod::den / Period::den;
+        }
+        if (q > LLONG_MAX - r || q < LLONG_MIN + r) {
+            throw MalformedDateTime("Conversion to std::chrono::time_point is not possible without overflow.");
+        }
+        q += r;
+        return time_point(clock_duration(q));
+    }
 
-                case 'z':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    int gmtoff = tz.gmtoff[0] / 60;
-                    int mm = gmtoff % 60;
-                    mm = (mm >= 0) ? mm : -mm;
-                    int hh = gmtoff % 60;
-                    if (hh < 0) { s += "-"; hh = -hh; }
-                    else { s += "+"; }
-                    if (hh < 10) s += "0";
-                    s += std::to_string(hh);
-                    if (mm < 10) s += "0";
-                    s += std::to_string(mm);
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    // Convert a date and time to string, strictly following strftime(3) format conventions.
+    // This string is encoded at UTF8 which means that characters could take more than 1 byte.
+    // However, it is guarenteed that only the ASCII characters will use bytes 0x00 to 0x7F.
+    // If the same format is used many times, compile it once into a FormatPlan instead.
+    std::string ToString(const std::string &fmt, const std::string& locale = "C") const {
+        return ToString(FormatPlan(fmt, locale));
+    }
 
-                case 'Z':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += tz.name;
-                    format = false;
-                }
-                else {
-                    s += c;
-                }
-                break;
+    std::string ToString(const FormatPlan& plan) const {
+        std::string s;
+        s.reserve(plan.text.size() + plan.ops.size() * 8);
+        FormatStringSink sink = {s};
+        FormatWith(plan, sink);
+        return s;
+    }
+
+    // Longest output of FormatISO8601(): 19 for the date and time, 10 for the
+    // fraction and 6 for the offset.
+    static const size_t MaxISO8601Size = 35;
+
+    // Writes the time as RFC 3339 / ISO 8601 extended format, e.g. 2021-03-04T05:06:07.123+01:00,
+    // with 0, 3, 6 or 9 fractional digits. The offset is printed as Z when it is zero.
+    // This is a fixed layout which does not go through FormatPlan; it writes exactly
+    // 20 + (fractional_digits ? fractional_digits + 1 : 0) bytes for UTC, or 5 more for
+    // any other offset, without a terminating NUL, and returns that length.
+    // Only years 0000 to 9999 can be printed this way.
+    size_t FormatISO8601(char* buf, int fractional_digits = 0) const {
+        if (fractional_digits != 0 && fractional_digits != 3 && fractional_digits != 6 && fractional_digits != 9) {
+            throw MalformedDateTime("Fractional digits must be 0, 3, 6 or 9");
+        }
+        const long long days = DaysSinceEpoch();
+        const unsigned sod = static_cast<unsigned>(SecondOfDay());
+        long long y;
+        int month, day;
+        Calendar::CivilFromDays(days, y, month, day);
+        if (y < 0 || y > 9999) {
+            throw MalformedDateTime("Year does not fit in ISO 8601 basic format");
+        }
+        const unsigned year = static_cast<unsigned>(y);
+
+        PutDigitPair(buf, year / 100);
+        PutDigitPair(buf + 2, year % 100);
+        buf[4] = '-';
+        PutDigitPair(buf + 5, static_cast<unsigned>(month));
+        buf[7] = '-';
+        PutDigitPair(buf + 8, static_cast<unsigned>(day));
+        buf[10] = 'T';
+        PutDigitPair(buf + 11, sod / 3600);
+        buf[13] = ':';
+        PutDigitPair(buf + 14, sod / 60 % 60);
+        buf[16] = ':';
+        PutDigitPair(buf + 17, sod % 60);
+        char* p = buf + 19;
+
+        if (fractional_digits) {
+            static const unsigned divisors[10] = {1000000000, 100000000, 10000000, 1000000,
+                100000, 10000, 1000, 100, 10, 1};
+            const unsigned long long ns = static_cast<unsigned long long>(FractionalTicks()) * 1000000000ULL / Period::den;
+            unsigned frac = static_cast<unsigned>(ns / divisors[fractional_digits]);
+            *p = '.';
+            // Fill in from the right, two digits at a time.
+            char* q = p + fractional_digits;
+            for (int i = fractional_digits; i > 1; i -= 2) {
+                q -= 2;
+                PutDigitPair(q + 1, frac % 100);
+                frac /= 100;
+            }
+            if (fractional_digits & 1) {
+                p[1] = static_cast<char>('0' + frac);
+            }
+            p += fractional_digits + 1;
+        }
 
-                case '+':
-                if (era || alt) { throw MalformedDateTime("Bad format specifier"); }
-                if (format) {
-                    s += ToString(LocaleData::GetDate1Format(locale.c_str()), locale);
-                    format = false;
-                }
-                else {
-                    s += c;
+        const int gmtoff = UTCOffset();
+        if (gmtoff == 0) {
+            *p++ = 'Z';
+            return static_cast<size_t>(p - buf);
+        }
+        const unsigned minutes = static_cast<unsigned>((gmtoff < 0) ? -gmtoff : gmtoff) / 60;
+        p[0] = (gmtoff < 0) ? '-' : '+';
+        PutDigitPair(p + 1, minutes / 60 % 100);
+        p[3] = ':';
+        PutDigitPair(p + 4, minutes % 60);
+        return static_cast<size_t>(p + 6 - buf);
+    }
+
+    std::string ToRFC3339String(int fractional_digits = 0) const {
+        char buf[MaxISO8601Size];
+        return std::string(buf, FormatISO8601(buf, fractional_digits));
+    }
+
+    // Formats into buf without allocating. Like snprintf, at most cap-1 bytes are written
+    // followed by a NUL, and the return value is the length of the whole output, so the
+    // output was truncated if it is >= cap. MaxFormattedSize(plan) + 1 bytes is always enough.
+    size_t FormatTo(char* buf, size_t cap, const FormatPlan& plan) const {
+        FormatBufferSink sink = {buf, cap ? cap - 1 : 0, 0};
+        FormatWith(plan, sink);
+        if (cap) buf[(sink.len < cap - 1) ? sink.len : cap - 1] = '\0';
+        return sink.len;
+    }
+
+    // Formats through an output iterator and returns the iterator past the last byte written.
+    template <typename OutputIt>
+    OutputIt FormatTo(OutputIt out, const FormatPlan& plan) const {
+        FormatIteratorSink<OutputIt> sink = {out};
+        FormatWith(plan, sink);
+        return sink.it;
+    }
+
+    // Runs a compiled format and passes the output to out, which only needs
+    // an Append(const char*, size_t) method.
+    template <typename Sink>
+    void FormatWith(const FormatPlan& plan, Sink& out) const {
+        const CivilTime f = Fields();
+        const int year = static_cast<int>(f.year);
+        const int month = f.month;
+        const int day = f.day;
+        const int hour = f.hour;
+        const int wday = f.wday;
+
+        for (const FormatOp& op: plan.ops) {
+            long long v;
+            switch (op.spec) {
+                case 0: out.Append(plan.text.data() + op.offset, op.length); continue;
+                case 'a': AppendText(out, plan.short_weekdays[wday]); continue;
+                case 'A': AppendText(out, plan.long_weekdays[wday]); continue;
+                case 'b': AppendText(out, plan.short_months[month - 1]); continue;
+                case 'B': AppendText(out, plan.long_months[month - 1]); continue;
+                case 'p': AppendText(out, (hour < 12) ? plan.am : plan.pm); continue;
+                case 'P': AppendText(out, (hour < 12) ? plan.am_lower : plan.pm_lower); continue;
+                case 'z': AppendOffset(out, UTCOffset()); continue;
+                case 'Z': AppendText(out, TZ(tz).name); continue;
+
+                case '1': v = f.nanosecond / 1000000; break;
+                case '2': v = f.nanosecond / 1000; break;
+                case '3': v = f.nanosecond; break;
+                case 'C': v = year / 100; break;
+                case 'd':
+                case 'e': v = day; break;
+                case 'G':
+                case 'g':
+                v = year;
+                if (DateTime::ISOWeek(year, month, day) >= 52 && day < 7) {
+                    // This is January of the next year, %G wants us to
+                    // make it the previous year.
+                    --v;
                 }
+                if (op.spec == 'g') v %= 100;
                 break;
-
-                default:
-                if (format) { throw MalformedDateTime("Bad format specifier"); }
-                s += c;
-
+                case 'H':
+                case 'k': v = hour; break;
+                case 'I':
+                case 'l': v = (hour % 12 == 0) ? 12 : hour % 12; break;
+                case 'j': v = f.yday; break;
+                case 'm': v = month; break;
+                case 'M': v = f.minute; break;
+                case 's': v = SecondsSinceEpoch(); break;
+                case 'S': v = f.second; break;
+                case 'u':
+                case 'w': v = wday + 1; break; // same as DayOfWeek()
+                case 'U': v = DateTime::SundayWeek(year, month, day) - 1; break;
+                case 'V': v = DateTime::ISOWeek(year, month, day) - 1; break;
+                case 'W': v = DateTime::MondayWeek(year, month, day) - 1; break;
+                case 'y': v = year % 100; break;
+                case 'Y': v = year; break;
+                default: continue;
             }
+            AppendNumber(out, v, op, plan);
         }
-
-         return s;
     }
 
     void AddYears(long long _years) {
@@ -4609,43 +5338,42 @@ nested_junction:
     friend DateTime<Calendar_, Clock_, Period_> operator-(const DateTime<Calendar_, Clock_, Period_> &a, const TimeDelta<Period_> &b);
 
     DateTime &operator+=(const TimeDelta<Period> &rhs) {
-        tp += rhs.d;
+        ticks += rhs.d.count();
         return *this;
     }
 
     DateTime &operator-=(const TimeDelta<Period> &rhs) {
-        tp -= rhs.d;
+        ticks -= rhs.d.count();
         return *this;
     }
 
+    // Ticks shifted from the local time of the zone back to UTC.
+    long long UTCTicks() const {
+        return ticks - static_cast<long long>(UTCOffset()) * Period::den;
+    }
+
     // We ignore the offset because that is clock dependent, and these
     // functions only allow comparison with datetimes having the same
     // clock anyway.
     // However, we do NOT ignore the timezone. We always subtract the timezone
     // offsets from both times before doing the comparison.
     bool operator==(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) ==
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() == rhs.UTCTicks();
     }
     bool operator!=(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) !=
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() != rhs.UTCTicks();
     }
     bool operator<(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) <
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() < rhs.UTCTicks();
     }
     bool operator>(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) >
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() > rhs.UTCTicks();
     }
     bool operator<=(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) <=
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() <= rhs.UTCTicks();
     }
     bool operator>=(const DateTime<Calendar, Clock, Period> &rhs) const {
-        return tp - clock_duration(tz.gmtoff[0] * Period::den) >=
-            rhs.tp - clock_duration(rhs.tz.gmtoff[0] * Period::den);
+        return UTCTicks() >= rhs.UTCTicks();
     }
 
     template <typename Char, typename Traits, typename Calendar_, typename Clock_, typename Period_>
@@ -4858,26 +5586,188 @@ static inline TimeDelta<Ratio> operator-(const TimeDelta<Ratio> &a, const TimeDe
 
 template <typename Calendar, typename Clock, typename Period>
 static inline DateTime<Calendar, Clock, Period> operator+(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b) {
-    return DateTime<Calendar, Clock, Period>(a.tp + b.d);
+    DateTime<Calendar, Clock, Period> d = a;
+    d += b;
+    return d;
 }
 
 template <typename Calendar, typename Clock, typename Period>
 static inline DateTime<Calendar, Clock, Period> operator+(const TimeDelta<Period> &a, const DateTime<Calendar, Clock, Period> &b) {
-    return DateTime<Calendar, Clock, Period>(b.tp + a.d);
+    DateTime<Calendar, Clock, Period> d = b;
+    d += a;
+    return d;
 }
 
 template <typename Calendar, typename Clock, typename Period>
 static inline TimeDelta<Period> operator-(const DateTime<Calendar, Clock, Period> &a, const DateTime<Calendar, Clock, Period> &b) {
     TimeDelta<Period> td;
-    td.d = a.tp - b.tp;
+    td.d = std::chrono::duration<long long, Period>(a.ticks - b.ticks);
     return td;
 }
 
 template <typename Calendar, typename Clock, typename Period>
 static inline DateTime<Calendar, Clock, Period> operator-(const DateTime<Calendar, Clock, Period> &a, const TimeDelta<Period> &b) {
-    return DateTime<Calendar, Clock, Period>(a.tp - b.d);
+    DateTime<Calendar, Clock, Period> d = a;
+    d -= b;
+    return d;
 }
 
+#ifdef X_DATETIME_MMAP
+// Reads the timestamp of every line of a log file, without copying the lines into
+// strings. The file is mapped a window at a time, so it can be larger than memory;
+// the kernel is told that each window is read in order, and to start reading the
+// next one ahead. A line longer than the window grows it.
+//
+// The timestamp starts column bytes into the line. It is parsed like
+// TryFromChars(first, last, plan, consumed), with the names of %b, %a and so on
+// coming from the plan's locale, or as ISO 8601 if there is no plan; whatever
+// follows it is ignored. A ParseContext skips the date while it stays the same.
+// Lines where the timestamp doesn't parse are skipped and counted.
+template <typename DateTimeT = DateTime<> >
+class LogReader {
+public:
+    static const size_t DefaultWindow = 64 << 20;
+
+    explicit LogReader(const std::string& path, size_t column_ = 0, size_t window_ = DefaultWindow)
+        : plan(), column(column_) {
+        Open(path, window_);
+    }
+
+    LogReader(const std::string& path, const ParsePlan& plan_, size_t column_ = 0, size_t window_ = DefaultWindow)
+        : plan(new ParsePlan(plan_)), column(column_) {
+        Open(path, window_);
+    }
+
+    ~LogReader() {
+        Unmap();
+        close(fd);
+    }
+
+    LogReader(const LogReader&) = delete;
+    LogReader& operator=(const LogReader&) = delete;
+
+    // Moves to the next line with a timestamp, and sets offset to where that line
+    // starts in the file. Returns false at the end of the file.
+    bool Next(unsigned long long& offset, DateTimeT& time) {
+        const char* first;
+        const char* last;
+        while (NextLine(offset, first, last)) {
+            ++lines;
+            if (static_cast<size_t>(last - first) > column) {
+                size_t consumed;
+                ParseError err = plan ? time.TryFromChars(first + column, last, *plan, consumed, ctx)
+                    : time.TryFromISO8601(first + column, last, consumed, ctx);
+                if (err == ParseError::None) return true;
+            }
+            ++skipped;
+        }
+        return false;
+    }
+
+    // Starts again from the first line.
+    void Rewind() {
+        pos = 0;
+        lines = 0;
+        skipped = 0;
+        ctx.Clear();
+    }
+
+    unsigned long long FileSize() const { return file_size; }
+
+    // Lines read so far, and how many of them had no timestamp.
+    size_t Lines() const { return lines; }
+    size_t Skipped() const { return skipped; }
+
+private:
+    std::unique_ptr<ParsePlan> plan;
+    size_t column;
+    ParseContext ctx;
+    int fd;
+    unsigned long long file_size;
+    size_t page;
+    size_t window;
+    char* map;                     // the window, or NULL
+    unsigned long long map_offset; // where it starts in the file
+    size_t map_length;
+    unsigned long long pos;        // start of the next line
+    size_t lines;
+    size_t skipped;
+
+    void Open(const std::string& path, size_t window_) {
+        map = NULL;
+        map_offset = 0;
+        map_length = 0;
+        pos = 0;
+        lines = 0;
+        skipped = 0;
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "Cannot stat " + path);
+        }
+        file_size = static_cast<unsigned long long>(st.st_size);
+        page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        window = std::max(page, (window_ + page - 1) / page * page);
+    }
+
+    // Finds the line starting at pos, mapping the part of the file it is in.
+    bool NextLine(unsigned long long& offset, const char*& first, const char*& last) {
+        if (pos >= file_size) return false;
+        const char* eol = NULL;
+        for (;;) {
+            if (map == NULL || pos < map_offset || pos >= map_offset + map_length) {
+                Map(pos);
+            }
+            first = map + (pos - map_offset);
+            const char* end = map + map_length;
+            eol = static_cast<const char*>(memchr(first, '\n', end - first));
+            if (eol != NULL || map_offset + map_length == file_size) {
+                last = eol ? eol : end;
+                break;
+            }
+            // The line runs past the window. Map again from its start, and if the
+            // window already started there, make it bigger.
+            if (map_offset == pos / page * page) window *= 2;
+            Unmap();
+        }
+        offset = pos;
+        pos = eol ? pos + (eol - first) + 1 : file_size;
+        return true;
+    }
+
+    void Map(unsigned long long at) {
+        Unmap();
+        map_offset = at / page * page;
+        map_length = static_cast<size_t>(std::min<unsigned long long>(window, file_size - map_offset));
+        void* m = mmap(NULL, map_length, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+        if (m == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "Cannot map log file");
+        }
+        map = static_cast<char*>(m);
+        madvise(m, map_length, MADV_SEQUENTIAL);
+        madvise(m, map_length, MADV_WILLNEED);
+#ifdef POSIX_FADV_WILLNEED
+        const unsigned long long next = map_offset + map_length;
+        if (next < file_size) {
+            posix_fadvise(fd, static_cast<off_t>(next), static_cast<off_t>(window), POSIX_FADV_WILLNEED);
+        }
+#endif
+    }
+
+    void Unmap() {
+        if (map != NULL) {
+            munmap(map, map_length);
+            map = NULL;
+        }
+    }
+};
+#endif /* X_DATETIME_MMAP */
+
 // The "D" stands for default, as declaring a templated class object without <>
 // was illegal until C++17.
 typedef TimeDelta<> TimeDeltaD;
@@ -4888,6 +5778,11 @@ typedef TimeDelta<std::micro> TimeDeltaW;
 typedef DateTime<GregorianCalendar, std::chrono::system_clock, std::micro> DateTimeW;
 typedef DateTimePeriod<GregorianCalendar, std::chrono::system_clock, std::micro> DateTimePeriodW;
 
+static_assert(sizeof(DateTimeD) <= 16 && std::is_trivially_copyable<DateTimeD>::value,
+        "DateTime must stay trivially copyable and no larger than 16 bytes");
+static_assert(sizeof(DateTimeW) <= 16 && std::is_trivially_copyable<DateTimeW>::value,
+        "DateTime must stay trivially copyable and no larger than 16 bytes");
+
 
 }
 #endif /* X_DATETIME_H */
@@ -2,7 +2,6 @@
 #ifndef X_DATETIME_TIMEZONE_H
 #define X_DATETIME_TIMEZONE_H
 #include <string>
-#include <map>
 #include <vector>
 #include <time.h>
 namespace xDateTime {
@@ -13,6 +12,7 @@ struct Timezone {
     std::vector<std::string> tzname;
     std::vector<int> dst;
     std::vector<int> gmtoff; // seconds
+    std::string rule;        // POSIX TZ string, for the time after the last transition
     static std::string CalcOffset(int hour, int minute) {
         std::string n = std::to_string(hour) + ((minute > 0) ? ":" + std::to_string(minute) : "");
         n.insert(0, hour < 0 ? "UTC-" : "UTC+");
@@ -29,2108 +29,4070 @@ struct Timezone {
     }
 };
 
-static inline std::map<std::string, Timezone> InitializeTimezones();
-static inline Timezone TZ(const std::string& name) { return InitializeTimezones()[name]; }
-struct BaseTimezone {
-    Timezone tz;
-    BaseTimezone() { tz = TZ("UTC"); }
+// Handle to a zone interned in the TimezoneRegistry. The built-in zones come first,
+// in the order of BuiltinZones, and UTC is always registered first, so a
+// value-initialized TimezoneId refers to UTC.
+enum TimezoneId : unsigned short {
+    UTC_TimezoneId = 0,
+    ACDT_TimezoneId = 1,
+    ACST_TimezoneId = 2,
+    ACT_TimezoneId = 3,
+    ACWST_TimezoneId = 4,
+    ADT_TimezoneId = 5,
+    AEDT_TimezoneId = 6,
+    AEST_TimezoneId = 7,
+    AFT_TimezoneId = 8,
+    AKDT_TimezoneId = 9,
+    AKST_TimezoneId = 10,
+    ALMT_TimezoneId = 11,
+    AMST_TimezoneId = 12,
+    AMT_TimezoneId = 13,
+    ANAT_TimezoneId = 14,
+    AQTT_TimezoneId = 15,
+    ART_TimezoneId = 16,
+    ASEAN_Common_Time_TimezoneId = 17,
+    AST_TimezoneId = 18,
+    AWST_TimezoneId = 19,
+    AZOST_TimezoneId = 20,
+    AZOT_TimezoneId = 21,
+    AZT_TimezoneId = 22,
+    Acre_Time_TimezoneId = 23,
+    Afghanistan_Time_TimezoneId = 24,
+    Alaska_Daylight_Time_TimezoneId = 25,
+    Alaska_Standard_Time_TimezoneId = 26,
+    AlmamAta_Time_TimezoneId = 27,
+    Amazon_Summer_Time_TimezoneId = 28,
+    Amazon_Time_TimezoneId = 29,
+    Anadyr_Time_TimezoneId = 30,
+    Aqtobe_Time_TimezoneId = 31,
+    Arabia_Standard_Time_TimezoneId = 32,
+    Argentina_Time_TimezoneId = 33,
+    Armenia_Time_TimezoneId = 34,
+    Atlantic_Daylight_Time_TimezoneId = 35,
+    Atlantic_Standard_Time_TimezoneId = 36,
+    Australian_Central_Daylight_Saving_Time_TimezoneId = 37,
+    Australian_Central_Standard_Time_TimezoneId = 38,
+    Australian_Central_Western_Standard_Time_TimezoneId = 39,
+    Australian_Eastern_Daylight_Saving_Time_TimezoneId = 40,
+    Australian_Eastern_Standard_Time_TimezoneId = 41,
+    Australian_Western_Standard_Time_TimezoneId = 42,
+    Azerbaijan_Time_TimezoneId = 43,
+    Azores_Standard_Time_TimezoneId = 44,
+    Azores_Summer_Time_TimezoneId = 45,
+    BIOT_TimezoneId = 46,
+    BIT_TimezoneId = 47,
+    BNT_TimezoneId = 48,
+    BOT_TimezoneId = 49,
+    BRST_TimezoneId = 50,
+    BRT_TimezoneId = 51,
+    BST_TimezoneId = 52,
+    BTT_TimezoneId = 53,
+    Baker_Island_Time_TimezoneId = 54,
+    Bangladesh_Standard_Time_TimezoneId = 55,
+    Bhutan_Time_TimezoneId = 56,
+    Bolivia_Time_TimezoneId = 57,
+    Bougainville_Standard_Time_TimezoneId = 58,
+    Brasilia_Summer_Time_TimezoneId = 59,
+    Brasilia_Time_TimezoneId = 60,
+    British_Indian_Ocean_Time_TimezoneId = 61,
+    British_Summer_Time_TimezoneId = 62,
+    Brunei_Time_TimezoneId = 63,
+    CAT_TimezoneId = 64,
+    CCT_TimezoneId = 65,
+    CDT_TimezoneId = 66,
+    CEST_TimezoneId = 67,
+    CET_TimezoneId = 68,
+    CHADT_TimezoneId = 69,
+    CHAST_TimezoneId = 70,
+    CHOST_TimezoneId = 71,
+    CHOT_TimezoneId = 72,
+    CHST_TimezoneId = 73,
+    CHUT_TimezoneId = 74,
+    CIST_TimezoneId = 75,
+    CKT_TimezoneId = 76,
+    CLST_TimezoneId = 77,
+    CLT_TimezoneId = 78,
+    COST_TimezoneId = 79,
+    COT_TimezoneId = 80,
+    CST_TimezoneId = 81,
+    CVT_TimezoneId = 82,
+    CWST_TimezoneId = 83,
+    CXT_TimezoneId = 84,
+    Cape_Verde_Time_TimezoneId = 85,
+    Central_Africa_Time_TimezoneId = 86,
+    Central_Daylight_Time_TimezoneId = 87,
+    Central_European_Summer_Time_TimezoneId = 88,
+    Central_European_Time_TimezoneId = 89,
+    Central_Indonesia_Time_TimezoneId = 90,
+    Central_Standard_Time_TimezoneId = 91,
+    Central_Western_Standard_Time_TimezoneId = 92,
+    Chagos_Archipelago_Indian_Ocean_Time_TimezoneId = 93,
+    Chamorro_Standard_Time_TimezoneId = 94,
+    Chatham_Daylight_Time_TimezoneId = 95,
+    Chatham_Standard_Time_TimezoneId = 96,
+    Chile_Standard_Time_TimezoneId = 97,
+    Chile_Summer_Time_TimezoneId = 98,
+    China_Standard_Time_TimezoneId = 99,
+    Choibalsan_Standard_Time_TimezoneId = 100,
+    Choibalsan_Summer_Time_TimezoneId = 101,
+    Christmas_Island_Time_TimezoneId = 102,
+    Chuuk_Time_TimezoneId = 103,
+    Clipperton_Island_Standard_Time_TimezoneId = 104,
+    Cocos_Islands_Time_TimezoneId = 105,
+    Colombia_Summer_Time_TimezoneId = 106,
+    Colombia_Time_TimezoneId = 107,
+    Cook_Island_Time_TimezoneId = 108,
+    Coordinated_Universal_Time_TimezoneId = 109,
+    Cuba_Daylight_Time_TimezoneId = 110,
+    Cuba_Standard_Time_TimezoneId = 111,
+    DAVT_TimezoneId = 112,
+    DDUT_TimezoneId = 113,
+    DFT_TimezoneId = 114,
+    Davis_Time_TimezoneId = 115,
+    Dumont_d_Urville_Time_TimezoneId = 116,
+    EASST_TimezoneId = 117,
+    EAST_TimezoneId = 118,
+    EAT_TimezoneId = 119,
+    ECT_TimezoneId = 120,
+    EDT_TimezoneId = 121,
+    EEST_TimezoneId = 122,
+    EET_TimezoneId = 123,
+    EGST_TimezoneId = 124,
+    EGT_TimezoneId = 125,
+    EST_TimezoneId = 126,
+    East_Africa_Time_TimezoneId = 127,
+    Easter_Island_Standard_Time_TimezoneId = 128,
+    Easter_Island_Summer_Time_TimezoneId = 129,
+    Eastern_Caribbean_Time_TimezoneId = 130,
+    Eastern_Daylight_Time_TimezoneId = 131,
+    Eastern_European_Summer_Time_TimezoneId = 132,
+    Eastern_European_Time_TimezoneId = 133,
+    Eastern_Greenland_Summer_Time_TimezoneId = 134,
+    Eastern_Greenland_Time_TimezoneId = 135,
+    Eastern_Indonesian_Time_TimezoneId = 136,
+    Eastern_Standard_Time_TimezoneId = 137,
+    Ecuador_Time_TimezoneId = 138,
+    FET_TimezoneId = 139,
+    FJT_TimezoneId = 140,
+    FKST_TimezoneId = 141,
+    FKT_TimezoneId = 142,
+    FNT_TimezoneId = 143,
+    Falkland_Islands_Summer_Time_TimezoneId = 144,
+    Falkland_Islands_Time_TimezoneId = 145,
+    Fernando_de_Noronha_Time_TimezoneId = 146,
+    Fiji_Time_TimezoneId = 147,
+    French_Guiana_Time_TimezoneId = 148,
+    French_Southern_and_Antarctic_Time_TimezoneId = 149,
+    Furthermeastern_European_Time_TimezoneId = 150,
+    GALT_TimezoneId = 151,
+    GAMT_TimezoneId = 152,
+    GET_TimezoneId = 153,
+    GFT_TimezoneId = 154,
+    GILT_TimezoneId = 155,
+    GIT_TimezoneId = 156,
+    GMT_TimezoneId = 157,
+    GST_TimezoneId = 158,
+    GYT_TimezoneId = 159,
+    Galapagos_Time_TimezoneId = 160,
+    Gambier_Island_Time_TimezoneId = 161,
+    Gambier_Islands_Time_TimezoneId = 162,
+    Georgia_Standard_Time_TimezoneId = 163,
+    Gilbert_Island_Time_TimezoneId = 164,
+    Greenwich_Mean_Time_TimezoneId = 165,
+    Gulf_Standard_Time_TimezoneId = 166,
+    Guyana_Time_TimezoneId = 167,
+    HAEC_TimezoneId = 168,
+    HDT_TimezoneId = 169,
+    HKT_TimezoneId = 170,
+    HMT_TimezoneId = 171,
+    HOVST_TimezoneId = 172,
+    HOVT_TimezoneId = 173,
+    HST_TimezoneId = 174,
+    Hawaii_Aleutian_Daylight_Time_TimezoneId = 175,
+    Hawaii_Aleutian_Standard_Time_TimezoneId = 176,
+    Heard_and_McDonald_Islands_TimezoneId = 177,
+    Heure_Avancee_d_Europe_Centrale_TimezoneId = 178,
+    Hong_Kong_Time_TimezoneId = 179,
+    Hovd_Summer_Time_TimezoneId = 180,
+    Hovd_Time_TimezoneId = 181,
+    ICT_TimezoneId = 182,
+    IDLW_TimezoneId = 183,
+    IDT_TimezoneId = 184,
+    IOT_TimezoneId = 185,
+    IRDT_TimezoneId = 186,
+    IRKT_TimezoneId = 187,
+    IRST_TimezoneId = 188,
+    IST_TimezoneId = 189,
+    Indian_Standard_Time_TimezoneId = 190,
+    Indochina_Time_TimezoneId = 191,
+    Iran_Daylight_Time_TimezoneId = 192,
+    Iran_Standard_Time_TimezoneId = 193,
+    Irish_Standard_Time_TimezoneId = 194,
+    Irkutsk_Time_TimezoneId = 195,
+    Israel_Daylight_Time_TimezoneId = 196,
+    Israel_Standard_Time_TimezoneId = 197,
+    JST_TimezoneId = 198,
+    Japan_Standard_Time_TimezoneId = 199,
+    KALT_TimezoneId = 200,
+    KGT_TimezoneId = 201,
+    KOST_TimezoneId = 202,
+    KRAT_TimezoneId = 203,
+    KST_TimezoneId = 204,
+    Kaliningrad_Time_TimezoneId = 205,
+    Kamchatka_Time_TimezoneId = 206,
+    Korea_Standard_Time_TimezoneId = 207,
+    Kosrae_Time_TimezoneId = 208,
+    Krasnoyarsk_Time_TimezoneId = 209,
+    Kyrgyzstan_Time_TimezoneId = 210,
+    LHST_TimezoneId = 211,
+    LINT_TimezoneId = 212,
+    Line_Islands_TimezoneId = 213,
+    Lord_Howe_Standard_Time_TimezoneId = 214,
+    Lord_Howe_Summer_Time_TimezoneId = 215,
+    MAGT_TimezoneId = 216,
+    MART_TimezoneId = 217,
+    MAWT_TimezoneId = 218,
+    MDT_TimezoneId = 219,
+    MEST_TimezoneId = 220,
+    MET_TimezoneId = 221,
+    MHT_TimezoneId = 222,
+    MIST_TimezoneId = 223,
+    MIT_TimezoneId = 224,
+    MMT_TimezoneId = 225,
+    MSK_TimezoneId = 226,
+    MST_TimezoneId = 227,
+    MUT_TimezoneId = 228,
+    MVT_TimezoneId = 229,
+    MYT_TimezoneId = 230,
+    Macquarie_Island_Station_Time_TimezoneId = 231,
+    Magadan_Time_TimezoneId = 232,
+    Malaysia_Standard_Time_TimezoneId = 233,
+    Malaysia_Time_TimezoneId = 234,
+    Maldives_Time_TimezoneId = 235,
+    Marquesas_Islands_Time_TimezoneId = 236,
+    Marshall_Islands_Time_TimezoneId = 237,
+    Mauritius_Time_TimezoneId = 238,
+    Mawson_Station_Time_TimezoneId = 239,
+    Middle_European_Summer_Time_TimezoneId = 240,
+    Middle_European_Time_TimezoneId = 241,
+    Moscow_Time_TimezoneId = 242,
+    Mountain_Daylight_Time_TimezoneId = 243,
+    Mountain_Standard_Time_TimezoneId = 244,
+    Myanmar_Standard_Time_TimezoneId = 245,
+    NCT_TimezoneId = 246,
+    NDT_TimezoneId = 247,
+    NFT_TimezoneId = 248,
+    NOVT_TimezoneId = 249,
+    NPT_TimezoneId = 250,
+    NST_TimezoneId = 251,
+    NT_TimezoneId = 252,
+    NUT_TimezoneId = 253,
+    NZDT_TimezoneId = 254,
+    NZST_TimezoneId = 255,
+    Nepal_Time_TimezoneId = 256,
+    New_Caledonia_Time_TimezoneId = 257,
+    New_Zealand_Daylight_Time_TimezoneId = 258,
+    New_Zealand_Standard_Time_TimezoneId = 259,
+    Newfoundland_Daylight_Time_TimezoneId = 260,
+    Newfoundland_Standard_Time_TimezoneId = 261,
+    Newfoundland_Time_TimezoneId = 262,
+    Niue_Time_TimezoneId = 263,
+    Norfolk_Island_Time_TimezoneId = 264,
+    Novosibirsk_Time_TimezoneId = 265,
+    OMST_TimezoneId = 266,
+    ORAT_TimezoneId = 267,
+    Omsk_Time_TimezoneId = 268,
+    Oral_Time_TimezoneId = 269,
+    PDT_TimezoneId = 270,
+    PET_TimezoneId = 271,
+    PETT_TimezoneId = 272,
+    PGT_TimezoneId = 273,
+    PHOT_TimezoneId = 274,
+    PHST_TimezoneId = 275,
+    PHT_TimezoneId = 276,
+    PKT_TimezoneId = 277,
+    PMDT_TimezoneId = 278,
+    PMST_TimezoneId = 279,
+    PONT_TimezoneId = 280,
+    PST_TimezoneId = 281,
+    PWT_TimezoneId = 282,
+    PYST_TimezoneId = 283,
+    PYT_TimezoneId = 284,
+    Pacific_Daylight_Time_TimezoneId = 285,
+    Pacific_Standard_Time_TimezoneId = 286,
+    Pakistan_Standard_Time_TimezoneId = 287,
+    Palau_Time_TimezoneId = 288,
+    Papua_New_Guinea_Time_TimezoneId = 289,
+    Paraguay_Summer_Time_TimezoneId = 290,
+    Paraguay_Time_TimezoneId = 291,
+    Peru_Time_TimezoneId = 292,
+    Philippine_Standard_Time_TimezoneId = 293,
+    Philippine_Time_TimezoneId = 294,
+    Phoenix_Island_Time_TimezoneId = 295,
+    Pohnpei_Standard_Time_TimezoneId = 296,
+    RET_TimezoneId = 297,
+    ROTT_TimezoneId = 298,
+    Rothera_Research_Station_Time_TimezoneId = 299,
+    Reunion_Time_TimezoneId = 300,
+    SAKT_TimezoneId = 301,
+    SAMT_TimezoneId = 302,
+    SAST_TimezoneId = 303,
+    SBT_TimezoneId = 304,
+    SCT_TimezoneId = 305,
+    SDT_TimezoneId = 306,
+    SGT_TimezoneId = 307,
+    SLST_TimezoneId = 308,
+    SRET_TimezoneId = 309,
+    SRT_TimezoneId = 310,
+    SST_TimezoneId = 311,
+    SYOT_TimezoneId = 312,
+    Saint_Pierre_and_Miquelon_Daylight_Time_TimezoneId = 313,
+    Saint_Pierre_and_Miquelon_Standard_Time_TimezoneId = 314,
+    Sakhalin_Island_Time_TimezoneId = 315,
+    Samara_Time_TimezoneId = 316,
+    Samoa_Daylight_Time_TimezoneId = 317,
+    Samoa_Standard_Time_TimezoneId = 318,
+    Seychelles_Time_TimezoneId = 319,
+    Showa_Station_Time_TimezoneId = 320,
+    Singapore_Standard_Time_TimezoneId = 321,
+    Singapore_Time_TimezoneId = 322,
+    Solomon_Islands_Time_TimezoneId = 323,
+    South_African_Standard_Time_TimezoneId = 324,
+    South_Georgia_and_the_South_Sandwich_Islands_Time_TimezoneId = 325,
+    Srednekolymsk_Time_TimezoneId = 326,
+    Sri_Lanka_Standard_Time_TimezoneId = 327,
+    Suriname_Time_TimezoneId = 328,
+    TAHT_TimezoneId = 329,
+    TFT_TimezoneId = 330,
+    THA_TimezoneId = 331,
+    TJT_TimezoneId = 332,
+    TKT_TimezoneId = 333,
+    TLT_TimezoneId = 334,
+    TMT_TimezoneId = 335,
+    TOT_TimezoneId = 336,
+    TRT_TimezoneId = 337,
+    TVT_TimezoneId = 338,
+    Tahiti_Time_TimezoneId = 339,
+    Tajikistan_Time_TimezoneId = 340,
+    Thailand_Standard_Time_TimezoneId = 341,
+    Timor_Leste_Time_TimezoneId = 342,
+    Tokelau_Time_TimezoneId = 343,
+    Tonga_Time_TimezoneId = 344,
+    Turkey_Time_TimezoneId = 345,
+    Turkmenistan_Time_TimezoneId = 346,
+    Tuvalu_Time_TimezoneId = 347,
+    ULAST_TimezoneId = 348,
+    ULAT_TimezoneId = 349,
+    UTCp0_TimezoneId = 350,
+    UTCp015_TimezoneId = 351,
+    UTCp030_TimezoneId = 352,
+    UTCp045_TimezoneId = 353,
+    UTCp1_TimezoneId = 354,
+    UTCp10_TimezoneId = 355,
+    UTCp1015_TimezoneId = 356,
+    UTCp1030_TimezoneId = 357,
+    UTCp1045_TimezoneId = 358,
+    UTCp11_TimezoneId = 359,
+    UTCp1115_TimezoneId = 360,
+    UTCp1130_TimezoneId = 361,
+    UTCp1145_TimezoneId = 362,
+    UTCp12_TimezoneId = 363,
+    UTCp1215_TimezoneId = 364,
+    UTCp1230_TimezoneId = 365,
+    UTCp1245_TimezoneId = 366,
+    UTCp13_TimezoneId = 367,
+    UTCp1315_TimezoneId = 368,
+    UTCp1330_TimezoneId = 369,
+    UTCp1345_TimezoneId = 370,
+    UTCp14_TimezoneId = 371,
+    UTCp1415_TimezoneId = 372,
+    UTCp1430_TimezoneId = 373,
+    UTCp1445_TimezoneId = 374,
+    UTCp115_TimezoneId = 375,
+    UTCp130_TimezoneId = 376,
+    UTCp145_TimezoneId = 377,
+    UTCp2_TimezoneId = 378,
+    UTCp215_TimezoneId = 379,
+    UTCp230_TimezoneId = 380,
+    UTCp245_TimezoneId = 381,
+    UTCp3_TimezoneId = 382,
+    UTCp315_TimezoneId = 383,
+    UTCp330_TimezoneId = 384,
+    UTCp345_TimezoneId = 385,
+    UTCp4_TimezoneId = 386,
+    UTCp415_TimezoneId = 387,
+    UTCp430_TimezoneId = 388,
+    UTCp445_TimezoneId = 389,
+    UTCp5_TimezoneId = 390,
+    UTCp515_TimezoneId = 391,
+    UTCp530_TimezoneId = 392,
+    UTCp545_TimezoneId = 393,
+    UTCp6_TimezoneId = 394,
+    UTCp615_TimezoneId = 395,
+    UTCp630_TimezoneId = 396,
+    UTCp645_TimezoneId = 397,
+    UTCp7_TimezoneId = 398,
+    UTCp715_TimezoneId = 399,
+    UTCp730_TimezoneId = 400,
+    UTCp745_TimezoneId = 401,
+    UTCp8_TimezoneId = 402,
+    UTCp815_TimezoneId = 403,
+    UTCp830_TimezoneId = 404,
+    UTCp845_TimezoneId = 405,
+    UTCp9_TimezoneId = 406,
+    UTCp915_TimezoneId = 407,
+    UTCp930_TimezoneId = 408,
+    UTCp945_TimezoneId = 409,
+    UTCmm1_TimezoneId = 410,
+    UTCmm10_TimezoneId = 411,
+    UTCmm1015_TimezoneId = 412,
+    UTCmm1030_TimezoneId = 413,
+    UTCmm1045_TimezoneId = 414,
+    UTCmm11_TimezoneId = 415,
+    UTCmm1115_TimezoneId = 416,
+    UTCmm1130_TimezoneId = 417,
+    UTCmm1145_TimezoneId = 418,
+    UTCmm12_TimezoneId = 419,
+    UTCmm1215_TimezoneId = 420,
+    UTCmm1230_TimezoneId = 421,
+    UTCmm1245_TimezoneId = 422,
+    UTCmm115_TimezoneId = 423,
+    UTCmm130_TimezoneId = 424,
+    UTCmm145_TimezoneId = 425,
+    UTCmm2_TimezoneId = 426,
+    UTCmm215_TimezoneId = 427,
+    UTCmm230_TimezoneId = 428,
+    UTCmm245_TimezoneId = 429,
+    UTCmm3_TimezoneId = 430,
+    UTCmm315_TimezoneId = 431,
+    UTCmm330_TimezoneId = 432,
+    UTCmm345_TimezoneId = 433,
+    UTCmm4_TimezoneId = 434,
+    UTCmm415_TimezoneId = 435,
+    UTCmm430_TimezoneId = 436,
+    UTCmm445_TimezoneId = 437,
+    UTCmm5_TimezoneId = 438,
+    UTCmm515_TimezoneId = 439,
+    UTCmm530_TimezoneId = 440,
+    UTCmm545_TimezoneId = 441,
+    UTCmm6_TimezoneId = 442,
+    UTCmm615_TimezoneId = 443,
+    UTCmm630_TimezoneId = 444,
+    UTCmm645_TimezoneId = 445,
+    UTCmm7_TimezoneId = 446,
+    UTCmm715_TimezoneId = 447,
+    UTCmm730_TimezoneId = 448,
+    UTCmm745_TimezoneId = 449,
+    UTCmm8_TimezoneId = 450,
+    UTCmm815_TimezoneId = 451,
+    UTCmm830_TimezoneId = 452,
+    UTCmm845_TimezoneId = 453,
+    UTCmm9_TimezoneId = 454,
+    UTCmm915_TimezoneId = 455,
+    UTCmm930_TimezoneId = 456,
+    UTCmm945_TimezoneId = 457,
+    UYST_TimezoneId = 458,
+    UYT_TimezoneId = 459,
+    UZT_TimezoneId = 460,
+    Ulaanbaatar_Standard_Time_TimezoneId = 461,
+    Ulaanbaatar_Summer_Time_TimezoneId = 462,
+    Uruguay_Standard_Time_TimezoneId = 463,
+    Uruguay_Summer_Time_TimezoneId = 464,
+    Uzbekistan_Time_TimezoneId = 465,
+    VET_TimezoneId = 466,
+    VLAT_TimezoneId = 467,
+    VOLT_TimezoneId = 468,
+    VOST_TimezoneId = 469,
+    VUT_TimezoneId = 470,
+    Vanuatu_TimezoneId = 471,
+    Venezuelan_Standard_Time_TimezoneId = 472,
+    Vladivostok_Time_TimezoneId = 473,
+    Volgograd_Time_TimezoneId = 474,
+    Vostok_Station_Time_TimezoneId = 475,
+    WAKT_TimezoneId = 476,
+    WAST_TimezoneId = 477,
+    WAT_TimezoneId = 478,
+    WEST_TimezoneId = 479,
+    WET_TimezoneId = 480,
+    WGST_TimezoneId = 481,
+    WGT_TimezoneId = 482,
+    WIB_TimezoneId = 483,
+    WIT_TimezoneId = 484,
+    WITA_TimezoneId = 485,
+    WST_TimezoneId = 486,
+    Wake_Island_Time_TimezoneId = 487,
+    West_Africa_Summer_Time_TimezoneId = 488,
+    West_Africa_Time_TimezoneId = 489,
+    West_Greenland_Summer_Time_TimezoneId = 490,
+    West_Greenland_Time_TimezoneId = 491,
+    Western_European_Summer_Time_TimezoneId = 492,
+    Western_European_Time_TimezoneId = 493,
+    Western_Indonesian_Time_TimezoneId = 494,
+    Western_Standard_Time_TimezoneId = 495,
+    YAKT_TimezoneId = 496,
+    YEKT_TimezoneId = 497,
+    Yakutsk_Time_TimezoneId = 498,
+    Yekaterinburg_Time_TimezoneId = 499,
 };
 
-static inline std::map<std::string, Timezone> InitializeTimezones() {
-    static std::map<std::string, Timezone> timezones; 
-    static bool initialized = false; 
-    struct tm t;
-    if (initialized) return timezones;
+// The built-in zones, as constant tables which need no initialization. A zone
+// has the transitions [first, first + count) of BuiltinTransitions, or the fixed
+// offset gmtoff if count is 0. After its last transition, a zone follows its
+// POSIX TZ rule. Apart from UTC, which is first, the zones are sorted by name.
+struct BuiltinTransition {
+    long long utc;        // seconds since the epoch
+    int gmtoff;           // seconds, from utc on
+    unsigned short abbr;  // index into BuiltinAbbreviations
+    unsigned char dst;
+};
 
-    // Cities markes as time zone reference points
-    // Note: None of these conversions allow auto DST because we apply it ourselves
-    // based on the info we have handy.
-    // Time zone offsets from UTC
-    timezones[Timezone::CalcOffset(-12, 0)] = Timezone(-12, 0);
-    timezones[Timezone::CalcOffset(-12, 15)] = Timezone(-12, 15);
-    timezones[Timezone::CalcOffset(-12, 30)] = Timezone(-12, 30);
-    timezones[Timezone::CalcOffset(-12, 45)] = Timezone(-12, 45);
-    timezones[Timezone::CalcOffset(-11, 0)] = Timezone(-11, 0);
-    timezones[Timezone::CalcOffset(-11, 15)] = Timezone(-11, 15);
-    timezones[Timezone::CalcOffset(-11, 30)] = Timezone(-11, 30);
-    timezones[Timezone::CalcOffset(-11, 45)] = Timezone(-11, 45);
-    timezones[Timezone::CalcOffset(-10, 0)] = Timezone(-10, 0);
-    timezones[Timezone::CalcOffset(-10, 15)] = Timezone(-10, 15);
-    timezones[Timezone::CalcOffset(-10, 30)] = Timezone(-10, 30);
-    timezones[Timezone::CalcOffset(-10, 45)] = Timezone(-10, 45);
-    timezones[Timezone::CalcOffset(-9, 0)] = Timezone(-9, 0);
-    timezones[Timezone::CalcOffset(-9, 15)] = Timezone(-9, 15);
-    timezones[Timezone::CalcOffset(-9, 30)] = Timezone(-9, 30);
-    timezones[Timezone::CalcOffset(-9, 45)] = Timezone(-9, 45);
-    timezones[Timezone::CalcOffset(-8, 0)] = Timezone(-8, 0);
-    timezones[Timezone::CalcOffset(-8, 15)] = Timezone(-8, 15);
-    timezones[Timezone::CalcOffset(-8, 30)] = Timezone(-8, 30);
-    timezones[Timezone::CalcOffset(-8, 45)] = Timezone(-8, 45);
-    timezones[Timezone::CalcOffset(-7, 0)] = Timezone(-7, 0);
-    timezones[Timezone::CalcOffset(-7, 15)] = Timezone(-7, 15);
-    timezones[Timezone::CalcOffset(-7, 30)] = Timezone(-7, 30);
-    timezones[Timezone::CalcOffset(-7, 45)] = Timezone(-7, 45);
-    timezones[Timezone::CalcOffset(-6, 0)] = Timezone(-6, 0);
-    timezones[Timezone::CalcOffset(-6, 15)] = Timezone(-6, 15);
-    timezones[Timezone::CalcOffset(-6, 30)] = Timezone(-6, 30);
-    timezones[Timezone::CalcOffset(-6, 45)] = Timezone(-6, 45);
-    timezones[Timezone::CalcOffset(-5, 0)] = Timezone(-5, 0);
-    timezones[Timezone::CalcOffset(-5, 15)] = Timezone(-5, 15);
-    timezones[Timezone::CalcOffset(-5, 30)] = Timezone(-5, 30);
-    timezones[Timezone::CalcOffset(-5, 45)] = Timezone(-5, 45);
-    timezones[Timezone::CalcOffset(-4, 0)] = Timezone(-4, 0);
-    timezones[Timezone::CalcOffset(-4, 15)] = Timezone(-4, 15);
-    timezones[Timezone::CalcOffset(-4, 30)] = Timezone(-4, 30);
-    timezones[Timezone::CalcOffset(-4, 45)] = Timezone(-4, 45);
-    timezones[Timezone::CalcOffset(-3, 0)] = Timezone(-3, 0);
-    timezones[Timezone::CalcOffset(-3, 15)] = Timezone(-3, 15);
-    timezones[Timezone::CalcOffset(-3, 30)] = Timezone(-3, 30);
-    timezones[Timezone::CalcOffset(-3, 45)] = Timezone(-3, 45);
-    timezones[Timezone::CalcOffset(-2, 0)] = Timezone(-2, 0);
-    timezones[Timezone::CalcOffset(-2, 15)] = Timezone(-2, 15);
-    timezones[Timezone::CalcOffset(-2, 30)] = Timezone(-2, 30);
-    timezones[Timezone::CalcOffset(-2, 45)] = Timezone(-2, 45);
-    timezones[Timezone::CalcOffset(-1, 0)] = Timezone(-1, 0);
-    timezones[Timezone::CalcOffset(-1, 15)] = Timezone(-1, 15);
-    timezones[Timezone::CalcOffset(-1, 30)] = Timezone(-1, 30);
-    timezones[Timezone::CalcOffset(-1, 45)] = Timezone(-1, 45);
-    timezones[Timezone::CalcOffset(0, 0)] = Timezone(0, 0);
-    timezones[Timezone::CalcOffset(0, 15)] = Timezone(0, 15);
-    timezones[Timezone::CalcOffset(0, 30)] = Timezone(0, 30);
-    timezones[Timezone::CalcOffset(0, 45)] = Timezone(0, 45);
-    timezones[Timezone::CalcOffset(1, 0)] = Timezone(1, 0);
-    timezones[Timezone::CalcOffset(1, 15)] = Timezone(1, 15);
-    timezones[Timezone::CalcOffset(1, 30)] = Timezone(1, 30);
-    timezones[Timezone::CalcOffset(1, 45)] = Timezone(1, 45);
-    timezones[Timezone::CalcOffset(2, 0)] = Timezone(2, 0);
-    timezones[Timezone::CalcOffset(2, 15)] = Timezone(2, 15);
-    timezones[Timezone::CalcOffset(2, 30)] = Timezone(2, 30);
-    timezones[Timezone::CalcOffset(2, 45)] = Timezone(2, 45);
-    timezones[Timezone::CalcOffset(3, 0)] = Timezone(3, 0);
-    timezones[Timezone::CalcOffset(3, 15)] = Timezone(3, 15);
-    timezones[Timezone::CalcOffset(3, 30)] = Timezone(3, 30);
-    timezones[Timezone::CalcOffset(3, 45)] = Timezone(3, 45);
-    timezones[Timezone::CalcOffset(4, 0)] = Timezone(4, 0);
-    timezones[Timezone::CalcOffset(4, 15)] = Timezone(4, 15);
-    timezones[Timezone::CalcOffset(4, 30)] = Timezone(4, 30);
-    timezones[Timezone::CalcOffset(4, 45)] = Timezone(4, 45);
-    timezones[Timezone::CalcOffset(5, 0)] = Timezone(5, 0);
-    timezones[Timezone::CalcOffset(5, 15)] = Timezone(5, 15);
-    timezones[Timezone::CalcOffset(5, 30)] = Timezone(5, 30);
-    timezones[Timezone::CalcOffset(5, 45)] = Timezone(5, 45);
-    timezones[Timezone::CalcOffset(6, 0)] = Timezone(6, 0);
-    timezones[Timezone::CalcOffset(6, 15)] = Timezone(6, 15);
-    timezones[Timezone::CalcOffset(6, 30)] = Timezone(6, 30);
-    timezones[Timezone::CalcOffset(6, 45)] = Timezone(6, 45);
-    timezones[Timezone::CalcOffset(7, 0)] = Timezone(7, 0);
-    timezones[Timezone::CalcOffset(7, 15)] = Timezone(7, 15);
-    timezones[Timezone::CalcOffset(7, 30)] = Timezone(7, 30);
-    timezones[Timezone::CalcOffset(7, 45)] = Timezone(7, 45);
-    timezones[Timezone::CalcOffset(8, 0)] = Timezone(8, 0);
-    timezones[Timezone::CalcOffset(8, 15)] = Timezone(8, 15);
-    timezones[Timezone::CalcOffset(8, 30)] = Timezone(8, 30);
-    timezones[Timezone::CalcOffset(8, 45)] = Timezone(8, 45);
-    timezones[Timezone::CalcOffset(9, 0)] = Timezone(9, 0);
-    timezones[Timezone::CalcOffset(9, 15)] = Timezone(9, 15);
-    timezones[Timezone::CalcOffset(9, 30)] = Timezone(9, 30);
-    timezones[Timezone::CalcOffset(9, 45)] = Timezone(9, 45);
-    timezones[Timezone::CalcOffset(10, 0)] = Timezone(10, 0);
-    timezones[Timezone::CalcOffset(10, 15)] = Timezone(10, 15);
-    timezones[Timezone::CalcOffset(10, 30)] = Timezone(10, 30);
-    timezones[Timezone::CalcOffset(10, 45)] = Timezone(10, 45);
-    timezones[Timezone::CalcOffset(11, 0)] = Timezone(11, 0);
-    timezones[Timezone::CalcOffset(11, 15)] = Timezone(11, 15);
-    timezones[Timezone::CalcOffset(11, 30)] = Timezone(11, 30);
-    timezones[Timezone::CalcOffset(11, 45)] = Timezone(11, 45);
-    timezones[Timezone::CalcOffset(12, 0)] = Timezone(12, 0);
-    timezones[Timezone::CalcOffset(12, 15)] = Timezone(12, 15);
-    timezones[Timezone::CalcOffset(12, 30)] = Timezone(12, 30);
-    timezones[Timezone::CalcOffset(12, 45)] = Timezone(12, 45);
-    timezones[Timezone::CalcOffset(13, 0)] = Timezone(13, 0);
-    timezones[Timezone::CalcOffset(13, 15)] = Timezone(13, 15);
-    timezones[Timezone::CalcOffset(13, 30)] = Timezone(13, 30);
-    timezones[Timezone::CalcOffset(13, 45)] = Timezone(13, 45);
-    timezones[Timezone::CalcOffset(14, 0)] = Timezone(14, 0);
-    timezones[Timezone::CalcOffset(14, 15)] = Timezone(14, 15);
-    timezones[Timezone::CalcOffset(14, 30)] = Timezone(14, 30);
-    timezones[Timezone::CalcOffset(14, 45)] = Timezone(14, 45);
+struct BuiltinZone {
+    const char* name;
+    int gmtoff; // seconds
+    unsigned first;
+    unsigned count;
+    const char* rule;
+};
 
-    // Time zone names
-    timezones["ACDT"] = Timezone("ACDT", 10, 30);
-    timezones["ACST"] = Timezone("ACST", 9, 30);
-    timezones["ACT"] = Timezone("ACT", 8, 0);
-    timezones["ACWST"] = Timezone("ACWST", 8, 45);
-    timezones["ADT"] = Timezone("ADT", 3, 0);
-    timezones["AEDT"] = Timezone("AEDT", 11, 0);
-    timezones["AEST"] = Timezone("AEST", 10, 0);
-    timezones["AFT"] = Timezone("AFT", 4, 30);
-    timezones["AKDT"] = Timezone("AKDT", 8, 0);
-    timezones["AKST"] = Timezone("AKST", 9, 0);
-    timezones["ALMT"] = Timezone("ALMT", 6, 0);
-    timezones["AMST"] = Timezone("AMST", 3, 0);
-    timezones["AMT"] = Timezone("AMT", 4, 0);
-    timezones["ANAT"] = Timezone("ANAT", 12, 0);
-    timezones["AQTT"] = Timezone("AQTT", 5, 0);
-    timezones["ART"] = Timezone("ART", 3, 0);
-    timezones["ASEAN Common Time"] = Timezone("ASEAN Common Time", 8, 0);
-    timezones["AST"] = Timezone("AST", 4, 0);
-    timezones["AWST"] = Timezone("AWST", 8, 0);
-    timezones["AZOST"] = Timezone("AZOST", 0, 0);
-    timezones["AZOT"] = Timezone("AZOT", 1, 0);
-    timezones["AZT"] = Timezone("AZT", 4, 0);
-    timezones["Acre Time"] = Timezone("Acre Time", 5, 0);
-    timezones["Afghanistan Time"] = Timezone("Afghanistan Time", 4, 30);
-    timezones["Alaska Daylight Time"] = Timezone("Alaska Daylight Time", 8, 0);
-    timezones["Alaska Standard Time"] = Timezone("Alaska Standard Time", 9, 0);
-    timezones["Alma-Ata Time"] = Timezone("Alma-Ata Time", 6, 0);
-    timezones["Amazon Summer Time"] = Timezone("Amazon Summer Time", 3, 0);
-    timezones["Amazon Time"] = Timezone("Amazon Time", 4, 0);
-    timezones["Anadyr Time"] = Timezone("Anadyr Time", 12, 0);
-    timezones["Aqtobe Time"] = Timezone("Aqtobe Time", 5, 0);
-    timezones["Arabia Standard Time"] = Timezone("Arabia Standard Time", 3, 0);
-    timezones["Argentina Time"] = Timezone("Argentina Time", 3, 0);
-    timezones["Armenia Time"] = Timezone("Armenia Time", 4, 0);
-    timezones["Atlantic Daylight Time"] = Timezone("Atlantic Daylight Time", 3, 0);
-    timezones["Atlantic Standard Time"] = Timezone("Atlantic Standard Time", 4, 0);
-    timezones["Australian Central Daylight Saving Time"] = Timezone("Australian Central Daylight Saving Time", 10, 30);
-    timezones["Australian Central Standard Time"] = Timezone("Australian Central Standard Time", 9, 30);
-    timezones["Australian Central Western Standard Time"] = Timezone("Australian Central Western Standard Time", 8, 45);
-    timezones["Australian Eastern Daylight Saving Time"] = Timezone("Australian Eastern Daylight Saving Time", 11, 0);
-    timezones["Australian Eastern Standard Time"] = Timezone("Australian Eastern Standard Time", 10, 0);
-    timezones["Australian Western Standard Time"] = Timezone("Australian Western Standard Time", 8, 0);
-    timezones["Azerbaijan Time"] = Timezone("Azerbaijan Time", 4, 0);
-    timezones["Azores Standard Time"] = Timezone("Azores Standard Time", 1, 0);
-    timezones["Azores Summer Time"] = Timezone("Azores Summer Time", 0, 0);
-    timezones["BIOT"] = Timezone("BIOT", 6, 0);
-    timezones["BIT"] = Timezone("BIT", 12, 0);
-    timezones["BNT"] = Timezone("BNT", 8, 0);
-    timezones["BOT"] = Timezone("BOT", 4, 0);
-    timezones["BRST"] = Timezone("BRST", 2, 0);
-    timezones["BRT"] = Timezone("BRT", 3, 0);
-    timezones["BST"] = Timezone("BST", 1, 0);
-    timezones["BTT"] = Timezone("BTT", 6, 0);
-    timezones["Baker Island Time"] = Timezone("Baker Island Time", 12, 0);
-    timezones["Bangladesh Standard Time"] = Timezone("Bangladesh Standard Time", 6, 0);
-    timezones["Bhutan Time"] = Timezone("Bhutan Time", 6, 0);
-    timezones["Bolivia Time"] = Timezone("Bolivia Time", 4, 0);
-    timezones["Bougainville Standard Time"] = Timezone("Bougainville Standard Time", 11, 0);
-    timezones["Brasília Summer Time"] = Timezone("Brasília Summer Time", 2, 0);
-    timezones["Brasília Time"] = Timezone("Brasília Time", 3, 0);
-    timezones["British Indian Ocean Time"] = Timezone("British Indian Ocean Time", 6, 0);
-    timezones["British Summer Time"] = Timezone("British Summer Time", 1, 0);
-    timezones["Brunei Time"] = Timezone("Brunei Time", 8, 0);
-    timezones["CAT"] = Timezone("CAT", 2, 0);
-    timezones["CCT"] = Timezone("CCT", 6, 30);
-    timezones["CDT"] = Timezone("CDT", 4, 0);
-    timezones["CEST"] = Timezone("CEST", 2, 0);
-    timezones["CET"] = Timezone("CET", 1, 0);
-    timezones["CHADT"] = Timezone("CHADT", 13, 45);
-    timezones["CHAST"] = Timezone("CHAST", 12, 45);
-    timezones["CHOST"] = Timezone("CHOST", 9, 0);
-    timezones["CHOT"] = Timezone("CHOT", 8, 0);
-    timezones["CHST"] = Timezone("CHST", 10, 0);
-    timezones["CHUT"] = Timezone("CHUT", 10, 0);
-    timezones["CIST"] = Timezone("CIST", 8, 0);
-    timezones["CKT"] = Timezone("CKT", 10, 0);
-    timezones["CLST"] = Timezone("CLST", 3, 0);
-    timezones["CLT"] = Timezone("CLT", 4, 0);
-    timezones["COST"] = Timezone("COST", 4, 0);
-    timezones["COT"] = Timezone("COT", 5, 0);
-    timezones["CST"] = Timezone("CST", 5, 0);
-    timezones["CVT"] = Timezone("CVT", 1, 0);
-    timezones["CWST"] = Timezone("CWST", 8, 45);
-    timezones["CXT"] = Timezone("CXT", 7, 0);
-    timezones["Cape Verde Time"] = Timezone("Cape Verde Time", 1, 0);
-    timezones["Central Africa Time"] = Timezone("Central Africa Time", 2, 0);
-    timezones["Central Daylight Time"] = Timezone("Central Daylight Time", 5, 0);
-    timezones["Central European Summer Time"] = Timezone("Central European Summer Time", 2, 0);
-    timezones["Central European Time"] = Timezone("Central European Time", 1, 0);
-    timezones["Central Indonesia Time"] = Timezone("Central Indonesia Time", 8, 0);
-    timezones["Central Standard Time"] = Timezone("Central Standard Time", 6, 0);
-    timezones["Central Western Standard Time"] = Timezone("Central Western Standard Time", 8, 45);
-    timezones["Chagos Archipelago|Indian Ocean Time"] = Timezone("Chagos Archipelago|Indian Ocean Time", 3, 0);
-    timezones["Chamorro Standard Time"] = Timezone("Chamorro Standard Time", 10, 0);
-    timezones["Chatham Daylight Time"] = Timezone("Chatham Daylight Time", 13, 45);
-    timezones["Chatham Standard Time"] = Timezone("Chatham Standard Time", 12, 45);
-    timezones["Chile Standard Time"] = Timezone("Chile Standard Time", 4, 0);
-    timezones["Chile Summer Time"] = Timezone("Chile Summer Time", 3, 0);
-    timezones["China Standard Time"] = Timezone("China Standard Time", 8, 0);
-    timezones["Choibalsan Standard Time"] = Timezone("Choibalsan Standard Time", 8, 0);
-    timezones["Choibalsan Summer Time"] = Timezone("Choibalsan Summer Time", 9, 0);
-    timezones["Christmas Island Time"] = Timezone("Christmas Island Time", 7, 0);
-    timezones["Chuuk Time"] = Timezone("Chuuk Time", 10, 0);
-    timezones["Clipperton Island Standard Time"] = Timezone("Clipperton Island Standard Time", 8, 0);
-    timezones["Cocos Islands Time"] = Timezone("Cocos Islands Time", 6, 30);
-    timezones["Colombia Summer Time"] = Timezone("Colombia Summer Time", 4, 0);
-    timezones["Colombia Time"] = Timezone("Colombia Time", 5, 0);
-    timezones["Cook Island Time"] = Timezone("Cook Island Time", 10, 0);
-    timezones["Coordinated Universal Time"] = Timezone("Coordinated Universal Time", 0, 0);
-    timezones["Cuba Daylight Time"] = Timezone("Cuba Daylight Time", 4, 0);
-    timezones["Cuba Standard Time"] = Timezone("Cuba Standard Time", 5, 0);
-    timezones["DAVT"] = Timezone("DAVT", 7, 0);
-    timezones["DDUT"] = Timezone("DDUT", 10, 0);
-    timezones["DFT"] = Timezone("DFT", 1, 0);
-    timezones["Davis Time"] = Timezone("Davis Time", 7, 0);
-    timezones["Dumont d'Urville Time"] = Timezone("Dumont d'Urville Time", 10, 0);
-    timezones["EASST"] = Timezone("EASST", 5, 0);
-    timezones["EAST"] = Timezone("EAST", 6, 0);
-    timezones["EAT"] = Timezone("EAT", 3, 0);
-    timezones["ECT"] = Timezone("ECT", 5, 0);
-    timezones["EDT"] = Timezone("EDT", 4, 0);
-    timezones["EEST"] = Timezone("EEST", 3, 0);
-    timezones["EET"] = Timezone("EET", 2, 0);
-    timezones["EGST"] = Timezone("EGST", 0, 0);
-    timezones["EGT"] = Timezone("EGT", 1, 0);
-    timezones["EST"] = Timezone("EST", 5, 0);
-    timezones["East Africa Time"] = Timezone("East Africa Time", 3, 0);
-    timezones["Easter Island Standard Time"] = Timezone("Easter Island Standard Time", 6, 0);
-    timezones["Easter Island Summer Time"] = Timezone("Easter Island Summer Time", 5, 0);
-    timezones["Eastern Caribbean Time"] = Timezone("Eastern Caribbean Time", 4, 0);
-    timezones["Eastern Daylight Time"] = Timezone("Eastern Daylight Time", 4, 0);
-    timezones["Eastern European Summer Time"] = Timezone("Eastern European Summer Time", 3, 0);
-    timezones["Eastern European Time"] = Timezone("Eastern European Time", 2, 0);
-    timezones["Eastern Greenland Summer Time"] = Timezone("Eastern Greenland Summer Time", 0, 0);
-    timezones["Eastern Greenland Time"] = Timezone("Eastern Greenland Time", 1, 0);
-    timezones["Eastern Indonesian Time"] = Timezone("Eastern Indonesian Time", 9, 0);
-    timezones["Eastern Standard Time"] = Timezone("Eastern Standard Time", 5, 0);
-    timezones["Ecuador Time"] = Timezone("Ecuador Time", 5, 0);
-    timezones["FET"] = Timezone("FET", 3, 0);
-    timezones["FJT"] = Timezone("FJT", 12, 0);
-    timezones["FKST"] = Timezone("FKST", 3, 0);
-    timezones["FKT"] = Timezone("FKT", 4, 0);
-    timezones["FNT"] = Timezone("FNT", 2, 0);
-    timezones["Falkland Islands Summer Time"] = Timezone("Falkland Islands Summer Time", 3, 0);
-    timezones["Falkland Islands Time"] = Timezone("Falkland Islands Time", 4, 0);
-    timezones["Fernando de Noronha Time"] = Timezone("Fernando de Noronha Time", 2, 0);
-    timezones["Fiji Time"] = Timezone("Fiji Time", 12, 0);
-    timezones["French Guiana Time"] = Timezone("French Guiana Time", 3, 0);
-    timezones["French Southern and Antarctic Time"] = Timezone("French Southern and Antarctic Time", 5, 0);
-    timezones["Further-eastern European Time"] = Timezone("Further-eastern European Time", 3, 0);
-    timezones["GALT"] = Timezone("GALT", 6, 0);
-    timezones["GAMT"] = Timezone("GAMT", 9, 0);
-    timezones["GET"] = Timezone("GET", 4, 0);
-    timezones["GFT"] = Timezone("GFT", 3, 0);
-    timezones["GILT"] = Timezone("GILT", 12, 0);
-    timezones["GIT"] = Timezone("GIT", 9, 0);
-    timezones["GMT"] = Timezone("GMT", 0, 0);
-    timezones["GST"] = Timezone("GST", 4, 0);
-    timezones["GYT"] = Timezone("GYT", 4, 0);
-    timezones["Galápagos Time"] = Timezone("Galápagos Time", 6, 0);
-    timezones["Gambier Island Time"] = Timezone("Gambier Island Time", 9, 0);
-    timezones["Gambier Islands Time"] = Timezone("Gambier Islands Time", 9, 0);
-    timezones["Georgia Standard Time"] = Timezone("Georgia Standard Time", 4, 0);
-    timezones["Gilbert Island Time"] = Timezone("Gilbert Island Time", 12, 0);
-    timezones["Greenwich Mean Time"] = Timezone("Greenwich Mean Time", 0, 0);
-    timezones["Gulf Standard Time"] = Timezone("Gulf Standard Time", 4, 0);
-    timezones["Guyana Time"] = Timezone("Guyana Time", 4, 0);
-    timezones["HAEC"] = Timezone("HAEC", 2, 0);
-    timezones["HDT"] = Timezone("HDT", 9, 0);
-    timezones["HKT"] = Timezone("HKT", 8, 0);
-    timezones["HMT"] = Timezone("HMT", 5, 0);
-    timezones["HOVST"] = Timezone("HOVST", 8, 0);
-    timezones["HOVT"] = Timezone("HOVT", 7, 0);
-    timezones["HST"] = Timezone("HST", 10, 0);
-    timezones["Hawaii–Aleutian Daylight Time"] = Timezone("Hawaii–Aleutian Daylight Time", 9, 0);
-    timezones["Hawaii–Aleutian Standard Time"] = Timezone("Hawaii–Aleutian Standard Time", 10, 0);
-    timezones["Heard and McDonald Islands"] = Timezone("Heard and McDonald Islands", 5, 0);
-    timezones["Heure Avancée d'Europe Centrale"] = Timezone("Heure Avancée d'Europe Centrale", 2, 0);
-    timezones["Hong Kong Time"] = Timezone("Hong Kong Time", 8, 0);
-    timezones["Hovd Summer Time"] = Timezone("Hovd Summer Time", 8, 0);
-    timezones["Hovd Time"] = Timezone("Hovd Time", 7, 0);
-    timezones["ICT"] = Timezone("ICT", 7, 0);
-    timezones["IDLW"] = Timezone("IDLW", 12, 0);
-    timezones["IDT"] = Timezone("IDT", 3, 0);
-    timezones["IOT"] = Timezone("IOT", 3, 0);
-    timezones["IRDT"] = Timezone("IRDT", 4, 30);
-    timezones["IRKT"] = Timezone("IRKT", 8, 0);
-    timezones["IRST"] = Timezone("IRST", 3, 30);
-    timezones["IST"] = Timezone("IST", 2, 0);
-    timezones["Indian Standard Time"] = Timezone("Indian Standard Time", 5, 30);
-    timezones["Indochina Time"] = Timezone("Indochina Time", 7, 0);
-    timezones["Iran Daylight Time"] = Timezone("Iran Daylight Time", 4, 30);
-    timezones["Iran Standard Time"] = Timezone("Iran Standard Time", 3, 30);
-    timezones["Irish Standard Time"] = Timezone("Irish Standard Time", 1, 0);
-    timezones["Irkutsk Time"] = Timezone("Irkutsk Time", 8, 0);
-    timezones["Israel Daylight Time"] = Timezone("Israel Daylight Time", 3, 0);
-    timezones["Israel Standard Time"] = Timezone("Israel Standard Time", 2, 0);
-    timezones["JST"] = Timezone("JST", 9, 0);
-    timezones["Japan Standard Time"] = Timezone("Japan Standard Time", 9, 0);
-    timezones["KALT"] = Timezone("KALT", 2, 0);
-    timezones["KGT"] = Timezone("KGT", 6, 0);
-    timezones["KOST"] = Timezone("KOST", 11, 0);
-    timezones["KRAT"] = Timezone("KRAT", 7, 0);
-    timezones["KST"] = Timezone("KST", 9, 0);
-    timezones["Kaliningrad Time"] = Timezone("Kaliningrad Time", 2, 0);
-    timezones["Kamchatka Time"] = Timezone("Kamchatka Time", 12, 0);
-    timezones["Korea Standard Time"] = Timezone("Korea Standard Time", 9, 0);
-    timezones["Kosrae Time"] = Timezone("Kosrae Time", 11, 0);
-    timezones["Krasnoyarsk Time"] = Timezone("Krasnoyarsk Time", 7, 0);
-    timezones["Kyrgyzstan Time"] = Timezone("Kyrgyzstan Time", 6, 0);
-    timezones["LHST"] = Timezone("LHST", 11, 0);
-    timezones["LINT"] = Timezone("LINT", 14, 0);
-    timezones["Line Islands"] = Timezone("Line Islands", 14, 0);
-    timezones["Lord Howe Standard Time"] = Timezone("Lord Howe Standard Time", 10, 30);
-    timezones["Lord Howe Summer Time"] = Timezone("Lord Howe Summer Time", 11, 0);
-    timezones["MAGT"] = Timezone("MAGT", 12, 0);
-    timezones["MART"] = Timezone("MART", 9, 30);
-    timezones["MAWT"] = Timezone("MAWT", 5, 0);
-    timezones["MDT"] = Timezone("MDT", 6, 0);
-    timezones["MEST"] = Timezone("MEST", 2, 0);
-    timezones["MET"] = Timezone("MET", 1, 0);
-    timezones["MHT"] = Timezone("MHT", 12, 0);
-    timezones["MIST"] = Timezone("MIST", 11, 0);
-    timezones["MIT"] = Timezone("MIT", 9, 30);
-    timezones["MMT"] = Timezone("MMT", 6, 30);
-    timezones["MSK"] = Timezone("MSK", 3, 0);
-    timezones["MST"] = Timezone("MST", 7, 0);
-    timezones["MUT"] = Timezone("MUT", 4, 0);
-    timezones["MVT"] = Timezone("MVT", 5, 0);
-    timezones["MYT"] = Timezone("MYT", 8, 0);
-    timezones["Macquarie Island Station Time"] = Timezone("Macquarie Island Station Time", 11, 0);
-    timezones["Magadan Time"] = Timezone("Magadan Time", 12, 0);
-    timezones["Malaysia Standard Time"] = Timezone("Malaysia Standard Time", 8, 0);
-    timezones["Malaysia Time"] = Timezone("Malaysia Time", 8, 0);
-    timezones["Maldives Time"] = Timezone("Maldives Time", 5, 0);
-    timezones["Marquesas Islands Time"] = Timezone("Marquesas Islands Time", 9, 30);
-    timezones["Marshall Islands Time"] = Timezone("Marshall Islands Time", 12, 0);
-    timezones["Mauritius Time"] = Timezone("Mauritius Time", 4, 0);
-    timezones["Mawson Station Time"] = Timezone("Mawson Station Time", 5, 0);
-    timezones["Middle European Summer Time"] = Timezone("Middle European Summer Time", 2, 0);
-    timezones["Middle European Time"] = Timezone("Middle European Time", 1, 0);
-    timezones["Moscow Time"] = Timezone("Moscow Time", 3, 0);
-    timezones["Mountain Daylight Time"] = Timezone("Mountain Daylight Time", 6, 0);
-    timezones["Mountain Standard Time"] = Timezone("Mountain Standard Time", 7, 0);
-    timezones["Myanmar Standard Time"] = Timezone("Myanmar Standard Time", 6, 30);
-    timezones["NCT"] = Timezone("NCT", 11, 0);
-    timezones["NDT"] = Timezone("NDT", 2, 30);
-    timezones["NFT"] = Timezone("NFT", 11, 0);
-    timezones["NOVT"] = Timezone("NOVT", 7, 0);
-    timezones["NPT"] = Timezone("NPT", 5, 45);
-    timezones["NST"] = Timezone("NST", 3, 30);
-    timezones["NT"] = Timezone("NT", 3, 30);
-    timezones["NUT"] = Timezone("NUT", 11, 0);
-    timezones["NZDT"] = Timezone("NZDT", 13, 0);
-    timezones["NZST"] = Timezone("NZST", 12, 0);
-    timezones["Nepal Time"] = Timezone("Nepal Time", 5, 45);
-    timezones["New Caledonia Time"] = Timezone("New Caledonia Time", 11, 0);
-    timezones["New Zealand Daylight Time"] = Timezone("New Zealand Daylight Time", 13, 0);
-    timezones["New Zealand Standard Time"] = Timezone("New Zealand Standard Time", 12, 0);
-    timezones["Newfoundland Daylight Time"] = Timezone("Newfoundland Daylight Time", 2, 30);
-    timezones["Newfoundland Standard Time"] = Timezone("Newfoundland Standard Time", 3, 30);
-    timezones["Newfoundland Time"] = Timezone("Newfoundland Time", 3, 30);
-    timezones["Niue Time"] = Timezone("Niue Time", 11, 0);
-    timezones["Norfolk Island Time"] = Timezone("Norfolk Island Time", 11, 0);
-    timezones["Novosibirsk Time "] = Timezone("Novosibirsk Time ", 7, 0);
-    timezones["OMST"] = Timezone("OMST", 6, 0);
-    timezones["ORAT"] = Timezone("ORAT", 5, 0);
-    timezones["Omsk Time"] = Timezone("Omsk Time", 6, 0);
-    timezones["Oral Time"] = Timezone("Oral Time", 5, 0);
-    timezones["PDT"] = Timezone("PDT", 7, 0);
-    timezones["PET"] = Timezone("PET", 5, 0);
-    timezones["PETT"] = Timezone("PETT", 12, 0);
-    timezones["PGT"] = Timezone("PGT", 10, 0);
-    timezones["PHOT"] = Timezone("PHOT", 13, 0);
-    timezones["PHST"] = Timezone("PHST", 8, 0);
-    timezones["PHT"] = Timezone("PHT", 8, 0);
-    timezones["PKT"] = Timezone("PKT", 5, 0);
-    timezones["PMDT"] = Timezone("PMDT", 2, 0);
-    timezones["PMST"] = Timezone("PMST", 3, 0);
-    timezones["PONT"] = Timezone("PONT", 11, 0);
-    timezones["PST"] = Timezone("PST", 8, 0);
-    timezones["PWT"] = Timezone("PWT", 9, 0);
-    timezones["PYST"] = Timezone("PYST", 3, 0);
-    timezones["PYT"] = Timezone("PYT", 4, 0);
-    timezones["Pacific Daylight Time"] = Timezone("Pacific Daylight Time", 7, 0);
-    timezones["Pacific Standard Time"] = Timezone("Pacific Standard Time", 8, 0);
-    timezones["Pakistan Standard Time"] = Timezone("Pakistan Standard Time", 5, 0);
-    timezones["Palau Time"] = Timezone("Palau Time", 9, 0);
-    timezones["Papua New Guinea Time"] = Timezone("Papua New Guinea Time", 10, 0);
-    timezones["Paraguay Summer Time"] = Timezone("Paraguay Summer Time", 3, 0);
-    timezones["Paraguay Time"] = Timezone("Paraguay Time", 4, 0);
-    timezones["Peru Time"] = Timezone("Peru Time", 5, 0);
-    timezones["Philippine Standard Time"] = Timezone("Philippine Standard Time", 8, 0);
-    timezones["Philippine Time"] = Timezone("Philippine Time", 8, 0);
-    timezones["Phoenix Island Time"] = Timezone("Phoenix Island Time", 13, 0);
-    timezones["Pohnpei Standard Time"] = Timezone("Pohnpei Standard Time", 11, 0);
-    timezones["RET"] = Timezone("RET", 4, 0);
-    timezones["ROTT"] = Timezone("ROTT", 3, 0);
-    timezones["Rothera Research Station Time"] = Timezone("Rothera Research Station Time", 3, 0);
-    timezones["Réunion Time"] = Timezone("Réunion Time", 4, 0);
-    timezones["SAKT"] = Timezone("SAKT", 11, 0);
-    timezones["SAMT"] = Timezone("SAMT", 4, 0);
-    timezones["SAST"] = Timezone("SAST", 2, 0);
-    timezones["SBT"] = Timezone("SBT", 11, 0);
-    timezones["SCT"] = Timezone("SCT", 4, 0);
-    timezones["SDT"] = Timezone("SDT", 10, 0);
-    timezones["SGT"] = Timezone("SGT", 8, 0);
-    timezones["SLST"] = Timezone("SLST", 5, 30);
-    timezones["SRET"] = Timezone("SRET", 11, 0);
-    timezones["SRT"] = Timezone("SRT", 3, 0);
-    timezones["SST"] = Timezone("SST", 8, 0);
-    timezones["SYOT"] = Timezone("SYOT", 3, 0);
-    timezones["Saint Pierre and Miquelon Daylight Time"] = Timezone("Saint Pierre and Miquelon Daylight Time", 2, 0);
-    timezones["Saint Pierre and Miquelon Standard Time"] = Timezone("Saint Pierre and Miquelon Standard Time", 3, 0);
-    timezones["Sakhalin Island Time"] = Timezone("Sakhalin Island Time", 11, 0);
-    timezones["Samara Time"] = Timezone("Samara Time", 4, 0);
-    timezones["Samoa Daylight Time"] = Timezone("Samoa Daylight Time", 10, 0);
-    timezones["Samoa Standard Time"] = Timezone("Samoa Standard Time", 11, 0);
-    timezones["Seychelles Time"] = Timezone("Seychelles Time", 4, 0);
-    timezones["Showa Station Time"] = Timezone("Showa Station Time", 3, 0);
-    timezones["Singapore Standard Time"] = Timezone("Singapore Standard Time", 8, 0);
-    timezones["Singapore Time"] = Timezone("Singapore Time", 8, 0);
-    timezones["Solomon Islands Time"] = Timezone("Solomon Islands Time", 11, 0);
-    timezones["South African Standard Time"] = Timezone("South African Standard Time", 2, 0);
-    timezones["South Georgia and the South Sandwich Islands Time"] = Timezone("South Georgia and the South Sandwich Islands Time", 2, 0);
-    timezones["Srednekolymsk Time"] = Timezone("Srednekolymsk Time", 11, 0);
-    timezones["Sri Lanka Standard Time"] = Timezone("Sri Lanka Standard Time", 5, 30);
-    timezones["Suriname Time"] = Timezone("Suriname Time", 3, 0);
-    timezones["TAHT"] = Timezone("TAHT", 10, 0);
-    timezones["TFT"] = Timezone("TFT", 5, 0);
-    timezones["THA"] = Timezone("THA", 7, 0);
-    timezones["TJT"] = Timezone("TJT", 5, 0);
-    timezones["TKT"] = Timezone("TKT", 13, 0);
-    timezones["TLT"] = Timezone("TLT", 9, 0);
-    timezones["TMT"] = Timezone("TMT", 5, 0);
-    timezones["TOT"] = Timezone("TOT", 13, 0);
-    timezones["TRT"] = Timezone("TRT", 3, 0);
-    timezones["TVT"] = Timezone("TVT", 12, 0);
-    timezones["Tahiti Time"] = Timezone("Tahiti Time", 10, 0);
-    timezones["Tajikistan Time"] = Timezone("Tajikistan Time", 5, 0);
-    timezones["Thailand Standard Time"] = Timezone("Thailand Standard Time", 7, 0);
-    timezones["Timor Leste Time"] = Timezone("Timor Leste Time", 9, 0);
-    timezones["Tokelau Time"] = Timezone("Tokelau Time", 13, 0);
-    timezones["Tonga Time"] = Timezone("Tonga Time", 13, 0);
-    timezones["Turkey Time"] = Timezone("Turkey Time", 3, 0);
-    timezones["Turkmenistan Time"] = Timezone("Turkmenistan Time", 5, 0);
-    timezones["Tuvalu Time"] = Timezone("Tuvalu Time", 12, 0);
-    timezones["ULAST"] = Timezone("ULAST", 9, 0);
-    timezones["ULAT"] = Timezone("ULAT", 8, 0);
-    timezones["UTC"] = Timezone("UTC", 0, 0);
-    timezones["UYST"] = Timezone("UYST", 2, 0);
-    timezones["UYT"] = Timezone("UYT", 3, 0);
-    timezones["UZT"] = Timezone("UZT", 5, 0);
-    timezones["Ulaanbaatar Standard Time"] = Timezone("Ulaanbaatar Standard Time", 8, 0);
-    timezones["Ulaanbaatar Summer Time"] = Timezone("Ulaanbaatar Summer Time", 9, 0);
-    timezones["Uruguay Standard Time"] = Timezone("Uruguay Standard Time", 3, 0);
-    timezones["Uruguay Summer Time"] = Timezone("Uruguay Summer Time", 2, 0);
-    timezones["Uzbekistan Time"] = Timezone("Uzbekistan Time", 5, 0);
-    timezones["VET"] = Timezone("VET", 4, 0);
-    timezones["VLAT"] = Timezone("VLAT", 10, 0);
-    timezones["VOLT"] = Timezone("VOLT", 3, 0);
-    timezones["VOST"] = Timezone("VOST", 6, 0);
-    timezones["VUT"] = Timezone("VUT", 11, 0);
-    timezones["Vanuatu"] = Timezone("Vanuatu", 11, 0);
-    timezones["Venezuelan Standard Time"] = Timezone("Venezuelan Standard Time", 4, 0);
-    timezones["Vladivostok Time"] = Timezone("Vladivostok Time", 10, 0);
-    timezones["Volgograd Time"] = Timezone("Volgograd Time", 3, 0);
-    timezones["Vostok Station Time"] = Timezone("Vostok Station Time", 6, 0);
-    timezones["WAKT"] = Timezone("WAKT", 12, 0);
-    timezones["WAST"] = Timezone("WAST", 2, 0);
-    timezones["WAT"] = Timezone("WAT", 1, 0);
-    timezones["WEST"] = Timezone("WEST", 1, 0);
-    timezones["WET"] = Timezone("WET", 0, 0);
-    timezones["WGST"] = Timezone("WGST", 2, 0);
-    timezones["WGT"] = Timezone("WGT", 3, 0);
-    timezones["WIB"] = Timezone("WIB", 7, 0);
-    timezones["WIT"] = Timezone("WIT", 9, 0);
-    timezones["WITA"] = Timezone("WITA", 8, 0);
-    timezones["WST"] = Timezone("WST", 8, 0);
-    timezones["Wake Island Time"] = Timezone("Wake Island Time", 12, 0);
-    timezones["West Africa Summer Time"] = Timezone("West Africa Summer Time", 2, 0);
-    timezones["West Africa Time"] = Timezone("West Africa Time", 1, 0);
-    timezones["West Greenland Summer Time"] = Timezone("West Greenland Summer Time", 2, 0);
-    timezones["West Greenland Time"] = Timezone("West Greenland Time", 3, 0);
-    timezones["Western European Summer Time"] = Timezone("Western European Summer Time", 1, 0);
-    timezones["Western European Time"] = Timezone("Western European Time", 0, 0);
-    timezones["Western Indonesian Time"] = Timezone("Western Indonesian Time", 7, 0);
-    timezones["Western Standard Time"] = Timezone("Western Standard Time", 8, 0);
-    timezones["YAKT"] = Timezone("YAKT", 9, 0);
-    timezones["YEKT"] = Timezone("YEKT", 5, 0);
-    timezones["Yakutsk Time"] = Timezone("Yakutsk Time", 9, 0);
-    timezones["Yekaterinburg Time"] = Timezone("Yekaterinburg Time", 5, 0);
+static constexpr unsigned BuiltinZoneCount = 500;
 
-    initialized = true;
-    return timezones;
-}
+static constexpr const char* BuiltinAbbreviations[] = {
+    "",
+};
+
+static constexpr BuiltinTransition BuiltinTransitions[] = {
+    {0, 0, 0, 0}, // unused
+};
+
+static constexpr BuiltinZone BuiltinZones[] = {
+    {"UTC", 0, 0, 0, ""},
+    {"ACDT", 37800, 0, 0, ""},
+    {"ACST", 34200, 0, 0, ""},
+    {"ACT", 28800, 0, 0, ""},
+    {"ACWST", 31500, 0, 0, ""},
+    {"ADT", 10800, 0, 0, ""},
+    {"AEDT", 39600, 0, 0, ""},
+    {"AEST", 36000, 0, 0, ""},
+    {"AFT", 16200, 0, 0, ""},
+    {"AKDT", 28800, 0, 0, ""},
+    {"AKST", 32400, 0, 0, ""},
+    {"ALMT", 21600, 0, 0, ""},
+    {"AMST", 10800, 0, 0, ""},
+    {"AMT", 14400, 0, 0, ""},
+    {"ANAT", 43200, 0, 0, ""},
+    {"AQTT", 18000, 0, 0, ""},
+    {"ART", 10800, 0, 0, ""},
+    {"ASEAN Common Time", 28800, 0, 0, ""},
+    {"AST", 14400, 0, 0, ""},
+    {"AWST", 28800, 0, 0, ""},
+    {"AZOST", 0, 0, 0, ""},
+    {"AZOT", 3600, 0, 0, ""},
+    {"AZT", 14400, 0, 0, ""},
+    {"Acre Time", 18000, 0, 0, ""},
+    {"Afghanistan Time", 16200, 0, 0, ""},
+    {"Alaska Daylight Time", 28800, 0, 0, ""},
+    {"Alaska Standard Time", 32400, 0, 0, ""},
+    {"Alma-Ata Time", 21600, 0, 0, ""},
+    {"Amazon Summer Time", 10800, 0, 0, ""},
+    {"Amazon Time", 14400, 0, 0, ""},
+    {"Anadyr Time", 43200, 0, 0, ""},
+    {"Aqtobe Time", 18000, 0, 0, ""},
+    {"Arabia Standard Time", 10800, 0, 0, ""},
+    {"Argentina Time", 10800, 0, 0, ""},
+    {"Armenia Time", 14400, 0, 0, ""},
+    {"Atlantic Daylight Time", 10800, 0, 0, ""},
+    {"Atlantic Standard Time", 14400, 0, 0, ""},
+    {"Australian Central Daylight Saving Time", 37800, 0, 0, ""},
+    {"Australian Central Standard Time", 34200, 0, 0, ""},
+    {"Australian Central Western Standard Time", 31500, 0, 0, ""},
+    {"Australian Eastern Daylight Saving Time", 39600, 0, 0, ""},
+    {"Australian Eastern Standard Time", 36000, 0, 0, ""},
+    {"Australian Western Standard Time", 28800, 0, 0, ""},
+    {"Azerbaijan Time", 14400, 0, 0, ""},
+    {"Azores Standard Time", 3600, 0, 0, ""},
+    {"Azores Summer Time", 0, 0, 0, ""},
+    {"BIOT", 21600, 0, 0, ""},
+    {"BIT", 43200, 0, 0, ""},
+    {"BNT", 28800, 0, 0, ""},
+    {"BOT", 14400, 0, 0, ""},
+    {"BRST", 7200, 0, 0, ""},
+    {"BRT", 10800, 0, 0, ""},
+    {"BST", 3600, 0, 0, ""},
+    {"BTT", 21600, 0, 0, ""},
+    {"Baker Island Time", 43200, 0, 0, ""},
+    {"Bangladesh Standard Time", 21600, 0, 0, ""},
+    {"Bhutan Time", 21600, 0, 0, ""},
+    {"Bolivia Time", 14400, 0, 0, ""},
+    {"Bougainville Standard Time", 39600, 0, 0, ""},
+    {"Brasília Summer Time", 7200, 0, 0, ""},
+    {"Brasília Time", 10800, 0, 0, ""},
+    {"British Indian Ocean Time", 21600, 0, 0, ""},
+    {"British Summer Time", 3600, 0, 0, ""},
+    {"Brunei Time", 28800, 0, 0, ""},
+    {"CAT", 7200, 0, 0, ""},
+    {"CCT", 23400, 0, 0, ""},
+    {"CDT", 14400, 0, 0, ""},
+    {"CEST", 7200, 0, 0, ""},
+    {"CET", 3600, 0, 0, ""},
+    {"CHADT", 49500, 0, 0, ""},
+    {"CHAST", 45900, 0, 0, ""},
+    {"CHOST", 32400, 0, 0, ""},
+    {"CHOT", 28800, 0, 0, ""},
+    {"CHST", 36000, 0, 0, ""},
+    {"CHUT", 36000, 0, 0, ""},
+    {"CIST", 28800, 0, 0, ""},
+    {"CKT", 36000, 0, 0, ""},
+    {"CLST", 10800, 0, 0, ""},
+    {"CLT", 14400, 0, 0, ""},
+    {"COST", 14400, 0, 0, ""},
+    {"COT", 18000, 0, 0, ""},
+    {"CST", 18000, 0, 0, ""},
+    {"CVT", 3600, 0, 0, ""},
+    {"CWST", 31500, 0, 0, ""},
+    {"CXT", 25200, 0, 0, ""},
+    {"Cape Verde Time", 3600, 0, 0, ""},
+    {"Central Africa Time", 7200, 0, 0, ""},
+    {"Central Daylight Time", 18000, 0, 0, ""},
+    {"Central European Summer Time", 7200, 0, 0, ""},
+    {"Central European Time", 3600, 0, 0, ""},
+    {"Central Indonesia Time", 28800, 0, 0, ""},
+    {"Central Standard Time", 21600, 0, 0, ""},
+    {"Central Western Standard Time", 31500, 0, 0, ""},
+    {"Chagos Archipelago|Indian Ocean Time", 10800, 0, 0, ""},
+    {"Chamorro Standard Time", 36000, 0, 0, ""},
+    {"Chatham Daylight Time", 49500, 0, 0, ""},
+    {"Chatham Standard Time", 45900, 0, 0, ""},
+    {"Chile Standard Time", 14400, 0, 0, ""},
+    {"Chile Summer Time", 10800, 0, 0, ""},
+    {"China Standard Time", 28800, 0, 0, ""},
+    {"Choibalsan Standard Time", 28800, 0, 0, ""},
+    {"Choibalsan Summer Time", 32400, 0, 0, ""},
+    {"Christmas Island Time", 25200, 0, 0, ""},
+    {"Chuuk Time", 36000, 0, 0, ""},
+    {"Clipperton Island Standard Time", 28800, 0, 0, ""},
+    {"Cocos Islands Time", 23400, 0, 0, ""},
+    {"Colombia Summer Time", 14400, 0, 0, ""},
+    {"Colombia Time", 18000, 0, 0, ""},
+    {"Cook Island Time", 36000, 0, 0, ""},
+    {"Coordinated Universal Time", 0, 0, 0, ""},
+    {"Cuba Daylight Time", 14400, 0, 0, ""},
+    {"Cuba Standard Time", 18000, 0, 0, ""},
+    {"DAVT", 25200, 0, 0, ""},
+    {"DDUT", 36000, 0, 0, ""},
+    {"DFT", 3600, 0, 0, ""},
+    {"Davis Time", 25200, 0, 0, ""},
+    {"Dumont d'Urville Time", 36000, 0, 0, ""},
+    {"EASST", 18000, 0, 0, ""},
+    {"EAST", 21600, 0, 0, ""},
+    {"EAT", 10800, 0, 0, ""},
+    {"ECT", 18000, 0, 0, ""},
+    {"EDT", 14400, 0, 0, ""},
+    {"EEST", 10800, 0, 0, ""},
+    {"EET", 7200, 0, 0, ""},
+    {"EGST", 0, 0, 0, ""},
+    {"EGT", 3600, 0, 0, ""},
+    {"EST", 18000, 0, 0, ""},
+    {"East Africa Time", 10800, 0, 0, ""},
+    {"Easter Island Standard Time", 21600, 0, 0, ""},
+    {"Easter Island Summer Time", 18000, 0, 0, ""},
+    {"Eastern Caribbean Time", 14400, 0, 0, ""},
+    {"Eastern Daylight Time", 14400, 0, 0, ""},
+    {"Eastern European Summer Time", 10800, 0, 0, ""},
+    {"Eastern European Time", 7200, 0, 0, ""},
+    {"Eastern Greenland Summer Time", 0, 0, 0, ""},
+    {"Eastern Greenland Time", 3600, 0, 0, ""},
+    {"Eastern Indonesian Time", 32400, 0, 0, ""},
+    {"Eastern Standard Time", 18000, 0, 0, ""},
+    {"Ecuador Time", 18000, 0, 0, ""},
+    {"FET", 10800, 0, 0, ""},
+    {"FJT", 43200, 0, 0, ""},
+    {"FKST", 10800, 0, 0, ""},
+    {"FKT", 14400, 0, 0, ""},
+    {"FNT", 7200, 0, 0, ""},
+    {"Falkland Islands Summer Time", 10800, 0, 0, ""},
+    {"Falkland Islands Time", 14400, 0, 0, ""},
+    {"Fernando de Noronha Time", 7200, 0, 0, ""},
+    {"Fiji Time", 43200, 0, 0, ""},
+    {"French Guiana Time", 10800, 0, 0, ""},
+    {"French Southern and Antarctic Time", 18000, 0, 0, ""},
+    {"Further-eastern European Time", 10800, 0, 0, ""},
+    {"GALT", 21600, 0, 0, ""},
+    {"GAMT", 32400, 0, 0, ""},
+    {"GET", 14400, 0, 0, ""},
+    {"GFT", 10800, 0, 0, ""},
+    {"GILT", 43200, 0, 0, ""},
+    {"GIT", 32400, 0, 0, ""},
+    {"GMT", 0, 0, 0, ""},
+    {"GST", 14400, 0, 0, ""},
+    {"GYT", 14400, 0, 0, ""},
+    {"Galápagos Time", 21600, 0, 0, ""},
+    {"Gambier Island Time", 32400, 0, 0, ""},
+    {"Gambier Islands Time", 32400, 0, 0, ""},
+    {"Georgia Standard Time", 14400, 0, 0, ""},
+    {"Gilbert Island Time", 43200, 0, 0, ""},
+    {"Greenwich Mean Time", 0, 0, 0, ""},
+    {"Gulf Standard Time", 14400, 0, 0, ""},
+    {"Guyana Time", 14400, 0, 0, ""},
+    {"HAEC", 7200, 0, 0, ""},
+    {"HDT", 32400, 0, 0, ""},
+    {"HKT", 28800, 0, 0, ""},
+    {"HMT", 18000, 0, 0, ""},
+    {"HOVST", 28800, 0, 0, ""},
+    {"HOVT", 25200, 0, 0, ""},
+    {"HST", 36000, 0, 0, ""},
+    {"Hawaii–Aleutian Daylight Time", 32400, 0, 0, ""},
+    {"Hawaii–Aleutian Standard Time", 36000, 0, 0, ""},
+    {"Heard and McDonald Islands", 18000, 0, 0, ""},
+    {"Heure Avancée d'Europe Centrale", 7200, 0, 0, ""},
+    {"Hong Kong Time", 28800, 0, 0, ""},
+    {"Hovd Summer Time", 28800, 0, 0, ""},
+    {"Hovd Time", 25200, 0, 0, ""},
+    {"ICT", 25200, 0, 0, ""},
+    {"IDLW", 43200, 0, 0, ""},
+    {"IDT", 10800, 0, 0, ""},
+    {"IOT", 10800, 0, 0, ""},
+    {"IRDT", 16200, 0, 0, ""},
+    {"IRKT", 28800, 0, 0, ""},
+    {"IRST", 12600, 0, 0, ""},
+    {"IST", 7200, 0, 0, ""},
+    {"Indian Standard Time", 19800, 0, 0, ""},
+    {"Indochina Time", 25200, 0, 0, ""},
+    {"Iran Daylight Time", 16200, 0, 0, ""},
+    {"Iran Standard Time", 12600, 0, 0, ""},
+    {"Irish Standard Time", 3600, 0, 0, ""},
+    {"Irkutsk Time", 28800, 0, 0, ""},
+    {"Israel Daylight Time", 10800, 0, 0, ""},
+    {"Israel Standard Time", 7200, 0, 0, ""},
+    {"JST", 32400, 0, 0, ""},
+    {"Japan Standard Time", 32400, 0, 0, ""},
+    {"KALT", 7200, 0, 0, ""},
+    {"KGT", 21600, 0, 0, ""},
+    {"KOST", 39600, 0, 0, ""},
+    {"KRAT", 25200, 0, 0, ""},
+    {"KST", 32400, 0, 0, ""},
+    {"Kaliningrad Time", 7200, 0, 0, ""},
+    {"Kamchatka Time", 43200, 0, 0, ""},
+    {"Korea Standard Time", 32400, 0, 0, ""},
+    {"Kosrae Time", 39600, 0, 0, ""},
+    {"Krasnoyarsk Time", 25200, 0, 0, ""},
+    {"Kyrgyzstan Time", 21600, 0, 0, ""},
+    {"LHST", 39600, 0, 0, ""},
+    {"LINT", 50400, 0, 0, ""},
+    {"Line Islands", 50400, 0, 0, ""},
+    {"Lord Howe Standard Time", 37800, 0, 0, ""},
+    {"Lord Howe Summer Time", 39600, 0, 0, ""},
+    {"MAGT", 43200, 0, 0, ""},
+    {"MART", 34200, 0, 0, ""},
+    {"MAWT", 18000, 0, 0, ""},
+    {"MDT", 21600, 0, 0, ""},
+    {"MEST", 7200, 0, 0, ""},
+    {"MET", 3600, 0, 0, ""},
+    {"MHT", 43200, 0, 0, ""},
+    {"MIST", 39600, 0, 0, ""},
+    {"MIT", 34200, 0, 0, ""},
+    {"MMT", 23400, 0, 0, ""},
+    {"MSK", 10800, 0, 0, ""},
+    {"MST", 25200, 0, 0, ""},
+    {"MUT", 14400, 0, 0, ""},
+    {"MVT", 18000, 0, 0, ""},
+    {"MYT", 28800, 0, 0, ""},
+    {"Macquarie Island Station Time", 39600, 0, 0, ""},
+    {"Magadan Time", 43200, 0, 0, ""},
+    {"Malaysia Standard Time", 28800, 0, 0, ""},
+    {"Malaysia Time", 28800, 0, 0, ""},
+    {"Maldives Time", 18000, 0, 0, ""},
+    {"Marquesas Islands Time", 34200, 0, 0, ""},
+    {"Marshall Islands Time", 43200, 0, 0, ""},
+    {"Mauritius Time", 14400, 0, 0, ""},
+    {"Mawson Station Time", 18000, 0, 0, ""},
+    {"Middle European Summer Time", 7200, 0, 0, ""},
+    {"Middle European Time", 3600, 0, 0, ""},
+    {"Moscow Time", 10800, 0, 0, ""},
+    {"Mountain Daylight Time", 21600, 0, 0, ""},
+    {"Mountain Standard Time", 25200, 0, 0, ""},
+    {"Myanmar Standard Time", 23400, 0, 0, ""},
+    {"NCT", 39600, 0, 0, ""},
+    {"NDT", 9000, 0, 0, ""},
+    {"NFT", 39600, 0, 0, ""},
+    {"NOVT", 25200, 0, 0, ""},
+    {"NPT", 20700, 0, 0, ""},
+    {"NST", 12600, 0, 0, ""},
+    {"NT", 12600, 0, 0, ""},
+    {"NUT", 39600, 0, 0, ""},
+    {"NZDT", 46800, 0, 0, ""},
+    {"NZST", 43200, 0, 0, ""},
+    {"Nepal Time", 20700, 0, 0, ""},
+    {"New Caledonia Time", 39600, 0, 0, ""},
+    {"New Zealand Daylight Time", 46800, 0, 0, ""},
+    {"New Zealand Standard Time", 43200, 0, 0, ""},
+    {"Newfoundland Daylight Time", 9000, 0, 0, ""},
+    {"Newfoundland Standard Time", 12600, 0, 0, ""},
+    {"Newfoundland Time", 12600, 0, 0, ""},
+    {"Niue Time", 39600, 0, 0, ""},
+    {"Norfolk Island Time", 39600, 0, 0, ""},
+    {"Novosibirsk Time ", 25200, 0, 0, ""},
+    {"OMST", 21600, 0, 0, ""},
+    {"ORAT", 18000, 0, 0, ""},
+    {"Omsk Time", 21600, 0, 0, ""},
+    {"Oral Time", 18000, 0, 0, ""},
+    {"PDT", 25200, 0, 0, ""},
+    {"PET", 18000, 0, 0, ""},
+    {"PETT", 43200, 0, 0, ""},
+    {"PGT", 36000, 0, 0, ""},
+    {"PHOT", 46800, 0, 0, ""},
+    {"PHST", 28800, 0, 0, ""},
+    {"PHT", 28800, 0, 0, ""},
+    {"PKT", 18000, 0, 0, ""},
+    {"PMDT", 7200, 0, 0, ""},
+    {"PMST", 10800, 0, 0, ""},
+    {"PONT", 39600, 0, 0, ""},
+    {"PST", 28800, 0, 0, ""},
+    {"PWT", 32400, 0, 0, ""},
+    {"PYST", 10800, 0, 0, ""},
+    {"PYT", 14400, 0, 0, ""},
+    {"Pacific Daylight Time", 25200, 0, 0, ""},
+    {"Pacific Standard Time", 28800, 0, 0, ""},
+    {"Pakistan Standard Time", 18000, 0, 0, ""},
+    {"Palau Time", 32400, 0, 0, ""},
+    {"Papua New Guinea Time", 36000, 0, 0, ""},
+    {"Paraguay Summer Time", 10800, 0, 0, ""},
+    {"Paraguay Time", 14400, 0, 0, ""},
+    {"Peru Time", 18000, 0, 0, ""},
+    {"Philippine Standard Time", 28800, 0, 0, ""},
+    {"Philippine Time", 28800, 0, 0, ""},
+    {"Phoenix Island Time", 46800, 0, 0, ""},
+    {"Pohnpei Standard Time", 39600, 0, 0, ""},
+    {"RET", 14400, 0, 0, ""},
+    {"ROTT", 10800, 0, 0, ""},
+    {"Rothera Research Station Time", 10800, 0, 0, ""},
+    {"Réunion Time", 14400, 0, 0, ""},
+    {"SAKT", 39600, 0, 0, ""},
+    {"SAMT", 14400, 0, 0, ""},
+    {"SAST", 7200, 0, 0, ""},
+    {"SBT", 39600, 0, 0, ""},
+    {"SCT", 14400, 0, 0, ""},
+    {"SDT", 36000, 0, 0, ""},
+    {"SGT", 28800, 0, 0, ""},
+    {"SLST", 19800, 0, 0, ""},
+    {"SRET", 39600, 0, 0, ""},
+    {"SRT", 10800, 0, 0, ""},
+    {"SST", 28800, 0, 0, ""},
+    {"SYOT", 10800, 0, 0, ""},
+    {"Saint Pierre and Miquelon Daylight Time", 7200, 0, 0, ""},
+    {"Saint Pierre and Miquelon Standard Time", 10800, 0, 0, ""},
+    {"Sakhalin Island Time", 39600, 0, 0, ""},
+    {"Samara Time", 14400, 0, 0, ""},
+    {"Samoa Daylight Time", 36000, 0, 0, ""},
+    {"Samoa Standard Time", 39600, 0, 0, ""},
+    {"Seychelles Time", 14400, 0, 0, ""},
+    {"Showa Station Time", 10800, 0, 0, ""},
+    {"Singapore Standard Time", 28800, 0, 0, ""},
+    {"Singapore Time", 28800, 0, 0, ""},
+    {"Solomon Islands Time", 39600, 0, 0, ""},
+    {"South African Standard Time", 7200, 0, 0, ""},
+    {"South Georgia and the South Sandwich Islands Time", 7200, 0, 0, ""},
+    {"Srednekolymsk Time", 39600, 0, 0, ""},
+    {"Sri Lanka Standard Time", 19800, 0, 0, ""},
+    {"Suriname Time", 10800, 0, 0, ""},
+    {"TAHT", 36000, 0, 0, ""},
+    {"TFT", 18000, 0, 0, ""},
+    {"THA", 25200, 0, 0, ""},
+    {"TJT", 18000, 0, 0, ""},
+    {"TKT", 46800, 0, 0, ""},
+    {"TLT", 32400, 0, 0, ""},
+    {"TMT", 18000, 0, 0, ""},
+    {"TOT", 46800, 0, 0, ""},
+    {"TRT", 10800, 0, 0, ""},
+    {"TVT", 43200, 0, 0, ""},
+    {"Tahiti Time", 36000, 0, 0, ""},
+    {"Tajikistan Time", 18000, 0, 0, ""},
+    {"Thailand Standard Time", 25200, 0, 0, ""},
+    {"Timor Leste Time", 32400, 0, 0, ""},
+    {"Tokelau Time", 46800, 0, 0, ""},
+    {"Tonga Time", 46800, 0, 0, ""},
+    {"Turkey Time", 10800, 0, 0, ""},
+    {"Turkmenistan Time", 18000, 0, 0, ""},
+    {"Tuvalu Time", 43200, 0, 0, ""},
+    {"ULAST", 32400, 0, 0, ""},
+    {"ULAT", 28800, 0, 0, ""},
+    {"UTC+0", 0, 0, 0, ""},
+    {"UTC+0:15", 900, 0, 0, ""},
+    {"UTC+0:30", 1800, 0, 0, ""},
+    {"UTC+0:45", 2700, 0, 0, ""},
+    {"UTC+1", 3600, 0, 0, ""},
+    {"UTC+10", 36000, 0, 0, ""},
+    {"UTC+10:15", 36900, 0, 0, ""},
+    {"UTC+10:30", 37800, 0, 0, ""},
+    {"UTC+10:45", 38700, 0, 0, ""},
+    {"UTC+11", 39600, 0, 0, ""},
+    {"UTC+11:15", 40500, 0, 0, ""},
+    {"UTC+11:30", 41400, 0, 0, ""},
+    {"UTC+11:45", 42300, 0, 0, ""},
+    {"UTC+12", 43200, 0, 0, ""},
+    {"UTC+12:15", 44100, 0, 0, ""},
+    {"UTC+12:30", 45000, 0, 0, ""},
+    {"UTC+12:45", 45900, 0, 0, ""},
+    {"UTC+13", 46800, 0, 0, ""},
+    {"UTC+13:15", 47700, 0, 0, ""},
+    {"UTC+13:30", 48600, 0, 0, ""},
+    {"UTC+13:45", 49500, 0, 0, ""},
+    {"UTC+14", 50400, 0, 0, ""},
+    {"UTC+14:15", 51300, 0, 0, ""},
+    {"UTC+14:30", 52200, 0, 0, ""},
+    {"UTC+14:45", 53100, 0, 0, ""},
+    {"UTC+1:15", 4500, 0, 0, ""},
+    {"UTC+1:30", 5400, 0, 0, ""},
+    {"UTC+1:45", 6300, 0, 0, ""},
+    {"UTC+2", 7200, 0, 0, ""},
+    {"UTC+2:15", 8100, 0, 0, ""},
+    {"UTC+2:30", 9000, 0, 0, ""},
+    {"UTC+2:45", 9900, 0, 0, ""},
+    {"UTC+3", 10800, 0, 0, ""},
+    {"UTC+3:15", 11700, 0, 0, ""},
+    {"UTC+3:30", 12600, 0, 0, ""},
+    {"UTC+3:45", 13500, 0, 0, ""},
+    {"UTC+4", 14400, 0, 0, ""},
+    {"UTC+4:15", 15300, 0, 0, ""},
+    {"UTC+4:30", 16200, 0, 0, ""},
+    {"UTC+4:45", 17100, 0, 0, ""},
+    {"UTC+5", 18000, 0, 0, ""},
+    {"UTC+5:15", 18900, 0, 0, ""},
+    {"UTC+5:30", 19800, 0, 0, ""},
+    {"UTC+5:45", 20700, 0, 0, ""},
+    {"UTC+6", 21600, 0, 0, ""},
+    {"UTC+6:15", 22500, 0, 0, ""},
+    {"UTC+6:30", 23400, 0, 0, ""},
+    {"UTC+6:45", 24300, 0, 0, ""},
+    {"UTC+7", 25200, 0, 0, ""},
+    {"UTC+7:15", 26100, 0, 0, ""},
+    {"UTC+7:30", 27000, 0, 0, ""},
+    {"UTC+7:45", 27900, 0, 0, ""},
+    {"UTC+8", 28800, 0, 0, ""},
+    {"UTC+8:15", 29700, 0, 0, ""},
+    {"UTC+8:30", 30600, 0, 0, ""},
+    {"UTC+8:45", 31500, 0, 0, ""},
+    {"UTC+9", 32400, 0, 0, ""},
+    {"UTC+9:15", 33300, 0, 0, ""},
+    {"UTC+9:30", 34200, 0, 0, ""},
+    {"UTC+9:45", 35100, 0, 0, ""},
+    {"UTC--1", -3600, 0, 0, ""},
+    {"UTC--10", -36000, 0, 0, ""},
+    {"UTC--10:15", -35100, 0, 0, ""},
+    {"UTC--10:30", -34200, 0, 0, ""},
+    {"UTC--10:45", -33300, 0, 0, ""},
+    {"UTC--11", -39600, 0, 0, ""},
+    {"UTC--11:15", -38700, 0, 0, ""},
+    {"UTC--11:30", -37800, 0, 0, ""},
+    {"UTC--11:45", -36900, 0, 0, ""},
+    {"UTC--12", -43200, 0, 0, ""},
+    {"UTC--12:15", -42300, 0, 0, ""},
+    {"UTC--12:30", -41400, 0, 0, ""},
+    {"UTC--12:45", -40500, 0, 0, ""},
+    {"UTC--1:15", -2700, 0, 0, ""},
+    {"UTC--1:30", -1800, 0, 0, ""},
+    {"UTC--1:45", -900, 0, 0, ""},
+    {"UTC--2", -7200, 0, 0, ""},
+    {"UTC--2:15", -6300, 0, 0, ""},
+    {"UTC--2:30", -5400, 0, 0, ""},
+    {"UTC--2:45", -4500, 0, 0, ""},
+    {"UTC--3", -10800, 0, 0, ""},
+    {"UTC--3:15", -9900, 0, 0, ""},
+    {"UTC--3:30", -9000, 0, 0, ""},
+    {"UTC--3:45", -8100, 0, 0, ""},
+    {"UTC--4", -14400, 0, 0, ""},
+    {"UTC--4:15", -13500, 0, 0, ""},
+    {"UTC--4:30", -12600, 0, 0, ""},
+    {"UTC--4:45", -11700, 0, 0, ""},
+    {"UTC--5", -18000, 0, 0, ""},
+    {"UTC--5:15", -17100, 0, 0, ""},
+    {"UTC--5:30", -16200, 0, 0, ""},
+    {"UTC--5:45", -15300, 0, 0, ""},
+    {"UTC--6", -21600, 0, 0, ""},
+    {"UTC--6:15", -20700, 0, 0, ""},
+    {"UTC--6:30", -19800, 0, 0, ""},
+    {"UTC--6:45", -18900, 0, 0, ""},
+    {"UTC--7", -25200, 0, 0, ""},
+    {"UTC--7:15", -24300, 0, 0, ""},
+    {"UTC--7:30", -23400, 0, 0, ""},
+    {"UTC--7:45", -22500, 0, 0, ""},
+    {"UTC--8", -28800, 0, 0, ""},
+    {"UTC--8:15", -27900, 0, 0, ""},
+    {"UTC--8:30", -27000, 0, 0, ""},
+    {"UTC--8:45", -26100, 0, 0, ""},
+    {"UTC--9", -32400, 0, 0, ""},
+    {"UTC--9:15", -31500, 0, 0, ""},
+    {"UTC--9:30", -30600, 0, 0, ""},
+    {"UTC--9:45", -29700, 0, 0, ""},
+    {"UYST", 7200, 0, 0, ""},
+    {"UYT", 10800, 0, 0, ""},
+    {"UZT", 18000, 0, 0, ""},
+    {"Ulaanbaatar Standard Time", 28800, 0, 0, ""},
+    {"Ulaanbaatar Summer Time", 32400, 0, 0, ""},
+    {"Uruguay Standard Time", 10800, 0, 0, ""},
+    {"Uruguay Summer Time", 7200, 0, 0, ""},
+    {"Uzbekistan Time", 18000, 0, 0, ""},
+    {"VET", 14400, 0, 0, ""},
+    {"VLAT", 36000, 0, 0, ""},
+    {"VOLT", 10800, 0, 0, ""},
+    {"VOST", 21600, 0, 0, ""},
+    {"VUT", 39600, 0, 0, ""},
+    {"Vanuatu", 39600, 0, 0, ""},
+    {"Venezuelan Standard Time", 14400, 0, 0, ""},
+    {"Vladivostok Time", 36000, 0, 0, ""},
+    {"Volgograd Time", 10800, 0, 0, ""},
+    {"Vostok Station Time", 21600, 0, 0, ""},
+    {"WAKT", 43200, 0, 0, ""},
+    {"WAST", 7200, 0, 0, ""},
+    {"WAT", 3600, 0, 0, ""},
+    {"WEST", 3600, 0, 0, ""},
+    {"WET", 0, 0, 0, ""},
+    {"WGST", 7200, 0, 0, ""},
+    {"WGT", 10800, 0, 0, ""},
+    {"WIB", 25200, 0, 0, ""},
+    {"WIT", 32400, 0, 0, ""},
+    {"WITA", 28800, 0, 0, ""},
+    {"WST", 28800, 0, 0, ""},
+    {"Wake Island Time", 43200, 0, 0, ""},
+    {"West Africa Summer Time", 7200, 0, 0, ""},
+    {"West Africa Time", 3600, 0, 0, ""},
+    {"West Greenland Summer Time", 7200, 0, 0, ""},
+    {"West Greenland Time", 10800, 0, 0, ""},
+    {"Western European Summer Time", 3600, 0, 0, ""},
+    {"Western European Time", 0, 0, 0, ""},
+    {"Western Indonesian Time", 25200, 0, 0, ""},
+    {"Western Standard Time", 28800, 0, 0, ""},
+    {"YAKT", 32400, 0, 0, ""},
+    {"YEKT", 18000, 0, 0, ""},
+    {"Yakutsk Time", 32400, 0, 0, ""},
+    {"Yekaterinburg Time", 18000, 0, 0, ""},
+};
+
+// The names of the built-in zones as a trie, laid out as NameIndex builds one,
+// so that they are looked up without building anything first. The keys are
+// TimezoneIds.
+struct NameTrieNode {
+    int key;               // of the name ending here, or -1
+    unsigned first_edge;
+    unsigned edge_count;
+    unsigned label;        // bytes after the edge's byte, in the labels
+    unsigned label_length;
+};
+
+struct NameTrieEdge {
+    unsigned char c;
+    unsigned child;
+};
+
+static constexpr unsigned BuiltinNameMaxLength = 49;
+
+static constexpr NameTrieNode BuiltinNameNodes[] = {
+    {-1, 0, 23, 0, 0},
+    {-1, 23, 23, 0, 0},
+    {-1, 85, 10, 0, 0},
+    {-1, 110, 19, 0, 0},
+    {-1, 176, 5, 0, 0},
+    {-1, 181, 8, 0, 0},
+    {-1, 213, 9, 0, 0},
+    {-1, 228, 12, 0, 0},
+    {-1, 250, 9, 0, 0},
+    {-1, 269, 8, 0, 0},
+    {-1, 291, 2, 0, 0},
+    {-1, 293, 9, 0, 0},
+    {-1, 306, 4, 0, 0},
+    {-1, 312, 14, 0, 0},
+    {-1, 353, 12, 0, 0},
+    {-1, 380, 4, 0, 0},
+    {-1, 384, 14, 0, 0},
+    {-1, 419, 4, 0, 0},
+    {-1, 423, 16, 0, 0},
+    {-1, 461, 15, 0, 0},
+    {-1, 484, 7, 0, 0},
+    {-1, 636, 8, 0, 0},
+    {-1, 648, 7, 0, 0},
+    {-1, 678, 4, 0, 0},
+    {-1, 46, 4, 0, 0},
+    {5, 50, 0, 0, 1},
+    {-1, 50, 2, 1, 0},
+    {8, 52, 0, 1, 1},
+    {-1, 52, 2, 2, 0},
+    {11, 54, 0, 2, 2},
+    {-1, 54, 2, 4, 0},
+    {14, 56, 0, 4, 2},
+    {15, 56, 0, 6, 2},
+    {16, 56, 0, 8, 1},
+    {-1, 56, 2, 9, 0},
+    {19, 58, 0, 9, 2},
+    {-1, 58, 2, 11, 0},
+    {23, 62, 0, 11, 7},
+    {24, 62, 0, 18, 14},
+    {-1, 62, 2, 32, 0},
+    {-1, 66, 2, 32, 5},
+    {30, 68, 0, 37, 9},
+    {31, 68, 0, 46, 9},
+    {-1, 68, 3, 55, 0},
+    {-1, 71, 2, 55, 7},
+    {-1, 73, 3, 62, 9},
+    {-1, 81, 2, 71, 0},
+    {1, 50, 0, 71, 1},
+    {2, 50, 0, 72, 1},
+    {3, 50, 0, 73, 0},
+    {4, 50, 0, 73, 2},
+    {6, 52, 0, 75, 1},
+    {7, 52, 0, 76, 1},
+    {9, 54, 0, 77, 1},
+    {10, 54, 0, 78, 1},
+    {12, 56, 0, 79, 1},
+    {13, 56, 0, 80, 0},
+    {17, 58, 0, 80, 14},
+    {18, 58, 0, 94, 0},
+    {-1, 60, 2, 94, 0},
+    {22, 62, 0, 94, 0},
+    {20, 62, 0, 94, 1},
+    {21, 62, 0, 95, 0},
+    {-1, 64, 2, 95, 4},
+    {27, 66, 0, 99, 10},
+    {25, 66, 0, 109, 12},
+    {26, 66, 0, 121, 12},
+    {28, 68, 0, 133, 10},
+    {29, 68, 0, 143, 3},
+    {32, 71, 0, 146, 17},
+    {33, 71, 0, 163, 11},
+    {34, 71, 0, 174, 9},
+    {35, 73, 0, 183, 12},
+    {36, 73, 0, 195, 12},
+    {-1, 76, 3, 207, 7},
+    {-1, 79, 2, 214, 7},
+    {42, 81, 0, 221, 20},
+    {37, 79, 0, 241, 19},
+    {38, 79, 0, 260, 12},
+    {39, 79, 0, 272, 20},
+    {40, 81, 0, 292, 19},
+    {41, 81, 0, 311, 12},
+    {43, 83, 0, 323, 12},
+    {-1, 83, 2, 335, 5},
+    {44, 85, 0, 340, 11},
+    {45, 85, 0, 351, 9},
+    {-1, 95, 2, 360, 0},
+    {48, 97, 0, 360, 1},
+    {49, 97, 0, 361, 1},
+    {-1, 97, 2, 362, 0},
+    {52, 99, 0, 362, 1},
+    {53, 99, 0, 363, 1},
+    {-1, 99, 2, 364, 0},
+    {56, 101, 0, 364, 9},
+    {-1, 101, 2, 373, 0},
+    {-1, 103, 3, 373, 0},
+    {46, 97, 0, 373, 1},
+    {47, 97, 0, 374, 0},
+    {50, 99, 0, 374, 1},
+    {51, 99, 0, 375, 0},
+    {54, 101, 0, 375, 14},
+    {55, 101, 0, 389, 21},
+    {57, 103, 0, 410, 9},
+    {58, 103, 0, 419, 23},
+    {-1, 106, 2, 442, 7},
+    {-1, 108, 2, 449, 5},
+    {63, 110, 0, 454, 8},
+    {59, 108, 0, 462, 10},
+    {60, 108, 0, 472, 3},
+    {61, 110, 0, 475, 16},
+    {62, 110, 0, 491, 10},
+    {64, 129, 0, 501, 1},
+    {65, 129, 0, 502, 1},
+    {66, 129, 0, 503, 1},
+    {-1, 129, 2, 504, 0},
+    {-1, 131, 4, 504, 0},
+    {75, 139, 0, 504, 2},
+    {76, 139, 0, 506, 1},
+    {-1, 139, 2, 507, 0},
+    {-1, 141, 2, 507, 0},
+    {81, 143, 0, 507, 1},
+    {82, 143, 0, 508, 1},
+    {83, 143, 0, 509, 2},
+    {84, 143, 0, 511, 1},
+    {85, 143, 0, 512, 13},
+    {-1, 143, 6, 525, 6},
+    {-1, 151, 5, 531, 0},
+    {104, 167, 0, 531, 29},
+    {-1, 167, 3, 560, 0},
+    {-1, 174, 2, 560, 3},
+    {67, 131, 0, 563, 1},
+    {68, 131, 0, 564, 0},
+    {-1, 135, 2, 564, 0},
+    {-1, 137, 2, 564, 0},
+    {73, 139, 0, 564, 1},
+    {74, 139, 0, 565, 1},
+    {69, 137, 0, 566, 1},
+    {70, 137, 0, 567, 1},
+    {71, 139, 0, 568, 1},
+    {72, 139, 0, 569, 0},
+    {77, 141, 0, 569, 1},
+    {78, 141, 0, 570, 0},
+    {79, 143, 0, 570, 1},
+    {80, 143, 0, 571, 0},
+    {86, 149, 0, 571, 10},
+    {87, 149, 0, 581, 12},
+    {-1, 149, 2, 593, 8},
+    {90, 151, 0, 601, 13},
+    {91, 151, 0, 614, 12},
+    {92, 151, 0, 626, 20},
+    {88, 151, 0, 646, 10},
+    {89, 151, 0, 656, 3},
+    {-1, 156, 3, 659, 0},
+    {-1, 161, 2, 659, 0},
+    {-1, 165, 2, 659, 9},
+    {102, 167, 0, 668, 18},
+    {103, 167, 0, 686, 7},
+    {93, 159, 0, 693, 32},
+    {94, 159, 0, 725, 18},
+    {-1, 159, 2, 743, 4},
+    {95, 161, 0, 747, 12},
+    {96, 161, 0, 759, 12},
+    {-1, 163, 2, 771, 3},
+    {99, 165, 0, 774, 15},
+    {97, 165, 0, 789, 11},
+    {98, 165, 0, 800, 9},
+    {100, 167, 0, 809, 11},
+    {101, 167, 0, 820, 9},
+    {105, 170, 0, 829, 15},
+    {-1, 170, 2, 844, 6},
+    {-1, 172, 2, 850, 0},
+    {106, 172, 0, 850, 10},
+    {107, 172, 0, 860, 3},
+    {108, 174, 0, 863, 12},
+    {109, 174, 0, 875, 22},
+    {110, 176, 0, 897, 12},
+    {111, 176, 0, 909, 12},
+    {112, 181, 0, 921, 2},
+    {113, 181, 0, 923, 2},
+    {114, 181, 0, 925, 1},
+    {115, 181, 0, 926, 8},
+    {116, 181, 0, 934, 19},
+    {-1, 189, 2, 953, 0},
+    {120, 193, 0, 953, 1},
+    {121, 193, 0, 954, 1},
+    {-1, 193, 2, 955, 0},
+    {-1, 195, 2, 955, 0},
+    {126, 197, 0, 955, 1},
+    {-1, 197, 2, 956, 2},
+    {138, 213, 0, 958, 10},
+    {-1, 191, 2, 968, 0},
+    {119, 193, 0, 968, 0},
+    {117, 193, 0, 968, 1},
+    {118, 193, 0, 969, 0},
+    {122, 195, 0, 969, 1},
+    {123, 195, 0, 970, 0},
+    {124, 197, 0, 970, 1},
+    {125, 197, 0, 971, 0},
+    {127, 199, 0, 971, 11},
+    {-1, 199, 2, 982, 1},
+    {-1, 201, 2, 983, 8},
+    {-1, 203, 6, 991, 1},
+    {128, 203, 0, 992, 11},
+    {129, 203, 0, 1003, 9},
+    {130, 209, 0, 1012, 13},
+    {131, 209, 0, 1025, 12},
+    {-1, 209, 2, 1037, 8},
+    {-1, 211, 2, 1045, 9},
+    {136, 213, 0, 1054, 14},
+    {137, 213, 0, 1068, 12},
+    {132, 211, 0, 1080, 10},
+    {133, 211, 0, 1090, 3},
+    {134, 213, 0, 1093, 10},
+    {135, 213, 0, 1103, 3},
+    {139, 222, 0, 1106, 1},
+    {140, 222, 0, 1107, 1},
+    {-1, 222, 2, 1108, 0},
+    {143, 224, 0, 1108, 1},
+    {-1, 224, 2, 1109, 15},
+    {146, 226, 0, 1124, 22},
+    {147, 226, 0, 1146, 7},
+    {-1, 226, 2, 1153, 5},
+    {150, 228, 0, 1158, 27},
+    {141, 224, 0, 1185, 1},
+    {142, 224, 0, 1186, 0},
+    {144, 226, 0, 1186, 10},
+    {145, 226, 0, 1196, 3},
+    {148, 228, 0, 1199, 10},
+    {149, 228, 0, 1209, 26},
+    {-1, 240, 2, 1235, 0},
+    {153, 242, 0, 1235, 1},
+    {154, 242, 0, 1236, 1},
+    {-1, 242, 2, 1237, 0},
+    {157, 244, 0, 1237, 1},
+    {158, 244, 0, 1238, 1},
+    {159, 244, 0, 1239, 1},
+    {-1, 244, 2, 1240, 0},
+    {163, 248, 0, 1240, 19},
+    {164, 248, 0, 1259, 17},
+    {165, 248, 0, 1276, 17},
+    {-1, 248, 2, 1293, 0},
+    {151, 242, 0, 1293, 1},
+    {152, 242, 0, 1294, 1},
+    {155, 244, 0, 1295, 1},
+    {156, 244, 0, 1296, 0},
+    {160, 246, 0, 1296, 12},
+    {-1, 246, 2, 1308, 11},
+    {161, 248, 0, 1319, 4},
+    {162, 248, 0, 1323, 5},
+    {166, 250, 0, 1328, 15},
+    {167, 250, 0, 1343, 8},
+    {168, 259, 0, 1351, 2},
+    {169, 259, 0, 1353, 1},
+    {170, 259, 0, 1354, 1},
+    {171, 259, 0, 1355, 1},
+    {-1, 259, 2, 1356, 1},
+    {174, 261, 0, 1357, 1},
+    {-1, 261, 2, 1358, 16},
+    {-1, 263, 2, 1374, 0},
+    {-1, 265, 2, 1374, 0},
+    {172, 261, 0, 1374, 1},
+    {173, 261, 0, 1375, 0},
+    {175, 263, 0, 1375, 12},
+    {176, 263, 0, 1387, 12},
+    {177, 265, 0, 1399, 23},
+    {178, 265, 0, 1422, 29},
+    {179, 267, 0, 1451, 11},
+    {-1, 267, 2, 1462, 2},
+    {180, 269, 0, 1464, 10},
+    {181, 269, 0, 1474, 3},
+    {182, 277, 0, 1477, 1},
+    {-1, 277, 2, 1478, 0},
+    {185, 279, 0, 1478, 1},
+    {-1, 279, 3, 1479, 0},
+    {189, 282, 0, 1479, 1},
+    {-1, 282, 2, 1480, 1},
+    {-1, 284, 3, 1481, 0},
+    {-1, 289, 2, 1481, 5},
+    {183, 279, 0, 1486, 1},
+    {184, 279, 0, 1487, 0},
+    {186, 282, 0, 1487, 1},
+    {187, 282, 0, 1488, 1},
+    {188, 282, 0, 1489, 1},
+    {190, 284, 0, 1490, 16},
+    {191, 284, 0, 1506, 10},
+    {-1, 287, 2, 1516, 2},
+    {194, 289, 0, 1518, 16},
+    {195, 289, 0, 1534, 9},
+    {192, 289, 0, 1543, 12},
+    {193, 289, 0, 1555, 12},
+    {196, 291, 0, 1567, 12},
+    {197, 291, 0, 1579, 12},
+    {198, 293, 0, 1591, 1},
+    {199, 293, 0, 1592, 17},
+    {200, 302, 0, 1609, 2},
+    {201, 302, 0, 1611, 1},
+    {202, 302, 0, 1612, 2},
+    {203, 302, 0, 1614, 2},
+    {204, 302, 0, 1616, 1},
+    {-1, 302, 2, 1617, 0},
+    {-1, 304, 2, 1617, 0},
+    {209, 306, 0, 1617, 14},
+    {210, 306, 0, 1631, 13},
+    {205, 304, 0, 1644, 13},
+    {206, 304, 0, 1657, 11},
+    {207, 306, 0, 1668, 16},
+    {208, 306, 0, 1684, 8},
+    {211, 310, 0, 1692, 2},
+    {212, 310, 0, 1694, 2},
+    {213, 310, 0, 1696, 10},
+    {-1, 310, 2, 1706, 9},
+    {214, 312, 0, 1715, 11},
+    {215, 312, 0, 1726, 9},
+    {-1, 326, 3, 1735, 0},
+    {219, 329, 0, 1735, 1},
+    {-1, 329, 2, 1736, 0},
+    {222, 331, 0, 1736, 1},
+    {-1, 331, 2, 1737, 0},
+    {225, 333, 0, 1737, 1},
+    {-1, 333, 2, 1738, 0},
+    {228, 335, 0, 1738, 1},
+    {229, 335, 0, 1739, 1},
+    {230, 335, 0, 1740, 1},
+    {-1, 335, 6, 1741, 0},
+    {-1, 347, 2, 1741, 14},
+    {-1, 349, 2, 1755, 0},
+    {245, 353, 0, 1755, 19},
+    {216, 329, 0, 1774, 1},
+    {217, 329, 0, 1775, 1},
+    {218, 329, 0, 1776, 1},
+    {220, 331, 0, 1777, 1},
+    {221, 331, 0, 1778, 0},
+    {223, 333, 0, 1778, 1},
+    {224, 333, 0, 1779, 0},
+    {226, 335, 0, 1779, 0},
+    {227, 335, 0, 1779, 0},
+    {231, 341, 0, 1779, 26},
+    {232, 341, 0, 1805, 9},
+    {-1, 341, 2, 1814, 0},
+    {-1, 345, 2, 1814, 0},
+    {238, 347, 0, 1814, 11},
+    {239, 347, 0, 1825, 16},
+    {-1, 343, 2, 1841, 5},
+    {235, 345, 0, 1846, 9},
+    {233, 345, 0, 1855, 12},
+    {234, 345, 0, 1867, 3},
+    {236, 347, 0, 1870, 18},
+    {237, 347, 0, 1888, 17},
+    {240, 349, 0, 1905, 10},
+    {241, 349, 0, 1915, 3},
+    {242, 351, 0, 1918, 8},
+    {-1, 351, 2, 1926, 6},
+    {243, 353, 0, 1932, 12},
+    {244, 353, 0, 1944, 12},
+    {246, 365, 0, 1956, 1},
+    {247, 365, 0, 1957, 1},
+    {248, 365, 0, 1958, 1},
+    {249, 365, 0, 1959, 2},
+    {250, 365, 0, 1961, 1},
+    {251, 365, 0, 1962, 1},
+    {252, 365, 0, 1963, 0},
+    {253, 365, 0, 1963, 1},
+    {-1, 365, 2, 1964, 0},
+    {-1, 367, 2, 1964, 0},
+    {263, 378, 0, 1964, 7},
+    {-1, 378, 2, 1971, 0},
+    {254, 367, 0, 1971, 1},
+    {255, 367, 0, 1972, 1},
+    {256, 369, 0, 1973, 7},
+    {-1, 369, 2, 1980, 0},
+    {-1, 371, 2, 1980, 0},
+    {-1, 375, 3, 1980, 9},
+    {257, 373, 0, 1989, 13},
+    {-1, 373, 2, 2002, 7},
+    {258, 375, 0, 2009, 12},
+    {259, 375, 0, 2021, 12},
+    {260, 378, 0, 2033, 12},
+    {261, 378, 0, 2045, 12},
+    {262, 378, 0, 2057, 3},
+    {264, 380, 0, 2060, 16},
+    {265, 380, 0, 2076, 14},
+    {266, 384, 0, 2090, 2},
+    {267, 384, 0, 2092, 2},
+    {268, 384, 0, 2094, 7},
+    {269, 384, 0, 2101, 7},
+    {270, 398, 0, 2108, 1},
+    {271, 398, 1, 2109, 1},
+    {273, 399, 0, 2110, 1},
+    {-1, 399, 3, 2111, 0},
+    {277, 402, 0, 2111, 1},
+    {-1, 402, 2, 2112, 0},
+    {280, 404, 0, 2112, 2},
+    {281, 404, 0, 2114, 1},
+    {282, 404, 0, 2115, 1},
+    {-1, 404, 2, 2116, 0},
+    {-1, 406, 5, 2116, 0},
+    {292, 415, 0, 2116, 7},
+    {-1, 415, 2, 2123, 0},
+    {296, 419, 0, 2123, 19},
+    {272, 399, 0, 2142, 0},
+    {274, 402, 0, 2142, 1},
+    {275, 402, 0, 2143, 1},
+    {276, 402, 0, 2144, 0},
+    {278, 404, 0, 2144, 1},
+    {279, 404, 0, 2145, 1},
+    {283, 406, 0, 2146, 1},
+    {284, 406, 0, 2147, 0},
+    {-1, 411, 2, 2147, 5},
+    {287, 413, 0, 2152, 19},
+    {288, 413, 0, 2171, 7},
+    {289, 413, 0, 2178, 18},
+    {-1, 413, 2, 2196, 6},
+    {285, 413, 0, 2202, 12},
+    {286, 413, 0, 2214, 12},
+    {290, 415, 0, 2226, 10},
+    {291, 415, 0, 2236, 3},
+    {-1, 417, 2, 2239, 8},
+    {295, 419, 0, 2247, 16},
+    {293, 419, 0, 2263, 12},
+    {294, 419, 0, 2275, 3},
+    {297, 423, 0, 2278, 1},
+    {298, 423, 0, 2279, 2},
+    {299, 423, 0, 2281, 27},
+    {300, 423, 0, 2308, 11},
+    {-1, 439, 3, 2319, 0},
+    {304, 442, 0, 2319, 1},
+    {305, 442, 0, 2320, 1},
+    {306, 442, 0, 2321, 1},
+    {307, 442, 0, 2322, 1},
+    {308, 442, 0, 2323, 2},
+    {-1, 442, 2, 2325, 0},
+    {311, 444, 0, 2325, 1},
+    {312, 444, 0, 2326, 2},
+    {-1, 444, 3, 2328, 0},
+    {319, 453, 0, 2328, 13},
+    {320, 453, 0, 2341, 16},
+    {-1, 453, 2, 2357, 8},
+    {-1, 455, 2, 2365, 0},
+    {-1, 459, 2, 2365, 0},
+    {328, 461, 0, 2365, 11},
+    {301, 442, 0, 2376, 1},
+    {302, 442, 0, 2377, 1},
+    {303, 442, 0, 2378, 1},
+    {309, 444, 0, 2379, 1},
+    {310, 444, 0, 2380, 0},
+    {-1, 447, 2, 2380, 23},
+    {315, 449, 0, 2403, 17},
+    {-1, 449, 2, 2420, 0},
+    {313, 449, 0, 2420, 12},
+    {314, 449, 0, 2432, 12},
+    {316, 451, 0, 2444, 7},
+    {-1, 451, 2, 2451, 2},
+    {317, 453, 0, 2453, 12},
+    {318, 453, 0, 2465, 12},
+    {321, 455, 0, 2477, 12},
+    {322, 455, 0, 2489, 3},
+    {323, 457, 0, 2492, 17},
+    {-1, 457, 2, 2509, 3},
+    {324, 459, 0, 2512, 20},
+    {325, 459, 0, 2532, 42},
+    {326, 461, 0, 2574, 15},
+    {327, 461, 0, 2589, 20},
+    {329, 476, 0, 2609, 2},
+    {330, 476, 0, 2611, 1},
+    {331, 476, 0, 2612, 1},
+    {332, 476, 0, 2613, 1},
+    {333, 476, 0, 2614, 1},
+    {334, 476, 0, 2615, 1},
+    {335, 476, 0, 2616, 1},
+    {336, 476, 0, 2617, 1},
+    {337, 476, 0, 2618, 1},
+    {338, 476, 0, 2619, 1},
+    {-1, 476, 2, 2620, 0},
+    {341, 478, 0, 2620, 20},
+    {342, 478, 0, 2640, 14},
+    {-1, 478, 2, 2654, 0},
+    {-1, 480, 2, 2654, 0},
+    {339, 478, 0, 2654, 8},
+    {340, 478, 0, 2662, 12},
+    {343, 480, 0, 2674, 9},
+    {344, 480, 0, 2683, 7},
+    {-1, 482, 2, 2690, 1},
+    {347, 484, 0, 2691, 8},
+    {345, 484, 0, 2699, 6},
+    {346, 484, 0, 2705, 12},
+    {-1, 491, 2, 2717, 1},
+    {0, 493, 2, 2718, 1},
+    {-1, 630, 2, 2719, 0},
+    {460, 632, 0, 2719, 1},
+    {-1, 632, 2, 2720, 11},
+    {-1, 634, 2, 2731, 7},
+    {465, 636, 0, 2738, 13},
+    {348, 493, 0, 2751, 1},
+    {349, 493, 0, 2752, 0},
+    {-1, 495, 10, 2752, 0},
+    {-1, 570, 9, 2752, 1},
+    {350, 505, 1, 2753, 0},
+    {354, 509, 6, 2753, 0},
+    {378, 538, 1, 2753, 0},
+    {382, 542, 1, 2753, 0},
+    {386, 546, 1, 2753, 0},
+    {390, 550, 1, 2753, 0},
+    {394, 554, 1, 2753, 0},
+    {398, 558, 1, 2753, 0},
+    {402, 562, 1, 2753, 0},
+    {406, 566, 1, 2753, 0},
+    {-1, 506, 3, 2753, 0},
+    {351, 509, 0, 2753, 1},
+    {352, 509, 0, 2754, 1},
+    {353, 509, 0, 2755, 1},
+    {355, 515, 1, 2756, 0},
+    {359, 519, 1, 2756, 0},
+    {363, 523, 1, 2756, 0},
+    {367, 527, 1, 2756, 0},
+    {371, 531, 1, 2756, 0},
+    {-1, 535, 3, 2756, 0},
+    {-1, 516, 3, 2756, 0},
+    {356, 519, 0, 2756, 1},
+    {357, 519, 0, 2757, 1},
+    {358, 519, 0, 2758, 1},
+    {-1, 520, 3, 2759, 0},
+    {360, 523, 0, 2759, 1},
+    {361, 523, 0, 2760, 1},
+    {362, 523, 0, 2761, 1},
+    {-1, 524, 3, 2762, 0},
+    {364, 527, 0, 2762, 1},
+    {365, 527, 0, 2763, 1},
+    {366, 527, 0, 2764, 1},
+    {-1, 528, 3, 2765, 0},
+    {368, 531, 0, 2765, 1},
+    {369, 531, 0, 2766, 1},
+    {370, 531, 0, 2767, 1},
+    {-1, 532, 3, 2768, 0},
+    {372, 535, 0, 2768, 1},
+    {373, 535, 0, 2769, 1},
+    {374, 535, 0, 2770, 1},
+    {375, 538, 0, 2771, 1},
+    {376, 538, 0, 2772, 1},
+    {377, 538, 0, 2773, 1},
+    {-1, 539, 3, 2774, 0},
+    {379, 542, 0, 2774, 1},
+    {380, 542, 0, 2775, 1},
+    {381, 542, 0, 2776, 1},
+    {-1, 543, 3, 2777, 0},
+    {383, 546, 0, 2777, 1},
+    {384, 546, 0, 2778, 1},
+    {385, 546, 0, 2779, 1},
+    {-1, 547, 3, 2780, 0},
+    {387, 550, 0, 2780, 1},
+    {388, 550, 0, 2781, 1},
+    {389, 550, 0, 2782, 1},
+    {-1, 551, 3, 2783, 0},
+    {391, 554, 0, 2783, 1},
+    {392, 554, 0, 2784, 1},
+    {393, 554, 0, 2785, 1},
+    {-1, 555, 3, 2786, 0},
+    {395, 558, 0, 2786, 1},
+    {396, 558, 0, 2787, 1},
+    {397, 558, 0, 2788, 1},
+    {-1, 559, 3, 2789, 0},
+    {399, 562, 0, 2789, 1},
+    {400, 562, 0, 2790, 1},
+    {401, 562, 0, 2791, 1},
+    {-1, 563, 3, 2792, 0},
+    {403, 566, 0, 2792, 1},
+    {404, 566, 0, 2793, 1},
+    {405, 566, 0, 2794, 1},
+    {-1, 567, 3, 2795, 0},
+    {407, 570, 0, 2795, 1},
+    {408, 570, 0, 2796, 1},
+    {409, 570, 0, 2797, 1},
+    {410, 579, 4, 2798, 0},
+    {426, 598, 1, 2798, 0},
+    {430, 602, 1, 2798, 0},
+    {434, 606, 1, 2798, 0},
+    {438, 610, 1, 2798, 0},
+    {442, 614, 1, 2798, 0},
+    {446, 618, 1, 2798, 0},
+    {450, 622, 1, 2798, 0},
+    {454, 626, 1, 2798, 0},
+    {411, 583, 1, 2798, 0},
+    {415, 587, 1, 2798, 0},
+    {419, 591, 1, 2798, 0},
+    {-1, 595, 3, 2798, 0},
+    {-1, 584, 3, 2798, 0},
+    {412, 587, 0, 2798, 1},
+    {413, 587, 0, 2799, 1},
+    {414, 587, 0, 2800, 1},
+    {-1, 588, 3, 2801, 0},
+    {416, 591, 0, 2801, 1},
+    {417, 591, 0, 2802, 1},
+    {418, 591, 0, 2803, 1},
+    {-1, 592, 3, 2804, 0},
+    {420, 595, 0, 2804, 1},
+    {421, 595, 0, 2805, 1},
+    {422, 595, 0, 2806, 1},
+    {423, 598, 0, 2807, 1},
+    {424, 598, 0, 2808, 1},
+    {425, 598, 0, 2809, 1},
+    {-1, 599, 3, 2810, 0},
+    {427, 602, 0, 2810, 1},
+    {428, 602, 0, 2811, 1},
+    {429, 602, 0, 2812, 1},
+    {-1, 603, 3, 2813, 0},
+    {431, 606, 0, 2813, 1},
+    {432, 606, 0, 2814, 1},
+    {433, 606, 0, 2815, 1},
+    {-1, 607, 3, 2816, 0},
+    {435, 610, 0, 2816, 1},
+    {436, 610, 0, 2817, 1},
+    {437, 610, 0, 2818, 1},
+    {-1, 611, 3, 2819, 0},
+    {439, 614, 0, 2819, 1},
+    {440, 614, 0, 2820, 1},
+    {441, 614, 0, 2821, 1},
+    {-1, 615, 3, 2822, 0},
+    {443, 618, 0, 2822, 1},
+    {444, 618, 0, 2823, 1},
+    {445, 618, 0, 2824, 1},
+    {-1, 619, 3, 2825, 0},
+    {447, 622, 0, 2825, 1},
+    {448, 622, 0, 2826, 1},
+    {449, 622, 0, 2827, 1},
+    {-1, 623, 3, 2828, 0},
+    {451, 626, 0, 2828, 1},
+    {452, 626, 0, 2829, 1},
+    {453, 626, 0, 2830, 1},
+    {-1, 627, 3, 2831, 0},
+    {455, 630, 0, 2831, 1},
+    {456, 630, 0, 2832, 1},
+    {457, 630, 0, 2833, 1},
+    {458, 632, 0, 2834, 1},
+    {459, 632, 0, 2835, 0},
+    {461, 634, 0, 2835, 11},
+    {462, 634, 0, 2846, 9},
+    {463, 636, 0, 2855, 11},
+    {464, 636, 0, 2866, 9},
+    {466, 644, 0, 2875, 1},
+    {467, 644, 0, 2876, 2},
+    {-1, 644, 2, 2878, 0},
+    {470, 646, 0, 2878, 1},
+    {471, 646, 0, 2879, 5},
+    {472, 646, 0, 2884, 22},
+    {473, 646, 0, 2906, 14},
+    {-1, 646, 2, 2920, 0},
+    {468, 646, 0, 2920, 1},
+    {469, 646, 0, 2921, 1},
+    {474, 648, 0, 2922, 11},
+    {475, 648, 0, 2933, 16},
+    {-1, 655, 3, 2949, 0},
+    {-1, 658, 2, 2949, 0},
+    {-1, 660, 2, 2949, 0},
+    {-1, 662, 2, 2949, 0},
+    {486, 665, 0, 2949, 1},
+    {487, 665, 0, 2950, 14},
+    {-1, 665, 2, 2964, 2},
+    {476, 658, 0, 2966, 1},
+    {477, 658, 0, 2967, 1},
+    {478, 658, 0, 2968, 0},
+    {479, 660, 0, 2968, 1},
+    {480, 660, 0, 2969, 0},
+    {481, 662, 0, 2969, 1},
+    {482, 662, 0, 2970, 0},
+    {483, 664, 0, 2970, 0},
+    {484, 664, 1, 2970, 0},
+    {485, 665, 0, 2970, 0},
+    {-1, 667, 2, 2970, 0},
+    {-1, 673, 3, 2970, 3},
+    {-1, 669, 2, 2973, 6},
+    {-1, 671, 2, 2979, 9},
+    {488, 671, 0, 2988, 10},
+    {489, 671, 0, 2998, 3},
+    {490, 673, 0, 3001, 10},
+    {491, 673, 0, 3011, 3},
+    {-1, 676, 2, 3014, 8},
+    {494, 678, 0, 3022, 14},
+    {495, 678, 0, 3036, 12},
+    {492, 678, 0, 3048, 10},
+    {493, 678, 0, 3058, 3},
+    {496, 682, 0, 3061, 2},
+    {497, 682, 0, 3063, 2},
+    {498, 682, 0, 3065, 10},
+    {499, 682, 0, 3075, 16},
+};
+
+static constexpr NameTrieEdge BuiltinNameEdges[] = {
+    {65, 1},
+    {66, 2},
+    {67, 3},
+    {68, 4},
+    {69, 5},
+    {70, 6},
+    {71, 7},
+    {72, 8},
+    {73, 9},
+    {74, 10},
+    {75, 11},
+    {76, 12},
+    {77, 13},
+    {78, 14},
+    {79, 15},
+    {80, 16},
+    {82, 17},
+    {83, 18},
+    {84, 19},
+    {85, 20},
+    {86, 21},
+    {87, 22},
+    {89, 23},
+    {67, 24},
+    {68, 25},
+    {69, 26},
+    {70, 27},
+    {75, 28},
+    {76, 29},
+    {77, 30},
+    {78, 31},
+    {81, 32},
+    {82, 33},
+    {83, 34},
+    {87, 35},
+    {90, 36},
+    {99, 37},
+    {102, 38},
+    {108, 39},
+    {109, 40},
+    {110, 41},
+    {113, 42},
+    {114, 43},
+    {116, 44},
+    {117, 45},
+    {122, 46},
+    {68, 47},
+    {83, 48},
+    {84, 49},
+    {87, 50},
+    {68, 51},
+    {83, 52},
+    {68, 53},
+    {83, 54},
+    {83, 55},
+    {84, 56},
+    {69, 57},
+    {84, 58},
+    {79, 59},
+    {84, 60},
+    {83, 61},
+    {84, 62},
+    {97, 63},
+    {109, 64},
+    {68, 65},
+    {83, 66},
+    {83, 67},
+    {84, 68},
+    {97, 69},
+    {103, 70},
+    {109, 71},
+    {68, 72},
+    {83, 73},
+    {67, 74},
+    {69, 75},
+    {87, 76},
+    {68, 77},
+    {83, 78},
+    {87, 79},
+    {68, 80},
+    {83, 81},
+    {101, 82},
+    {111, 83},
+    {116, 84},
+    {117, 85},
+    {73, 86},
+    {78, 87},
+    {79, 88},
+    {82, 89},
+    {83, 90},
+    {84, 91},
+    {97, 92},
+    {104, 93},
+    {111, 94},
+    {114, 95},
+    {79, 96},
+    {84, 97},
+    {83, 98},
+    {84, 99},
+    {107, 100},
+    {110, 101},
+    {108, 102},
+    {117, 103},
+    {97, 104},
+    {105, 105},
+    {117, 106},
+    {83, 107},
+    {84, 108},
+    {73, 109},
+    {83, 110},
+    {65, 111},
+    {67, 112},
+    {68, 113},
+    {69, 114},
+    {72, 115},
+    {73, 116},
+    {75, 117},
+    {76, 118},
+    {79, 119},
+    {83, 120},
+    {86, 121},
+    {87, 122},
+    {88, 123},
+    {97, 124},
+    {101, 125},
+    {104, 126},
+    {108, 127},
+    {111, 128},
+    {117, 129},
+    {83, 130},
+    {84, 131},
+    {65, 132},
+    {79, 133},
+    {83, 134},
+    {85, 135},
+    {68, 136},
+    {83, 137},
+    {83, 138},
+    {84, 139},
+    {83, 140},
+    {84, 141},
+    {83, 142},
+    {84, 143},
+    {65, 144},
+    {68, 145},
+    {69, 146},
+    {73, 147},
+    {83, 148},
+    {87, 149},
+    {83, 150},
+    {84, 151},
+    {97, 152},
+    {105, 153},
+    {111, 154},
+    {114, 155},
+    {117, 156},
+    {103, 157},
+    {109, 158},
+    {116, 159},
+    {68, 160},
+    {83, 161},
+    {108, 162},
+    {110, 163},
+    {116, 164},
+    {117, 165},
+    {116, 166},
+    {117, 167},
+    {99, 168},
+    {108, 169},
+    {111, 170},
+    {83, 171},
+    {84, 172},
+    {107, 173},
+    {114, 174},
+    {68, 175},
+    {83, 176},
+    {65, 177},
+    {68, 178},
+    {70, 179},
+    {97, 180},
+    {117, 181},
+    {65, 182},
+    {67, 183},
+    {68, 184},
+    {69, 185},
+    {71, 186},
+    {83, 187},
+    {97, 188},
+    {99, 189},
+    {83, 190},
+    {84, 191},
+    {83, 192},
+    {84, 193},
+    {83, 194},
+    {84, 195},
+    {83, 196},
+    {84, 197},
+    {32, 198},
+    {101, 199},
+    {32, 200},
+    {110, 201},
+    {116, 202},
+    {117, 203},
+    {67, 204},
+    {68, 205},
+    {69, 206},
+    {71, 207},
+    {73, 208},
+    {83, 209},
+    {83, 210},
+    {84, 211},
+    {83, 212},
+    {84, 213},
+    {69, 214},
+    {74, 215},
+    {75, 216},
+    {78, 217},
+    {97, 218},
+    {101, 219},
+    {105, 220},
+    {114, 221},
+    {117, 222},
+    {83, 223},
+    {84, 224},
+    {83, 225},
+    {84, 226},
+    {71, 227},
+    {83, 228},
+    {65, 229},
+    {69, 230},
+    {70, 231},
+    {73, 232},
+    {77, 233},
+    {83, 234},
+    {89, 235},
+    {97, 236},
+    {101, 237},
+    {105, 238},
+    {114, 239},
+    {117, 240},
+    {76, 241},
+    {77, 242},
+    {76, 243},
+    {84, 244},
+    {108, 245},
+    {109, 246},
+    {32, 247},
+    {115, 248},
+    {108, 249},
+    {121, 250},
+    {65, 251},
+    {68, 252},
+    {75, 253},
+    {77, 254},
+    {79, 255},
+    {83, 256},
+    {97, 257},
+    {101, 258},
+    {111, 259},
+    {83, 260},
+    {84, 261},
+    {68, 262},
+    {83, 263},
+    {97, 264},
+    {117, 265},
+    {110, 266},
+    {118, 267},
+    {83, 268},
+    {84, 269},
+    {67, 270},
+    {68, 271},
+    {79, 272},
+    {82, 273},
+    {83, 274},
+    {110, 275},
+    {114, 276},
+    {115, 277},
+    {76, 278},
+    {84, 279},
+    {68, 280},
+    {75, 281},
+    {83, 282},
+    {105, 283},
+    {111, 284},
+    {97, 285},
+    {105, 286},
+    {107, 287},
+    {68, 288},
+    {83, 289},
+    {68, 290},
+    {83, 291},
+    {83, 292},
+    {97, 293},
+    {65, 294},
+    {71, 295},
+    {79, 296},
+    {82, 297},
+    {83, 298},
+    {97, 299},
+    {111, 300},
+    {114, 301},
+    {121, 302},
+    {108, 303},
+    {109, 304},
+    {114, 305},
+    {115, 306},
+    {72, 307},
+    {73, 308},
+    {105, 309},
+    {111, 310},
+    {116, 311},
+    {117, 312},
+    {65, 313},
+    {68, 314},
+    {69, 315},
+    {72, 316},
+    {73, 317},
+    {77, 318},
+    {83, 319},
+    {85, 320},
+    {86, 321},
+    {89, 322},
+    {97, 323},
+    {105, 324},
+    {111, 325},
+    {121, 326},
+    {71, 327},
+    {82, 328},
+    {87, 329},
+    {83, 330},
+    {84, 331},
+    {83, 332},
+    {84, 333},
+    {75, 334},
+    {84, 335},
+    {99, 336},
+    {103, 337},
+    {108, 338},
+    {114, 339},
+    {117, 340},
+    {119, 341},
+    {97, 342},
+    {100, 343},
+    {83, 344},
+    {84, 345},
+    {113, 346},
+    {115, 347},
+    {83, 348},
+    {84, 349},
+    {115, 350},
+    {117, 351},
+    {68, 352},
+    {83, 353},
+    {67, 354},
+    {68, 355},
+    {70, 356},
+    {79, 357},
+    {80, 358},
+    {83, 359},
+    {84, 360},
+    {85, 361},
+    {90, 362},
+    {101, 363},
+    {105, 364},
+    {111, 365},
+    {68, 366},
+    {83, 367},
+    {112, 368},
+    {119, 369},
+    {32, 370},
+    {102, 371},
+    {67, 372},
+    {90, 373},
+    {68, 374},
+    {83, 375},
+    {68, 376},
+    {83, 377},
+    {84, 378},
+    {114, 379},
+    {118, 380},
+    {77, 381},
+    {82, 382},
+    {109, 383},
+    {114, 384},
+    {68, 385},
+    {69, 386},
+    {71, 387},
+    {72, 388},
+    {75, 389},
+    {77, 390},
+    {79, 391},
+    {83, 392},
+    {87, 393},
+    {89, 394},
+    {97, 395},
+    {101, 396},
+    {104, 397},
+    {111, 398},
+    {84, 399},
+    {79, 400},
+    {83, 401},
+    {84, 402},
+    {68, 403},
+    {83, 404},
+    {83, 405},
+    {84, 406},
+    {99, 407},
+    {107, 408},
+    {108, 409},
+    {112, 410},
+    {114, 411},
+    {68, 412},
+    {83, 413},
+    {83, 414},
+    {84, 415},
+    {105, 416},
+    {111, 417},
+    {83, 418},
+    {84, 419},
+    {69, 420},
+    {79, 421},
+    {111, 422},
+    {195, 423},
+    {65, 424},
+    {66, 425},
+    {67, 426},
+    {68, 427},
+    {71, 428},
+    {76, 429},
+    {82, 430},
+    {83, 431},
+    {89, 432},
+    {97, 433},
+    {101, 434},
+    {104, 435},
+    {105, 436},
+    {111, 437},
+    {114, 438},
+    {117, 439},
+    {75, 440},
+    {77, 441},
+    {83, 442},
+    {69, 443},
+    {84, 444},
+    {105, 445},
+    {107, 446},
+    {109, 447},
+    {68, 448},
+    {83, 449},
+    {97, 450},
+    {111, 451},
+    {68, 452},
+    {83, 453},
+    {83, 454},
+    {84, 455},
+    {108, 456},
+    {117, 457},
+    {65, 458},
+    {71, 459},
+    {101, 460},
+    {105, 461},
+    {65, 462},
+    {70, 463},
+    {72, 464},
+    {74, 465},
+    {75, 466},
+    {76, 467},
+    {77, 468},
+    {79, 469},
+    {82, 470},
+    {86, 471},
+    {97, 472},
+    {104, 473},
+    {105, 474},
+    {111, 475},
+    {117, 476},
+    {104, 477},
+    {106, 478},
+    {107, 479},
+    {110, 480},
+    {114, 481},
+    {118, 482},
+    {101, 483},
+    {109, 484},
+    {76, 485},
+    {84, 486},
+    {89, 487},
+    {90, 488},
+    {108, 489},
+    {114, 490},
+    {122, 491},
+    {83, 492},
+    {84, 493},
+    {43, 494},
+    {45, 495},
+    {48, 496},
+    {49, 497},
+    {50, 498},
+    {51, 499},
+    {52, 500},
+    {53, 501},
+    {54, 502},
+    {55, 503},
+    {56, 504},
+    {57, 505},
+    {58, 506},
+    {49, 507},
+    {51, 508},
+    {52, 509},
+    {48, 510},
+    {49, 511},
+    {50, 512},
+    {51, 513},
+    {52, 514},
+    {58, 515},
+    {58, 516},
+    {49, 517},
+    {51, 518},
+    {52, 519},
+    {58, 520},
+    {49, 521},
+    {51, 522},
+    {52, 523},
+    {58, 524},
+    {49, 525},
+    {51, 526},
+    {52, 527},
+    {58, 528},
+    {49, 529},
+    {51, 530},
+    {52, 531},
+    {58, 532},
+    {49, 533},
+    {51, 534},
+    {52, 535},
+    {49, 536},
+    {51, 537},
+    {52, 538},
+    {58, 539},
+    {49, 540},
+    {51, 541},
+    {52, 542},
+    {58, 543},
+    {49, 544},
+    {51, 545},
+    {52, 546},
+    {58, 547},
+    {49, 548},
+    {51, 549},
+    {52, 550},
+    {58, 551},
+    {49, 552},
+    {51, 553},
+    {52, 554},
+    {58, 555},
+    {49, 556},
+    {51, 557},
+    {52, 558},
+    {58, 559},
+    {49, 560},
+    {51, 561},
+    {52, 562},
+    {58, 563},
+    {49, 564},
+    {51, 565},
+    {52, 566},
+    {58, 567},
+    {49, 568},
+    {51, 569},
+    {52, 570},
+    {49, 571},
+    {50, 572},
+    {51, 573},
+    {52, 574},
+    {53, 575},
+    {54, 576},
+    {55, 577},
+    {56, 578},
+    {57, 579},
+    {48, 580},
+    {49, 581},
+    {50, 582},
+    {58, 583},
+    {58, 584},
+    {49, 585},
+    {51, 586},
+    {52, 587},
+    {58, 588},
+    {49, 589},
+    {51, 590},
+    {52, 591},
+    {58, 592},
+    {49, 593},
+    {51, 594},
+    {52, 595},
+    {49, 596},
+    {51, 597},
+    {52, 598},
+    {58, 599},
+    {49, 600},
+    {51, 601},
+    {52, 602},
+    {58, 603},
+    {49, 604},
+    {51, 605},
+    {52, 606},
+    {58, 607},
+    {49, 608},
+    {51, 609},
+    {52, 610},
+    {58, 611},
+    {49, 612},
+    {51, 613},
+    {52, 614},
+    {58, 615},
+    {49, 616},
+    {51, 617},
+    {52, 618},
+    {58, 619},
+    {49, 620},
+    {51, 621},
+    {52, 622},
+    {58, 623},
+    {49, 624},
+    {51, 625},
+    {52, 626},
+    {58, 627},
+    {49, 628},
+    {51, 629},
+    {52, 630},
+    {83, 631},
+    {84, 632},
+    {116, 633},
+    {117, 634},
+    {116, 635},
+    {117, 636},
+    {69, 637},
+    {76, 638},
+    {79, 639},
+    {85, 640},
+    {97, 641},
+    {101, 642},
+    {108, 643},
+    {111, 644},
+    {76, 645},
+    {83, 646},
+    {108, 647},
+    {115, 648},
+    {65, 649},
+    {69, 650},
+    {71, 651},
+    {73, 652},
+    {83, 653},
+    {97, 654},
+    {101, 655},
+    {75, 656},
+    {83, 657},
+    {84, 658},
+    {83, 659},
+    {84, 660},
+    {83, 661},
+    {84, 662},
+    {66, 663},
+    {84, 664},
+    {65, 665},
+    {32, 666},
+    {101, 667},
+    {65, 668},
+    {71, 669},
+    {83, 670},
+    {84, 671},
+    {83, 672},
+    {84, 673},
+    {69, 674},
+    {73, 675},
+    {83, 676},
+    {83, 677},
+    {84, 678},
+    {65, 679},
+    {69, 680},
+    {97, 681},
+    {101, 682},
+};
+
+static constexpr char BuiltinNameLabels[] =
+    "TTMTATTTTSTre Timeghanistan Timeazon adyr Timetobe Timelantic st"
+    "ralian TTSTTTTTTAN Common TimeTska a-Ata Timeaylight Timetandard"
+    " Timeummer Timeimebia Standard Timeentina Timeenia Timeaylight T"
+    "imetandard Timeentral astern estern Standard Timeaylight Saving "
+    "Timetandard Timeestern Standard Timeaylight Saving Timetandard T"
+    "imerbaijan Timeres Sandard Timemmer TimeTTTTutan TimeTTer Island"
+    " Timegladesh Standard Timeivia Timegainville Standard Times\303\255lia"
+    " tish nei Timeummer Timeimendian Ocean Timeummer TimeTTTSTTTTSTT"
+    "pe Verde Timentral ipperton Island Standard Timeba TTTTTTTTfrica"
+    " Timeaylight Timeuropean ndonesia Timetandard Timeestern Standar"
+    "d Timeummer Timeimeibalsan Sistmas Island Timeuk Timeos Archipel"
+    "ago|Indian Ocean Timeorro Standard Timeham aylight Timetandard T"
+    "imee Sa Standard Timeandard Timemmer Timeandard Timemmer Timeos "
+    "Islands Timeombia ummer Timeime Island Timedinated Universal Tim"
+    "eaylight Timetandard TimeVTUTTvis Timemont d'Urville TimeTTTstua"
+    "dor TimeTTTAfrica TimerIsland S andard Timemmer Timearibbean Tim"
+    "eaylight Timeuropean reenland ndonesian Timetandard Timeummer Ti"
+    "meimeummer TimeimeTTTlkland Islands rnando de Noronha Timeji Tim"
+    "eench rther-eastern European TimeTummer Timeimeuiana Timeouthern"
+    " and Antarctic TimeTTTTTorgia Standard Timelbert Island Timeeenw"
+    "ich Mean TimeTTT\303\241pagos Timebier IslandTime Timef Standard Timea"
+    "na TimeECTTTVTwaii\342\200\223Aleutian Taylight Timetandard Timerd and Mc"
+    "Donald Islandsre Avanc\303\251e d'Europe Centraleg Kong Timed ummer Ti"
+    "meimeTTTdrael WTTTan Standard Timechina Timen sh Standard Timeut"
+    "sk Timeaylight Timetandard Timeaylight Timetandard TimeTpan Stan"
+    "dard TimeLTTSTATTasnoyarsk Timergyzstan Timeiningrad Timechatka "
+    "Timeea Standard Timerae TimeSTNTne Islandsrd Howe Sandard Timemm"
+    "er TimeTTTTTTddle European anmar Standard TimeTTTTTquarie Island"
+    " Station Timeadan Timeritius Timeson Station Timeysia ives Timet"
+    "andard Timeimeuesas Islands Timehall Islands Timeummer Timeimeco"
+    "w Timentain aylight Timetandard TimeTTTVTTTTue TimeTTal Timeound"
+    "land aledonia Timeealand aylight Timetandard Timeaylight Timetan"
+    "dard Timeimefolk Island Timeosibirsk Time STATsk Timeal TimeTTTT"
+    "NTTTru Timehnpei Standard TimeTTTTTific istan Standard Timeau Ti"
+    "meua New Guinea Timeaguay aylight Timetandard Timeummer Timeimel"
+    "ippine enix Island Timetandard TimeimeTTTthera Research Station "
+    "Time\251union TimeTTTTSTTOTychelles Timeowa Station Timengapore rin"
+    "ame TimeTTTTnt Pierre and Miquelon halin Island Timeaylight Time"
+    "tandard Timera Timea aylight Timetandard Timetandard Timeimeomon"
+    " Islands Timeth frican Standard Timeeorgia and the South Sandwic"
+    "h Islands Timednekolymsk Time Lanka Standard TimeHTTATTTTTTTaila"
+    "nd Standard Timemor Leste Timeiti Timeikistan Timeelau Timega Ti"
+    "mekalu Timey Timeenistan TimeACTaanbaatar Suguay Sbekistan TimeT"
+    "-505505505505505505505505505505505505505505505505505505505505505"
+    "505505505505505505Tandard Timemmer Timeandard Timemmer TimeTATTn"
+    "uatunezuelan Standard Timeadivostok TimeTTgograd Timetok Station"
+    " TimeTke Island TimestTTTTrn frica reenland ummer Timeimeummer T"
+    "imeimeuropean ndonesian Timetandard Timeummer TimeimeKTKTkutsk T"
+    "imekaterinburg Time"
+    "";
+
+static inline const Timezone& TZ(const std::string& name);
+static inline const Timezone& TZ(TimezoneId id);
+struct BaseTimezone {
+    Timezone tz;
+    BaseTimezone() { tz = TZ(UTC_TimezoneId); }
+};
 
 struct ACDT_Timezone: public BaseTimezone {
     ACDT_Timezone(): BaseTimezone() {
-        tz = TZ("ACDT");
+        tz = TZ(ACDT_TimezoneId);
     }
 };
 struct ACST_Timezone: public BaseTimezone {
     ACST_Timezone(): BaseTimezone() {
-        tz = TZ("ACST");
+        tz = TZ(ACST_TimezoneId);
     }
 };
 struct ACT_Timezone: public BaseTimezone {
     ACT_Timezone(): BaseTimezone() {
-        tz = TZ("ACT");
+        tz = TZ(ACT_TimezoneId);
     }
 };
 struct ACWST_Timezone: public BaseTimezone {
     ACWST_Timezone(): BaseTimezone() {
-        tz = TZ("ACWST");
+        tz = TZ(ACWST_TimezoneId);
     }
 };
 struct ADT_Timezone: public BaseTimezone {
     ADT_Timezone(): BaseTimezone() {
-        tz = TZ("ADT");
+        tz = TZ(ADT_TimezoneId);
     }
 };
 struct AEDT_Timezone: public BaseTimezone {
     AEDT_Timezone(): BaseTimezone() {
-        tz = TZ("AEDT");
+        tz = TZ(AEDT_TimezoneId);
     }
 };
 struct AEST_Timezone: public BaseTimezone {
     AEST_Timezone(): BaseTimezone() {
-        tz = TZ("AEST");
+        tz = TZ(AEST_TimezoneId);
     }
 };
 struct AFT_Timezone: public BaseTimezone {
     AFT_Timezone(): BaseTimezone() {
-        tz = TZ("AFT");
+        tz = TZ(AFT_TimezoneId);
     }
 };
 struct AKDT_Timezone: public BaseTimezone {
     AKDT_Timezone(): BaseTimezone() {
-        tz = TZ("AKDT");
+        tz = TZ(AKDT_TimezoneId);
     }
 };
 struct AKST_Timezone: public BaseTimezone {
     AKST_Timezone(): BaseTimezone() {
-        tz = TZ("AKST");
+        tz = TZ(AKST_TimezoneId);
     }
 };
 struct ALMT_Timezone: public BaseTimezone {
     ALMT_Timezone(): BaseTimezone() {
-        tz = TZ("ALMT");
+        tz = TZ(ALMT_TimezoneId);
     }
 };
 struct AMST_Timezone: public BaseTimezone {
     AMST_Timezone(): BaseTimezone() {
-        tz = TZ("AMST");
+        tz = TZ(AMST_TimezoneId);
     }
 };
 struct AMT_Timezone: public BaseTimezone {
     AMT_Timezone(): BaseTimezone() {
-        tz = TZ("AMT");
+        tz = TZ(AMT_TimezoneId);
     }
 };
 struct ANAT_Timezone: public BaseTimezone {
     ANAT_Timezone(): BaseTimezone() {
-        tz = TZ("ANAT");
+        tz = TZ(ANAT_TimezoneId);
     }
 };
 struct AQTT_Timezone: public BaseTimezone {
     AQTT_Timezone(): BaseTimezone() {
-        tz = TZ("AQTT");
+        tz = TZ(AQTT_TimezoneId);
     }
 };
 struct ART_Timezone: public BaseTimezone {
     ART_Timezone(): BaseTimezone() {
-        tz = TZ("ART");
+        tz = TZ(ART_TimezoneId);
     }
 };
 struct AST_Timezone: public BaseTimezone {
     AST_Timezone(): BaseTimezone() {
-        tz = TZ("AST");
+        tz = TZ(AST_TimezoneId);
     }
 };
 struct AWST_Timezone: public BaseTimezone {
     AWST_Timezone(): BaseTimezone() {
-        tz = TZ("AWST");
+        tz = TZ(AWST_TimezoneId);
     }
 };
 struct AZOST_Timezone: public BaseTimezone {
     AZOST_Timezone(): BaseTimezone() {
-        tz = TZ("AZOST");
+        tz = TZ(AZOST_TimezoneId);
     }
 };
 struct AZOT_Timezone: public BaseTimezone {
     AZOT_Timezone(): BaseTimezone() {
-        tz = TZ("AZOT");
+        tz = TZ(AZOT_TimezoneId);
     }
 };
 struct AZT_Timezone: public BaseTimezone {
     AZT_Timezone(): BaseTimezone() {
-        tz = TZ("AZT");
+        tz = TZ(AZT_TimezoneId);
     }
 };
 struct BIOT_Timezone: public BaseTimezone {
     BIOT_Timezone(): BaseTimezone() {
-        tz = TZ("BIOT");
+        tz = TZ(BIOT_TimezoneId);
     }
 };
 struct BIT_Timezone: public BaseTimezone {
     BIT_Timezone(): BaseTimezone() {
-        tz = TZ("BIT");
+        tz = TZ(BIT_TimezoneId);
     }
 };
 struct BNT_Timezone: public BaseTimezone {
     BNT_Timezone(): BaseTimezone() {
-        tz = TZ("BNT");
+        tz = TZ(BNT_TimezoneId);
     }
 };
 struct BOT_Timezone: public BaseTimezone {
     BOT_Timezone(): BaseTimezone() {
-        tz = TZ("BOT");
+        tz = TZ(BOT_TimezoneId);
     }
 };
 struct BRST_Timezone: public BaseTimezone {
     BRST_Timezone(): BaseTimezone() {
-        tz = TZ("BRST");
+        tz = TZ(BRST_TimezoneId);
     }
 };
 struct BRT_Timezone: public BaseTimezone {
     BRT_Timezone(): BaseTimezone() {
-        tz = TZ("BRT");
+        tz = TZ(BRT_TimezoneId);
     }
 };
 struct BST_Timezone: public BaseTimezone {
     BST_Timezone(): BaseTimezone() {
-        tz = TZ("BST");
+        tz = TZ(BST_TimezoneId);
     }
 };
 struct BTT_Timezone: public BaseTimezone {
     BTT_Timezone(): BaseTimezone() {
-        tz = TZ("BTT");
+        tz = TZ(BTT_TimezoneId);
     }
 };
 struct CAT_Timezone: public BaseTimezone {
     CAT_Timezone(): BaseTimezone() {
-        tz = TZ("CAT");
+        tz = TZ(CAT_TimezoneId);
     }
 };
 struct CCT_Timezone: public BaseTimezone {
     CCT_Timezone(): BaseTimezone() {
-        tz = TZ("CCT");
+        tz = TZ(CCT_TimezoneId);
     }
 };
 struct CDT_Timezone: public BaseTimezone {
     CDT_Timezone(): BaseTimezone() {
-        tz = TZ("CDT");
+        tz = TZ(CDT_TimezoneId);
     }
 };
 struct CEST_Timezone: public BaseTimezone {
     CEST_Timezone(): BaseTimezone() {
-        tz = TZ("CEST");
+        tz = TZ(CEST_TimezoneId);
     }
 };
 struct CET_Timezone: public BaseTimezone {
     CET_Timezone(): BaseTimezone() {
-        tz = TZ("CET");
+        tz = TZ(CET_TimezoneId);
     }
 };
 struct CHADT_Timezone: public BaseTimezone {
     CHADT_Timezone(): BaseTimezone() {
-        tz = TZ("CHADT");
+        tz = TZ(CHADT_TimezoneId);
     }
 };
 struct CHAST_Timezone: public BaseTimezone {
     CHAST_Timezone(): BaseTimezone() {
-        tz = TZ("CHAST");
+        tz = TZ(CHAST_TimezoneId);
     }
 };
 struct CHOST_Timezone: public BaseTimezone {
     CHOST_Timezone(): BaseTimezone() {
-        tz = TZ("CHOST");
+        tz = TZ(CHOST_TimezoneId);
     }
 };
 struct CHOT_Timezone: public BaseTimezone {
     CHOT_Timezone(): BaseTimezone() {
-        tz = TZ("CHOT");
+        tz = TZ(CHOT_TimezoneId);
     }
 };
 struct CHST_Timezone: public BaseTimezone {
     CHST_Timezone(): BaseTimezone() {
-        tz = TZ("CHST");
+        tz = TZ(CHST_TimezoneId);
     }
 };
 struct CHUT_Timezone: public BaseTimezone {
     CHUT_Timezone(): BaseTimezone() {
-        tz = TZ("CHUT");
+        tz = TZ(CHUT_TimezoneId);
     }
 };
 struct CIST_Timezone: public BaseTimezone {
     CIST_Timezone(): BaseTimezone() {
-        tz = TZ("CIST");
+        tz = TZ(CIST_TimezoneId);
     }
 };
 struct CKT_Timezone: public BaseTimezone {
     CKT_Timezone(): BaseTimezone() {
-        tz = TZ("CKT");
+        tz = TZ(CKT_TimezoneId);
     }
 };
 struct CLST_Timezone: public BaseTimezone {
     CLST_Timezone(): BaseTimezone() {
-        tz = TZ("CLST");
+        tz = TZ(CLST_TimezoneId);
     }
 };
 struct CLT_Timezone: public BaseTimezone {
     CLT_Timezone(): BaseTimezone() {
-        tz = TZ("CLT");
+        tz = TZ(CLT_TimezoneId);
     }
 };
 struct COST_Timezone: public BaseTimezone {
     COST_Timezone(): BaseTimezone() {
-        tz = TZ("COST");
+        tz = TZ(COST_TimezoneId);
     }
 };
 struct COT_Timezone: public BaseTimezone {
     COT_Timezone(): BaseTimezone() {
-        tz = TZ("COT");
+        tz = TZ(COT_TimezoneId);
     }
 };
 struct CST_Timezone: public BaseTimezone {
     CST_Timezone(): BaseTimezone() {
-        tz = TZ("CST");
+        tz = TZ(CST_TimezoneId);
     }
 };
 struct CVT_Timezone: public BaseTimezone {
     CVT_Timezone(): BaseTimezone() {
-        tz = TZ("CVT");
+        tz = TZ(CVT_TimezoneId);
     }
 };
 struct CWST_Timezone: public BaseTimezone {
     CWST_Timezone(): BaseTimezone() {
-        tz = TZ("CWST");
+        tz = TZ(CWST_TimezoneId);
     }
 };
 struct CXT_Timezone: public BaseTimezone {
     CXT_Timezone(): BaseTimezone() {
-        tz = TZ("CXT");
+        tz = TZ(CXT_TimezoneId);
     }
 };
 struct DAVT_Timezone: public BaseTimezone {
     DAVT_Timezone(): BaseTimezone() {
-        tz = TZ("DAVT");
+        tz = TZ(DAVT_TimezoneId);
     }
 };
 struct DDUT_Timezone: public BaseTimezone {
     DDUT_Timezone(): BaseTimezone() {
-        tz = TZ("DDUT");
+        tz = TZ(DDUT_TimezoneId);
     }
 };
 struct DFT_Timezone: public BaseTimezone {
     DFT_Timezone(): BaseTimezone() {
-        tz = TZ("DFT");
+        tz = TZ(DFT_TimezoneId);
     }
 };
 struct EASST_Timezone: public BaseTimezone {
     EASST_Timezone(): BaseTimezone() {
-        tz = TZ("EASST");
+        tz = TZ(EASST_TimezoneId);
     }
 };
 struct EAST_Timezone: public BaseTimezone {
     EAST_Timezone(): BaseTimezone() {
-        tz = TZ("EAST");
+        tz = TZ(EAST_TimezoneId);
     }
 };
 struct EAT_Timezone: public BaseTimezone {
     EAT_Timezone(): BaseTimezone() {
-        tz = TZ("EAT");
+        tz = TZ(EAT_TimezoneId);
     }
 };
 struct ECT_Timezone: public BaseTimezone {
     ECT_Timezone(): BaseTimezone() {
-        tz = TZ("ECT");
+        tz = TZ(ECT_TimezoneId);
     }
 };
 struct EDT_Timezone: public BaseTimezone {
     EDT_Timezone(): BaseTimezone() {
-        tz = TZ("EDT");
+        tz = TZ(EDT_TimezoneId);
     }
 };
 struct EEST_Timezone: public BaseTimezone {
     EEST_Timezone(): BaseTimezone() {
-        tz = TZ("EEST");
+        tz = TZ(EEST_TimezoneId);
     }
 };
 struct EET_Timezone: public BaseTimezone {
     EET_Timezone(): BaseTimezone() {
-        tz = TZ("EET");
+        tz = TZ(EET_TimezoneId);
     }
 };
 struct EGST_Timezone: public BaseTimezone {
     EGST_Timezone(): BaseTimezone() {
-        tz = TZ("EGST");
+        tz = TZ(EGST_TimezoneId);
     }
 };
 struct EGT_Timezone: public BaseTimezone {
     EGT_Timezone(): BaseTimezone() {
-        tz = TZ("EGT");
+        tz = TZ(EGT_TimezoneId);
     }
 };
 struct EST_Timezone: public BaseTimezone {
     EST_Timezone(): BaseTimezone() {
-        tz = TZ("EST");
+        tz = TZ(EST_TimezoneId);
     }
 };
 struct FET_Timezone: public BaseTimezone {
     FET_Timezone(): BaseTimezone() {
-        tz = TZ("FET");
+        tz = TZ(FET_TimezoneId);
     }
 };
 struct FJT_Timezone: public BaseTimezone {
     FJT_Timezone(): BaseTimezone() {
-        tz = TZ("FJT");
+        tz = TZ(FJT_TimezoneId);
     }
 };
 struct FKST_Timezone: public BaseTimezone {
     FKST_Timezone(): BaseTimezone() {
-        tz = TZ("FKST");
+        tz = TZ(FKST_TimezoneId);
     }
 };
 struct FKT_Timezone: public BaseTimezone {
     FKT_Timezone(): BaseTimezone() {
-        tz = TZ("FKT");
+        tz = TZ(FKT_TimezoneId);
     }
 };
 struct FNT_Timezone: public BaseTimezone {
     FNT_Timezone(): BaseTimezone() {
-        tz = TZ("FNT");
+        tz = TZ(FNT_TimezoneId);
     }
 };
 struct GALT_Timezone: public BaseTimezone {
     GALT_Timezone(): BaseTimezone() {
-        tz = TZ("GALT");
+        tz = TZ(GALT_TimezoneId);
     }
 };
 struct GAMT_Timezone: public BaseTimezone {
     GAMT_Timezone(): BaseTimezone() {
-        tz = TZ("GAMT");
+        tz = TZ(GAMT_TimezoneId);
     }
 };
 struct GET_Timezone: public BaseTimezone {
     GET_Timezone(): BaseTimezone() {
-        tz = TZ("GET");
+        tz = TZ(GET_TimezoneId);
     }
 };
 struct GFT_Timezone: public BaseTimezone {
     GFT_Timezone(): BaseTimezone() {
-        tz = TZ("GFT");
+        tz = TZ(GFT_TimezoneId);
     }
 };
 struct GILT_Timezone: public BaseTimezone {
     GILT_Timezone(): BaseTimezone() {
-        tz = TZ("GILT");
+        tz = TZ(GILT_TimezoneId);
     }
 };
 struct GIT_Timezone: public BaseTimezone {
     GIT_Timezone(): BaseTimezone() {
-        tz = TZ("GIT");
+        tz = TZ(GIT_TimezoneId);
     }
 };
 struct GMT_Timezone: public BaseTimezone {
     GMT_Timezone(): BaseTimezone() {
-        tz = TZ("GMT");
+        tz = TZ(GMT_TimezoneId);
     }
 };
 struct GST_Timezone: public BaseTimezone {
     GST_Timezone(): BaseTimezone() {
-        tz = TZ("GST");
+        tz = TZ(GST_TimezoneId);
     }
 };
 struct GYT_Timezone: public BaseTimezone {
     GYT_Timezone(): BaseTimezone() {
-        tz = TZ("GYT");
+        tz = TZ(GYT_TimezoneId);
     }
 };
 struct HAEC_Timezone: public BaseTimezone {
     HAEC_Timezone(): BaseTimezone() {
-        tz = TZ("HAEC");
+        tz = TZ(HAEC_TimezoneId);
     }
 };
 struct HDT_Timezone: public BaseTimezone {
     HDT_Timezone(): BaseTimezone() {
-        tz = TZ("HDT");
+        tz = TZ(HDT_TimezoneId);
     }
 };
 struct HKT_Timezone: public BaseTimezone {
     HKT_Timezone(): BaseTimezone() {
-        tz = TZ("HKT");
+        tz = TZ(HKT_TimezoneId);
     }
 };
 struct HMT_Timezone: public BaseTimezone {
     HMT_Timezone(): BaseTimezone() {
-        tz = TZ("HMT");
+        tz = TZ(HMT_TimezoneId);
     }
 };
 struct HOVST_Timezone: public BaseTimezone {
     HOVST_Timezone(): BaseTimezone() {
-        tz = TZ("HOVST");
+        tz = TZ(HOVST_TimezoneId);
     }
 };
 struct HOVT_Timezone: public BaseTimezone {
     HOVT_Timezone(): BaseTimezone() {
-        tz = TZ("HOVT");
+        tz = TZ(HOVT_TimezoneId);
     }
 };
 struct HST_Timezone: public BaseTimezone {
     HST_Timezone(): BaseTimezone() {
-        tz = TZ("HST");
+        tz = TZ(HST_TimezoneId);
     }
 };
 struct ICT_Timezone: public BaseTimezone {
     ICT_Timezone(): BaseTimezone() {
-        tz = TZ("ICT");
+        tz = TZ(ICT_TimezoneId);
     }
 };
 struct IDLW_Timezone: public BaseTimezone {
     IDLW_Timezone(): BaseTimezone() {
-        tz = TZ("IDLW");
+        tz = TZ(IDLW_TimezoneId);
     }
 };
 struct IDT_Timezone: public BaseTimezone {
     IDT_Timezone(): BaseTimezone() {
-        tz = TZ("IDT");
+        tz = TZ(IDT_TimezoneId);
     }
 };
 struct IOT_Timezone: public BaseTimezone {
     IOT_Timezone(): BaseTimezone() {
-        tz = TZ("IOT");
+        tz = TZ(IOT_TimezoneId);
     }
 };
 struct IRDT_Timezone: public BaseTimezone {
     IRDT_Timezone(): BaseTimezone() {
-        tz = TZ("IRDT");
+        tz = TZ(IRDT_TimezoneId);
     }
 };
 struct IRKT_Timezone: public BaseTimezone {
     IRKT_Timezone(): BaseTimezone() {
-        tz = TZ("IRKT");
+        tz = TZ(IRKT_TimezoneId);
     }
 };
 struct IRST_Timezone: public BaseTimezone {
     IRST_Timezone(): BaseTimezone() {
-        tz = TZ("IRST");
+        tz = TZ(IRST_TimezoneId);
     }
 };
 struct IST_Timezone: public BaseTimezone {
     IST_Timezone(): BaseTimezone() {
-        tz = TZ("IST");
+        tz = TZ(IST_TimezoneId);
     }
 };
 struct JST_Timezone: public BaseTimezone {
     JST_Timezone(): BaseTimezone() {
-        tz = TZ("JST");
+        tz = TZ(JST_TimezoneId);
     }
 };
 struct KALT_Timezone: public BaseTimezone {
     KALT_Timezone(): BaseTimezone() {
-        tz = TZ("KALT");
+        tz = TZ(KALT_TimezoneId);
     }
 };
 struct KGT_Timezone: public BaseTimezone {
     KGT_Timezone(): BaseTimezone() {
-        tz = TZ("KGT");
+        tz = TZ(KGT_TimezoneId);
     }
 };
 struct KOST_Timezone: public BaseTimezone {
     KOST_Timezone(): BaseTimezone() {
-        tz = TZ("KOST");
+        tz = TZ(KOST_TimezoneId);
     }
 };
 struct KRAT_Timezone: public BaseTimezone {
     KRAT_Timezone(): BaseTimezone() {
-        tz = TZ("KRAT");
+        tz = TZ(KRAT_TimezoneId);
     }
 };
 struct KST_Timezone: public BaseTimezone {
     KST_Timezone(): BaseTimezone() {
-        tz = TZ("KST");
+        tz = TZ(KST_TimezoneId);
     }
 };
 struct LHST_Timezone: public BaseTimezone {
     LHST_Timezone(): BaseTimezone() {
-        tz = TZ("LHST");
+        tz = TZ(LHST_TimezoneId);
     }
 };
 struct LINT_Timezone: public BaseTimezone {
     LINT_Timezone(): BaseTimezone() {
-        tz = TZ("LINT");
+        tz = TZ(LINT_TimezoneId);
     }
 };
 struct MAGT_Timezone: public BaseTimezone {
     MAGT_Timezone(): BaseTimezone() {
-        tz = TZ("MAGT");
+        tz = TZ(MAGT_TimezoneId);
     }
 };
 struct MART_Timezone: public BaseTimezone {
     MART_Timezone(): BaseTimezone() {
-        tz = TZ("MART");
+        tz = TZ(MART_TimezoneId);
     }
 };
 struct MAWT_Timezone: public BaseTimezone {
     MAWT_Timezone(): BaseTimezone() {
-        tz = TZ("MAWT");
+        tz = TZ(MAWT_TimezoneId);
     }
 };
 struct MDT_Timezone: public BaseTimezone {
     MDT_Timezone(): BaseTimezone() {
-        tz = TZ("MDT");
+        tz = TZ(MDT_TimezoneId);
     }
 };
 struct MEST_Timezone: public BaseTimezone {
     MEST_Timezone(): BaseTimezone() {
-        tz = TZ("MEST");
+        tz = TZ(MEST_TimezoneId);
     }
 };
 struct MET_Timezone: public BaseTimezone {
     MET_Timezone(): BaseTimezone() {
-        tz = TZ("MET");
+        tz = TZ(MET_TimezoneId);
     }
 };
 struct MHT_Timezone: public BaseTimezone {
     MHT_Timezone(): BaseTimezone() {
-        tz = TZ("MHT");
+        tz = TZ(MHT_TimezoneId);
     }
 };
 struct MIST_Timezone: public BaseTimezone {
     MIST_Timezone(): BaseTimezone() {
-        tz = TZ("MIST");
+        tz = TZ(MIST_TimezoneId);
     }
 };
 struct MIT_Timezone: public BaseTimezone {
     MIT_Timezone(): BaseTimezone() {
-        tz = TZ("MIT");
+        tz = TZ(MIT_TimezoneId);
     }
 };
 struct MMT_Timezone: public BaseTimezone {
     MMT_Timezone(): BaseTimezone() {
-        tz = TZ("MMT");
+        tz = TZ(MMT_TimezoneId);
     }
 };
 struct MSK_Timezone: public BaseTimezone {
     MSK_Timezone(): BaseTimezone() {
-        tz = TZ("MSK");
+        tz = TZ(MSK_TimezoneId);
     }
 };
 struct MST_Timezone: public BaseTimezone {
     MST_Timezone(): BaseTimezone() {
-        tz = TZ("MST");
+        tz = TZ(MST_TimezoneId);
     }
 };
 struct MUT_Timezone: public BaseTimezone {
     MUT_Timezone(): BaseTimezone() {
-        tz = TZ("MUT");
+        tz = TZ(MUT_TimezoneId);
     }
 };
 struct MVT_Timezone: public BaseTimezone {
     MVT_Timezone(): BaseTimezone() {
-        tz = TZ("MVT");
+        tz = TZ(MVT_TimezoneId);
     }
 };
 struct MYT_Timezone: public BaseTimezone {
     MYT_Timezone(): BaseTimezone() {
-        tz = TZ("MYT");
+        tz = TZ(MYT_TimezoneId);
     }
 };
 struct NCT_Timezone: public BaseTimezone {
     NCT_Timezone(): BaseTimezone() {
-        tz = TZ("NCT");
+        tz = TZ(NCT_TimezoneId);
     }
 };
 struct NDT_Timezone: public BaseTimezone {
     NDT_Timezone(): BaseTimezone() {
-        tz = TZ("NDT");
+        tz = TZ(NDT_TimezoneId);
     }
 };
 struct NFT_Timezone: public BaseTimezone {
     NFT_Timezone(): BaseTimezone() {
-        tz = TZ("NFT");
+        tz = TZ(NFT_TimezoneId);
     }
 };
 struct NOVT_Timezone: public BaseTimezone {
     NOVT_Timezone(): BaseTimezone() {
-        tz = TZ("NOVT");
+        tz = TZ(NOVT_TimezoneId);
     }
 };
 struct NPT_Timezone: public BaseTimezone {
     NPT_Timezone(): BaseTimezone() {
-        tz = TZ("NPT");
+        tz = TZ(NPT_TimezoneId);
     }
 };
 struct NST_Timezone: public BaseTimezone {
     NST_Timezone(): BaseTimezone() {
-        tz = TZ("NST");
+        tz = TZ(NST_TimezoneId);
     }
 };
 struct NT_Timezone: public BaseTimezone {
     NT_Timezone(): BaseTimezone() {
-        tz = TZ("NT");
+        tz = TZ(NT_TimezoneId);
     }
 };
 struct NUT_Timezone: public BaseTimezone {
     NUT_Timezone(): BaseTimezone() {
-        tz = TZ("NUT");
+        tz = TZ(NUT_TimezoneId);
     }
 };
 struct NZDT_Timezone: public BaseTimezone {
     NZDT_Timezone(): BaseTimezone() {
-        tz = TZ("NZDT");
+        tz = TZ(NZDT_TimezoneId);
     }
 };
 struct NZST_Timezone: public BaseTimezone {
     NZST_Timezone(): BaseTimezone() {
-        tz = TZ("NZST");
+        tz = TZ(NZST_TimezoneId);
     }
 };
 struct OMST_Timezone: public BaseTimezone {
     OMST_Timezone(): BaseTimezone() {
-        tz = TZ("OMST");
+        tz = TZ(OMST_TimezoneId);
     }
 };
 struct ORAT_Timezone: public BaseTimezone {
     ORAT_Timezone(): BaseTimezone() {
-        tz = TZ("ORAT");
+        tz = TZ(ORAT_TimezoneId);
     }
 };
 struct PDT_Timezone: public BaseTimezone {
     PDT_Timezone(): BaseTimezone() {
-        tz = TZ("PDT");
+        tz = TZ(PDT_TimezoneId);
     }
 };
 struct PET_Timezone: public BaseTimezone {
     PET_Timezone(): BaseTimezone() {
-        tz = TZ("PET");
+        tz = TZ(PET_TimezoneId);
     }
 };
 struct PETT_Timezone: public BaseTimezone {
     PETT_Timezone(): BaseTimezone() {
-        tz = TZ("PETT");
+        tz = TZ(PETT_TimezoneId);
     }
 };
 struct PGT_Timezone: public BaseTimezone {
     PGT_Timezone(): BaseTimezone() {
-        tz = TZ("PGT");
+        tz = TZ(PGT_TimezoneId);
     }
 };
 struct PHOT_Timezone: public BaseTimezone {
     PHOT_Timezone(): BaseTimezone() {
-        tz = TZ("PHOT");
+        tz = TZ(PHOT_TimezoneId);
     }
 };
 struct PHST_Timezone: public BaseTimezone {
     PHST_Timezone(): BaseTimezone() {
-        tz = TZ("PHST");
+        tz = TZ(PHST_TimezoneId);
     }
 };
 struct PHT_Timezone: public BaseTimezone {
     PHT_Timezone(): BaseTimezone() {
-        tz = TZ("PHT");
+        tz = TZ(PHT_TimezoneId);
     }
 };
 struct PKT_Timezone: public BaseTimezone {
     PKT_Timezone(): BaseTimezone() {
-        tz = TZ("PKT");
+        tz = TZ(PKT_TimezoneId);
     }
 };
 struct PMDT_Timezone: public BaseTimezone {
     PMDT_Timezone(): BaseTimezone() {
-        tz = TZ("PMDT");
+        tz = TZ(PMDT_TimezoneId);
     }
 };
 struct PMST_Timezone: public BaseTimezone {
     PMST_Timezone(): BaseTimezone() {
-        tz = TZ("PMST");
+        tz = TZ(PMST_TimezoneId);
     }
 };
 struct PONT_Timezone: public BaseTimezone {
     PONT_Timezone(): BaseTimezone() {
-        tz = TZ("PONT");
+        tz = TZ(PONT_TimezoneId);
     }
 };
 struct PST_Timezone: public BaseTimezone {
     PST_Timezone(): BaseTimezone() {
-        tz = TZ("PST");
+        tz = TZ(PST_TimezoneId);
     }
 };
 struct PWT_Timezone: public BaseTimezone {
     PWT_Timezone(): BaseTimezone() {
-        tz = TZ("PWT");
+        tz = TZ(PWT_TimezoneId);
     }
 };
 struct PYST_Timezone: public BaseTimezone {
     PYST_Timezone(): BaseTimezone() {
-        tz = TZ("PYST");
+        tz = TZ(PYST_TimezoneId);
     }
 };
 struct PYT_Timezone: public BaseTimezone {
     PYT_Timezone(): BaseTimezone() {
-        tz = TZ("PYT");
+        tz = TZ(PYT_TimezoneId);
     }
 };
 struct RET_Timezone: public BaseTimezone {
     RET_Timezone(): BaseTimezone() {
-        tz = TZ("RET");
+        tz = TZ(RET_TimezoneId);
     }
 };
 struct ROTT_Timezone: public BaseTimezone {
     ROTT_Timezone(): BaseTimezone() {
-        tz = TZ("ROTT");
+        tz = TZ(ROTT_TimezoneId);
     }
 };
 struct SAKT_Timezone: public BaseTimezone {
     SAKT_Timezone(): BaseTimezone() {
-        tz = TZ("SAKT");
+        tz = TZ(SAKT_TimezoneId);
     }
 };
 struct SAMT_Timezone: public BaseTimezone {
     SAMT_Timezone(): BaseTimezone() {
-        tz = TZ("SAMT");
+        tz = TZ(SAMT_TimezoneId);
     }
 };
 struct SAST_Timezone: public BaseTimezone {
     SAST_Timezone(): BaseTimezone() {
-        tz = TZ("SAST");
+        tz = TZ(SAST_TimezoneId);
     }
 };
 struct SBT_Timezone: public BaseTimezone {
     SBT_Timezone(): BaseTimezone() {
-        tz = TZ("SBT");
+        tz = TZ(SBT_TimezoneId);
     }
 };
 struct SCT_Timezone: public BaseTimezone {
     SCT_Timezone(): BaseTimezone() {
-        tz = TZ("SCT");
+        tz = TZ(SCT_TimezoneId);
     }
 };
 struct SDT_Timezone: public BaseTimezone {
     SDT_Timezone(): BaseTimezone() {
-        tz = TZ("SDT");
+        tz = TZ(SDT_TimezoneId);
     }
 };
 struct SGT_Timezone: public BaseTimezone {
     SGT_Timezone(): BaseTimezone() {
-        tz = TZ("SGT");
+        tz = TZ(SGT_TimezoneId);
     }
 };
 struct SLST_Timezone: public BaseTimezone {
     SLST_Timezone(): BaseTimezone() {
-        tz = TZ("SLST");
+        tz = TZ(SLST_TimezoneId);
     }
 };
 struct SRET_Timezone: public BaseTimezone {
     SRET_Timezone(): BaseTimezone() {
-        tz = TZ("SRET");
+        tz = TZ(SRET_TimezoneId);
     }
 };
 struct SRT_Timezone: public BaseTimezone {
     SRT_Timezone(): BaseTimezone() {
-        tz = TZ("SRT");
+        tz = TZ(SRT_TimezoneId);
     }
 };
 struct SST_Timezone: public BaseTimezone {
     SST_Timezone(): BaseTimezone() {
-        tz = TZ("SST");
+        tz = TZ(SST_TimezoneId);
     }
 };
 struct SYOT_Timezone: public BaseTimezone {
     SYOT_Timezone(): BaseTimezone() {
-        tz = TZ("SYOT");
+        tz = TZ(SYOT_TimezoneId);
     }
 };
 struct TAHT_Timezone: public BaseTimezone {
     TAHT_Timezone(): BaseTimezone() {
-        tz = TZ("TAHT");
+        tz = TZ(TAHT_TimezoneId);
     }
 };
 struct TFT_Timezone: public BaseTimezone {
     TFT_Timezone(): BaseTimezone() {
-        tz = TZ("TFT");
+        tz = TZ(TFT_TimezoneId);
     }
 };
 struct THA_Timezone: public BaseTimezone {
     THA_Timezone(): BaseTimezone() {
-        tz = TZ("THA");
+        tz = TZ(THA_TimezoneId);
     }
 };
 struct TJT_Timezone: public BaseTimezone {
     TJT_Timezone(): BaseTimezone() {
-        tz = TZ("TJT");
+        tz = TZ(TJT_TimezoneId);
     }
 };
 struct TKT_Timezone: public BaseTimezone {
     TKT_Timezone(): BaseTimezone() {
-        tz = TZ("TKT");
+        tz = TZ(TKT_TimezoneId);
     }
 };
 struct TLT_Timezone: public BaseTimezone {
     TLT_Timezone(): BaseTimezone() {
-        tz = TZ("TLT");
+        tz = TZ(TLT_TimezoneId);
     }
 };
 struct TMT_Timezone: public BaseTimezone {
     TMT_Timezone(): BaseTimezone() {
-        tz = TZ("TMT");
+        tz = TZ(TMT_TimezoneId);
     }
 };
 struct TOT_Timezone: public BaseTimezone {
     TOT_Timezone(): BaseTimezone() {
-        tz = TZ("TOT");
+        tz = TZ(TOT_TimezoneId);
     }
 };
 struct TRT_Timezone: public BaseTimezone {
     TRT_Timezone(): BaseTimezone() {
-        tz = TZ("TRT");
+        tz = TZ(TRT_TimezoneId);
     }
 };
 struct TVT_Timezone: public BaseTimezone {
     TVT_Timezone(): BaseTimezone() {
-        tz = TZ("TVT");
+        tz = TZ(TVT_TimezoneId);
     }
 };
 struct ULAST_Timezone: public BaseTimezone {
     ULAST_Timezone(): BaseTimezone() {
-        tz = TZ("ULAST");
+        tz = TZ(ULAST_TimezoneId);
     }
 };
 struct ULAT_Timezone: public BaseTimezone {
     ULAT_Timezone(): BaseTimezone() {
-        tz = TZ("ULAT");
+        tz = TZ(ULAT_TimezoneId);
     }
 };
 struct UTC_Timezone: public BaseTimezone {
     UTC_Timezone(): BaseTimezone() {
-        tz = TZ("UTC");
+        tz = TZ(UTC_TimezoneId);
     }
 };
 struct UYST_Timezone: public BaseTimezone {
     UYST_Timezone(): BaseTimezone() {
-        tz = TZ("UYST");
+        tz = TZ(UYST_TimezoneId);
     }
 };
 struct UYT_Timezone: public BaseTimezone {
     UYT_Timezone(): BaseTimezone() {
-        tz = TZ("UYT");
+        tz = TZ(UYT_TimezoneId);
     }
 };
 struct UZT_Timezone: public BaseTimezone {
     UZT_Timezone(): BaseTimezone() {
-        tz = TZ("UZT");
+        tz = TZ(UZT_TimezoneId);
     }
 };
 struct VET_Timezone: public BaseTimezone {
     VET_Timezone(): BaseTimezone() {
-        tz = TZ("VET");
+        tz = TZ(VET_TimezoneId);
     }
 };
 struct VLAT_Timezone: public BaseTimezone {
     VLAT_Timezone(): BaseTimezone() {
-        tz = TZ("VLAT");
+        tz = TZ(VLAT_TimezoneId);
     }
 };
 struct VOLT_Timezone: public BaseTimezone {
     VOLT_Timezone(): BaseTimezone() {
-        tz = TZ("VOLT");
+        tz = TZ(VOLT_TimezoneId);
     }
 };
 struct VOST_Timezone: public BaseTimezone {
     VOST_Timezone(): BaseTimezone() {
-        tz = TZ("VOST");
+        tz = TZ(VOST_TimezoneId);
     }
 };
 struct VUT_Timezone: public BaseTimezone {
     VUT_Timezone(): BaseTimezone() {
-        tz = TZ("VUT");
+        tz = TZ(VUT_TimezoneId);
     }
 };
 struct WAKT_Timezone: public BaseTimezone {
     WAKT_Timezone(): BaseTimezone() {
-        tz = TZ("WAKT");
+        tz = TZ(WAKT_TimezoneId);
     }
 };
 struct WAST_Timezone: public BaseTimezone {
     WAST_Timezone(): BaseTimezone() {
-        tz = TZ("WAST");
+        tz = TZ(WAST_TimezoneId);
     }
 };
 struct WAT_Timezone: public BaseTimezone {
     WAT_Timezone(): BaseTimezone() {
-        tz = TZ("WAT");
+        tz = TZ(WAT_TimezoneId);
     }
 };
 struct WEST_Timezone: public BaseTimezone {
     WEST_Timezone(): BaseTimezone() {
-        tz = TZ("WEST");
+        tz = TZ(WEST_TimezoneId);
     }
 };
 struct WET_Timezone: public BaseTimezone {
     WET_Timezone(): BaseTimezone() {
-        tz = TZ("WET");
+        tz = TZ(WET_TimezoneId);
     }
 };
 struct WGST_Timezone: public BaseTimezone {
     WGST_Timezone(): BaseTimezone() {
-        tz = TZ("WGST");
+        tz = TZ(WGST_TimezoneId);
     }
 };
 struct WGT_Timezone: public BaseTimezone {
     WGT_Timezone(): BaseTimezone() {
-        tz = TZ("WGT");
+        tz = TZ(WGT_TimezoneId);
     }
 };
 struct WIB_Timezone: public BaseTimezone {
     WIB_Timezone(): BaseTimezone() {
-        tz = TZ("WIB");
+        tz = TZ(WIB_TimezoneId);
     }
 };
 struct WIT_Timezone: public BaseTimezone {
     WIT_Timezone(): BaseTimezone() {
-        tz = TZ("WIT");
+        tz = TZ(WIT_TimezoneId);
     }
 };
 struct WITA_Timezone: public BaseTimezone {
     WITA_Timezone(): BaseTimezone() {
-        tz = TZ("WITA");
+        tz = TZ(WITA_TimezoneId);
     }
 };
 struct WST_Timezone: public BaseTimezone {
     WST_Timezone(): BaseTimezone() {
-        tz = TZ("WST");
+        tz = TZ(WST_TimezoneId);
     }
 };
 struct YAKT_Timezone: public BaseTimezone {
     YAKT_Timezone(): BaseTimezone() {
-        tz = TZ("YAKT");
+        tz = TZ(YAKT_TimezoneId);
     }
 };
 struct YEKT_Timezone: public BaseTimezone {
     YEKT_Timezone(): BaseTimezone() {
-        tz = TZ("YEKT");
+        tz = TZ(YEKT_TimezoneId);
     }
 };
 struct UTCm12_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm12_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-12");
+        tz = TZ(UTCmm12_TimezoneId);
     }
 };
 struct UTCm1215_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1215_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-12:15");
+        tz = TZ(UTCmm1215_TimezoneId);
     }
 };
 struct UTCm1230_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1230_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-12:30");
+        tz = TZ(UTCmm1230_TimezoneId);
     }
 };
 struct UTCm1245_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1245_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-12:45");
+        tz = TZ(UTCmm1245_TimezoneId);
     }
 };
 struct UTCm11_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm11_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-11");
+        tz = TZ(UTCmm11_TimezoneId);
     }
 };
 struct UTCm1115_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1115_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-11:15");
+        tz = TZ(UTCmm1115_TimezoneId);
     }
 };
 struct UTCm1130_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1130_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-11:30");
+        tz = TZ(UTCmm1130_TimezoneId);
     }
 };
 struct UTCm1145_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1145_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-11:45");
+        tz = TZ(UTCmm1145_TimezoneId);
     }
 };
 struct UTCm10_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm10_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-10");
+        tz = TZ(UTCmm10_TimezoneId);
     }
 };
 struct UTCm1015_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1015_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-10:15");
+        tz = TZ(UTCmm1015_TimezoneId);
     }
 };
 struct UTCm1030_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1030_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-10:30");
+        tz = TZ(UTCmm1030_TimezoneId);
     }
 };
 struct UTCm1045_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1045_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-10:45");
+        tz = TZ(UTCmm1045_TimezoneId);
     }
 };
 struct UTCm9_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm9_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-9");
+        tz = TZ(UTCmm9_TimezoneId);
     }
 };
 struct UTCm915_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm915_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-9:15");
+        tz = TZ(UTCmm915_TimezoneId);
     }
 };
 struct UTCm930_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm930_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-9:30");
+        tz = TZ(UTCmm930_TimezoneId);
     }
 };
 struct UTCm945_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm945_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-9:45");
+        tz = TZ(UTCmm945_TimezoneId);
     }
 };
 struct UTCm8_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm8_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-8");
+        tz = TZ(UTCmm8_TimezoneId);
     }
 };
 struct UTCm815_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm815_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-8:15");
+        tz = TZ(UTCmm815_TimezoneId);
     }
 };
 struct UTCm830_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm830_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-8:30");
+        tz = TZ(UTCmm830_TimezoneId);
     }
 };
 struct UTCm845_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm845_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-8:45");
+        tz = TZ(UTCmm845_TimezoneId);
     }
 };
 struct UTCm7_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm7_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-7");
+        tz = TZ(UTCmm7_TimezoneId);
     }
 };
 struct UTCm715_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm715_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-7:15");
+        tz = TZ(UTCmm715_TimezoneId);
     }
 };
 struct UTCm730_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm730_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-7:30");
+        tz = TZ(UTCmm730_TimezoneId);
     }
 };
 struct UTCm745_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm745_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-7:45");
+        tz = TZ(UTCmm745_TimezoneId);
     }
 };
 struct UTCm6_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm6_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-6");
+        tz = TZ(UTCmm6_TimezoneId);
     }
 };
 struct UTCm615_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm615_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-6:15");
+        tz = TZ(UTCmm615_TimezoneId);
     }
 };
 struct UTCm630_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm630_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-6:30");
+        tz = TZ(UTCmm630_TimezoneId);
     }
 };
 struct UTCm645_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm645_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-6:45");
+        tz = TZ(UTCmm645_TimezoneId);
     }
 };
 struct UTCm5_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm5_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-5");
+        tz = TZ(UTCmm5_TimezoneId);
     }
 };
 struct UTCm515_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm515_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-5:15");
+        tz = TZ(UTCmm515_TimezoneId);
     }
 };
 struct UTCm530_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm530_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-5:30");
+        tz = TZ(UTCmm530_TimezoneId);
     }
 };
 struct UTCm545_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm545_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-5:45");
+        tz = TZ(UTCmm545_TimezoneId);
     }
 };
 struct UTCm4_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm4_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-4");
+        tz = TZ(UTCmm4_TimezoneId);
     }
 };
 struct UTCm415_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm415_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-4:15");
+        tz = TZ(UTCmm415_TimezoneId);
     }
 };
 struct UTCm430_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm430_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-4:30");
+        tz = TZ(UTCmm430_TimezoneId);
     }
 };
 struct UTCm445_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm445_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-4:45");
+        tz = TZ(UTCmm445_TimezoneId);
     }
 };
 struct UTCm3_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm3_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-3");
+        tz = TZ(UTCmm3_TimezoneId);
     }
 };
 struct UTCm315_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm315_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-3:15");
+        tz = TZ(UTCmm315_TimezoneId);
     }
 };
 struct UTCm330_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm330_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-3:30");
+        tz = TZ(UTCmm330_TimezoneId);
     }
 };
 struct UTCm345_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm345_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-3:45");
+        tz = TZ(UTCmm345_TimezoneId);
     }
 };
 struct UTCm2_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm2_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-2");
+        tz = TZ(UTCmm2_TimezoneId);
     }
 };
 struct UTCm215_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm215_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-2:15");
+        tz = TZ(UTCmm215_TimezoneId);
     }
 };
 struct UTCm230_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm230_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-2:30");
+        tz = TZ(UTCmm230_TimezoneId);
     }
 };
 struct UTCm245_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm245_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-2:45");
+        tz = TZ(UTCmm245_TimezoneId);
     }
 };
 struct UTCm1_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm1_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-1");
+        tz = TZ(UTCmm1_TimezoneId);
     }
 };
 struct UTCm115_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm115_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-1:15");
+        tz = TZ(UTCmm115_TimezoneId);
     }
 };
 struct UTCm130_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm130_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-1:30");
+        tz = TZ(UTCmm130_TimezoneId);
     }
 };
 struct UTCm145_Timezone: public BaseTimezone {
     Timezone tz;
     UTCm145_Timezone(): BaseTimezone() {
-        tz = TZ("UTC-1:45");
+        tz = TZ(UTCmm145_TimezoneId);
     }
 };
 struct UTC0_Timezone: public BaseTimezone {
     Timezone tz;
     UTC0_Timezone(): BaseTimezone() {
-        tz = TZ("UTC0");
+        tz = TZ(UTCp0_TimezoneId);
     }
 };
 struct UTC015_Timezone: public BaseTimezone {
     Timezone tz;
     UTC015_Timezone(): BaseTimezone() {
-        tz = TZ("UTC0:15");
+        tz = TZ(UTCp015_TimezoneId);
     }
 };
 struct UTC030_Timezone: public BaseTimezone {
     Timezone tz;
     UTC030_Timezone(): BaseTimezone() {
-        tz = TZ("UTC0:30");
+        tz = TZ(UTCp030_TimezoneId);
     }
 };
 struct UTC045_Timezone: public BaseTimezone {
     Timezone tz;
     UTC045_Timezone(): BaseTimezone() {
-        tz = TZ("UTC0:45");
+        tz = TZ(UTCp045_TimezoneId);
     }
 };
 struct UTC1_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1_Timezone(): BaseTimezone() {
-        tz = TZ("UTC1");
+        tz = TZ(UTCp1_TimezoneId);
     }
 };
 struct UTC115_Timezone: public BaseTimezone {
     Timezone tz;
     UTC115_Timezone(): BaseTimezone() {
-        tz = TZ("UTC1:15");
+        tz = TZ(UTCp115_TimezoneId);
     }
 };
 struct UTC130_Timezone: public BaseTimezone {
     Timezone tz;
     UTC130_Timezone(): BaseTimezone() {
-        tz = TZ("UTC1:30");
+        tz = TZ(UTCp130_TimezoneId);
     }
 };
 struct UTC145_Timezone: public BaseTimezone {
     Timezone tz;
     UTC145_Timezone(): BaseTimezone() {
-        tz = TZ("UTC1:45");
+        tz = TZ(UTCp145_TimezoneId);
     }
 };
 struct UTC2_Timezone: public BaseTimezone {
     Timezone tz;
     UTC2_Timezone(): BaseTimezone() {
-        tz = TZ("UTC2");
+        tz = TZ(UTCp2_TimezoneId);
     }
 };
 struct UTC215_Timezone: public BaseTimezone {
     Timezone tz;
     UTC215_Timezone(): BaseTimezone() {
-        tz = TZ("UTC2:15");
+        tz = TZ(UTCp215_TimezoneId);
     }
 };
 struct UTC230_Timezone: public BaseTimezone {
     Timezone tz;
     UTC230_Timezone(): BaseTimezone() {
-        tz = TZ("UTC2:30");
+        tz = TZ(UTCp230_TimezoneId);
     }
 };
 struct UTC245_Timezone: public BaseTimezone {
     Timezone tz;
     UTC245_Timezone(): BaseTimezone() {
-        tz = TZ("UTC2:45");
+        tz = TZ(UTCp245_TimezoneId);
     }
 };
 struct UTC3_Timezone: public BaseTimezone {
     Timezone tz;
     UTC3_Timezone(): BaseTimezone() {
-        tz = TZ("UTC3");
+        tz = TZ(UTCp3_TimezoneId);
     }
 };
 struct UTC315_Timezone: public BaseTimezone {
     Timezone tz;
     UTC315_Timezone(): BaseTimezone() {
-        tz = TZ("UTC3:15");
+        tz = TZ(UTCp315_TimezoneId);
     }
 };
 struct UTC330_Timezone: public BaseTimezone {
     Timezone tz;
     UTC330_Timezone(): BaseTimezone() {
-        tz = TZ("UTC3:30");
+        tz = TZ(UTCp330_TimezoneId);
     }
 };
 struct UTC345_Timezone: public BaseTimezone {
     Timezone tz;
     UTC345_Timezone(): BaseTimezone() {
-        tz = TZ("UTC3:45");
+        tz = TZ(UTCp345_TimezoneId);
     }
 };
 struct UTC4_Timezone: public BaseTimezone {
     Timezone tz;
     UTC4_Timezone(): BaseTimezone() {
-        tz = TZ("UTC4");
+        tz = TZ(UTCp4_TimezoneId);
     }
 };
 struct UTC415_Timezone: public BaseTimezone {
     Timezone tz;
     UTC415_Timezone(): BaseTimezone() {
-        tz = TZ("UTC4:15");
+        tz = TZ(UTCp415_TimezoneId);
     }
 };
 struct UTC430_Timezone: public BaseTimezone {
     Timezone tz;
     UTC430_Timezone(): BaseTimezone() {
-        tz = TZ("UTC4:30");
+        tz = TZ(UTCp430_TimezoneId);
     }
 };
 struct UTC445_Timezone: public BaseTimezone {
     Timezone tz;
     UTC445_Timezone(): BaseTimezone() {
-        tz = TZ("UTC4:45");
+        tz = TZ(UTCp445_TimezoneId);
     }
 };
 struct UTC5_Timezone: public BaseTimezone {
     Timezone tz;
     UTC5_Timezone(): BaseTimezone() {
-        tz = TZ("UTC5");
+        tz = TZ(UTCp5_TimezoneId);
     }
 };
 struct UTC515_Timezone: public BaseTimezone {
     Timezone tz;
     UTC515_Timezone(): BaseTimezone() {
-        tz = TZ("UTC5:15");
+        tz = TZ(UTCp515_TimezoneId);
     }
 };
 struct UTC530_Timezone: public BaseTimezone {
     Timezone tz;
     UTC530_Timezone(): BaseTimezone() {
-        tz = TZ("UTC5:30");
+        tz = TZ(UTCp530_TimezoneId);
     }
 };
 struct UTC545_Timezone: public BaseTimezone {
     Timezone tz;
     UTC545_Timezone(): BaseTimezone() {
-        tz = TZ("UTC5:45");
+        tz = TZ(UTCp545_TimezoneId);
     }
 };
 struct UTC6_Timezone: public BaseTimezone {
     Timezone tz;
     UTC6_Timezone(): BaseTimezone() {
-        tz = TZ("UTC6");
+        tz = TZ(UTCp6_TimezoneId);
     }
 };
 struct UTC615_Timezone: public BaseTimezone {
     Timezone tz;
     UTC615_Timezone(): BaseTimezone() {
-        tz = TZ("UTC6:15");
+        tz = TZ(UTCp615_TimezoneId);
     }
 };
 struct UTC630_Timezone: public BaseTimezone {
     Timezone tz;
     UTC630_Timezone(): BaseTimezone() {
-        tz = TZ("UTC6:30");
+        tz = TZ(UTCp630_TimezoneId);
     }
 };
 struct UTC645_Timezone: public BaseTimezone {
     Timezone tz;
     UTC645_Timezone(): BaseTimezone() {
-        tz = TZ("UTC6:45");
+        tz = TZ(UTCp645_TimezoneId);
     }
 };
 struct UTC7_Timezone: public BaseTimezone {
     Timezone tz;
     UTC7_Timezone(): BaseTimezone() {
-        tz = TZ("UTC7");
+        tz = TZ(UTCp7_TimezoneId);
     }
 };
 struct UTC715_Timezone: public BaseTimezone {
     Timezone tz;
     UTC715_Timezone(): BaseTimezone() {
-        tz = TZ("UTC7:15");
+        tz = TZ(UTCp715_TimezoneId);
     }
 };
 struct UTC730_Timezone: public BaseTimezone {
     Timezone tz;
     UTC730_Timezone(): BaseTimezone() {
-        tz = TZ("UTC7:30");
+        tz = TZ(UTCp730_TimezoneId);
     }
 };
 struct UTC745_Timezone: public BaseTimezone {
     Timezone tz;
     UTC745_Timezone(): BaseTimezone() {
-        tz = TZ("UTC7:45");
+        tz = TZ(UTCp745_TimezoneId);
     }
 };
 struct UTC8_Timezone: public BaseTimezone {
     Timezone tz;
     UTC8_Timezone(): BaseTimezone() {
-        tz = TZ("UTC8");
+        tz = TZ(UTCp8_TimezoneId);
     }
 };
 struct UTC815_Timezone: public BaseTimezone {
     Timezone tz;
     UTC815_Timezone(): BaseTimezone() {
-        tz = TZ("UTC8:15");
+        tz = TZ(UTCp815_TimezoneId);
     }
 };
 struct UTC830_Timezone: public BaseTimezone {
     Timezone tz;
     UTC830_Timezone(): BaseTimezone() {
-        tz = TZ("UTC8:30");
+        tz = TZ(UTCp830_TimezoneId);
     }
 };
 struct UTC845_Timezone: public BaseTimezone {
     Timezone tz;
     UTC845_Timezone(): BaseTimezone() {
-        tz = TZ("UTC8:45");
+        tz = TZ(UTCp845_TimezoneId);
     }
 };
 struct UTC9_Timezone: public BaseTimezone {
     Timezone tz;
     UTC9_Timezone(): BaseTimezone() {
-        tz = TZ("UTC9");
+        tz = TZ(UTCp9_TimezoneId);
     }
 };
 struct UTC915_Timezone: public BaseTimezone {
     Timezone tz;
     UTC915_Timezone(): BaseTimezone() {
-        tz = TZ("UTC9:15");
+        tz = TZ(UTCp915_TimezoneId);
     }
 };
 struct UTC930_Timezone: public BaseTimezone {
     Timezone tz;
     UTC930_Timezone(): BaseTimezone() {
-        tz = TZ("UTC9:30");
+        tz = TZ(UTCp930_TimezoneId);
     }
 };
 struct UTC945_Timezone: public BaseTimezone {
     Timezone tz;
     UTC945_Timezone(): BaseTimezone() {
-        tz = TZ("UTC9:45");
+        tz = TZ(UTCp945_TimezoneId);
     }
 };
 struct UTC10_Timezone: public BaseTimezone {
     Timezone tz;
     UTC10_Timezone(): BaseTimezone() {
-        tz = TZ("UTC10");
+        tz = TZ(UTCp10_TimezoneId);
     }
 };
 struct UTC1015_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1015_Timezone(): BaseTimezone() {
-        tz = TZ("UTC10:15");
+        tz = TZ(UTCp1015_TimezoneId);
     }
 };
 struct UTC1030_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1030_Timezone(): BaseTimezone() {
-        tz = TZ("UTC10:30");
+        tz = TZ(UTCp1030_TimezoneId);
     }
 };
 struct UTC1045_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1045_Timezone(): BaseTimezone() {
-        tz = TZ("UTC10:45");
+        tz = TZ(UTCp1045_TimezoneId);
     }
 };
 struct UTC11_Timezone: public BaseTimezone {
     Timezone tz;
     UTC11_Timezone(): BaseTimezone() {
-        tz = TZ("UTC11");
+        tz = TZ(UTCp11_TimezoneId);
     }
 };
 struct UTC1115_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1115_Timezone(): BaseTimezone() {
-        tz = TZ("UTC11:15");
+        tz = TZ(UTCp1115_TimezoneId);
     }
 };
 struct UTC1130_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1130_Timezone(): BaseTimezone() {
-        tz = TZ("UTC11:30");
+        tz = TZ(UTCp1130_TimezoneId);
     }
 };
 struct UTC1145_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1145_Timezone(): BaseTimezone() {
-        tz = TZ("UTC11:45");
+        tz = TZ(UTCp1145_TimezoneId);
     }
 };
 struct UTC12_Timezone: public BaseTimezone {
     Timezone tz;
     UTC12_Timezone(): BaseTimezone() {
-        tz = TZ("UTC12");
+        tz = TZ(UTCp12_TimezoneId);
     }
 };
 struct UTC1215_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1215_Timezone(): BaseTimezone() {
-        tz = TZ("UTC12:15");
+        tz = TZ(UTCp1215_TimezoneId);
     }
 };
 struct UTC1230_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1230_Timezone(): BaseTimezone() {
-        tz = TZ("UTC12:30");
+        tz = TZ(UTCp1230_TimezoneId);
     }
 };
 struct UTC1245_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1245_Timezone(): BaseTimezone() {
-        tz = TZ("UTC12:45");
+        tz = TZ(UTCp1245_TimezoneId);
     }
 };
 struct UTC13_Timezone: public BaseTimezone {
     Timezone tz;
     UTC13_Timezone(): BaseTimezone() {
-        tz = TZ("UTC13");
+        tz = TZ(UTCp13_TimezoneId);
     }
 };
 struct UTC1315_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1315_Timezone(): BaseTimezone() {
-        tz = TZ("UTC13:15");
+        tz = TZ(UTCp1315_TimezoneId);
     }
 };
 struct UTC1330_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1330_Timezone(): BaseTimezone() {
-        tz = TZ("UTC13:30");
+        tz = TZ(UTCp1330_TimezoneId);
     }
 };
 struct UTC1345_Timezone: public BaseTimezone {
     Timezone tz;
     UTC1345_Timezone(): BaseTimezone() {
-        tz = TZ("UTC13:45");
+        tz = TZ(UTCp1345_TimezoneId);
     }
 };
 struct UTC14_Timezone: public BaseTimezone {
     Timezone tz;
     UTC14_Timezone(): BaseTimezone() {
-        tz = TZ("UTC14");
+        tz = TZ(UTCp14_TimezoneId);
     }
 };
 }
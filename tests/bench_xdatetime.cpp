@@ -0,0 +1,547 @@
+// xDateTime is Copyright (c) 2021-2023 Ali Sherief.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. 
+
+#define X_DATETIME_WITH_LOCALE_DE_DE
+#include "x_datetime.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+
+using namespace xDateTime;
+
+// What every defaulted zone argument used to cost: TZ() returned a copy of the
+// whole zone map, and UTC_Timezone() called it twice.
+static void BM_TimezoneMapCopy(benchmark::State& state) {
+    std::map<std::string, Timezone> timezones;
+    for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+        timezones[BuiltinZones[i].name] = TZ(static_cast<TimezoneId>(i));
+    }
+    for (auto _ : state) {
+        std::map<std::string, Timezone> a = timezones;
+        std::map<std::string, Timezone> b = timezones;
+        Timezone tz = b["UTC"];
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(tz);
+    }
+}
+BENCHMARK(BM_TimezoneMapCopy);
+
+static void BM_TZIdLookup(benchmark::State& state) {
+    for (auto _ : state) {
+        TimezoneId id = TZId("Central European Summer Time");
+        benchmark::DoNotOptimize(id);
+    }
+}
+BENCHMARK(BM_TZIdLookup);
+
+static void BM_DateTimeConstruct(benchmark::State& state) {
+    int day = 0;
+    for (auto _ : state) {
+        DateTimeD d(2020, 1, 1 + (day++ & 15));
+        benchmark::DoNotOptimize(&d);
+    }
+}
+BENCHMARK(BM_DateTimeConstruct);
+
+static void BM_DateTimeConstructWithHandle(benchmark::State& state) {
+    TimezoneId cest = TZId("CEST");
+    int day = 0;
+    for (auto _ : state) {
+        DateTimeD d(2020, 1, 1 + (day++ & 15), 12, 0, 0, cest);
+        benchmark::DoNotOptimize(&d);
+    }
+}
+BENCHMARK(BM_DateTimeConstructWithHandle);
+
+static void BM_DateTimeConstructWithTimezone(benchmark::State& state) {
+    Timezone cest = CEST_Timezone().tz;
+    int day = 0;
+    for (auto _ : state) {
+        DateTimeD d(2020, 1, 1 + (day++ & 15), 12, 0, 0, cest);
+        benchmark::DoNotOptimize(&d);
+    }
+}
+BENCHMARK(BM_DateTimeConstructWithTimezone);
+
+static void BM_DateTimeFromSteadyClock(benchmark::State& state) {
+    typedef DateTime<GregorianCalendar, std::chrono::steady_clock> SteadyDateTime;
+    auto tp = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        SteadyDateTime d(tp);
+        benchmark::DoNotOptimize(&d);
+    }
+}
+BENCHMARK(BM_DateTimeFromSteadyClock);
+
+static void BM_DateTimeCivilFields(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45);
+    TimeDeltaD day(std::chrono::seconds(86400));
+    for (auto _ : state) {
+        int sum = d.Year() + d.Month() + d.Day() + d.Hour() + d.DayOfWeek();
+        benchmark::DoNotOptimize(sum);
+        d += day;
+    }
+}
+BENCHMARK(BM_DateTimeCivilFields)->ThreadRange(1, 4);
+
+static void BM_ToStringFormat(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45);
+    for (auto _ : state) {
+        std::string s = d.ToString("%Y-%m-%d %H:%M:%S %z [%c]");
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_ToStringFormat);
+
+static void BM_ToStringPlan(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45);
+    FormatPlan plan("%Y-%m-%d %H:%M:%S %z [%c]");
+    for (auto _ : state) {
+        std::string s = d.ToString(plan);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_ToStringPlan);
+
+static void BM_FormatToBuffer(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45);
+    FormatPlan plan("%Y-%m-%d %H:%M:%S %z [%c]");
+    char buf[128];
+    for (auto _ : state) {
+        size_t n = d.FormatTo(buf, sizeof(buf), plan);
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(buf);
+    }
+}
+BENCHMARK(BM_FormatToBuffer);
+
+static void BM_ISO8601Generic(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45, 123456789);
+    FormatPlan plan("%Y-%m-%dT%H:%M:%S.%3Z");
+    char buf[64];
+    for (auto _ : state) {
+        size_t n = d.FormatTo(buf, sizeof(buf), plan);
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(buf);
+    }
+}
+BENCHMARK(BM_ISO8601Generic);
+
+static void BM_ISO8601Fixed(benchmark::State& state) {
+    DateTimeD d(2020, 6, 15, 12, 30, 45, 123456789);
+    char buf[DateTimeD::MaxISO8601Size];
+    for (auto _ : state) {
+        size_t n = d.FormatISO8601(buf, 9);
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(buf);
+    }
+}
+BENCHMARK(BM_ISO8601Fixed);
+
+// An unparseable line goes through every candidate format of the auto-detecting
+// constructor; compare the throwing interface against TryParse.
+static void BM_ParseFailureThrowing(benchmark::State& state) {
+    std::string line = "GET /index.html HTTP/1.1";
+    for (auto _ : state) {
+        try {
+            DateTimeD d(line);
+            benchmark::DoNotOptimize(d);
+        }
+        catch (const MalformedDateTime&) {}
+    }
+}
+BENCHMARK(BM_ParseFailureThrowing);
+
+static void BM_ParseFailureTryParse(benchmark::State& state) {
+    std::string line = "GET /index.html HTTP/1.1";
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = DateTimeD::TryParse(line, d);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseFailureTryParse);
+
+// Auto-detection over a mix of ISO 8601 and locale formats, against parsing
+// each line with its format already known.
+static const char* const mixed_lines[][2] = {
+    {"2020-06-15T12:30:45Z", "%Y-%m-%dT%H:%M:%SZ"},
+    {"2020-06-15 12:30:45.123", "%Y-%m-%d %H:%M:%S.%3"},
+    {"06/15/20", "%m/%d/%y"},
+    {"12:30:45", "%H:%M:%S"},
+};
+
+static void BM_ParseAutoDetect(benchmark::State& state) {
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError err = DateTimeD::TryParse(mixed_lines[i++ % 4][0], d);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseAutoDetect);
+
+static void BM_ParseTargeted(benchmark::State& state) {
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        const char* const* line = mixed_lines[i++ % 4];
+        ParseError err = DateTimeD::TryParse(line[0], line[1], d);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseTargeted);
+
+static void BM_ParseFormatString(benchmark::State& state) {
+    std::string line = "2020-06-15 12:30:45";
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(line, "%Y-%m-%d %H:%M:%S");
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseFormatString);
+
+static void BM_ParsePlan(benchmark::State& state) {
+    std::string line = "2020-06-15 12:30:45";
+    ParsePlan plan("%Y-%m-%d %H:%M:%S");
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(line, plan);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParsePlan);
+
+// A timestamp at the start of a log record, parsed in place.
+static void BM_ParseEmbedded(benchmark::State& state) {
+    const char record[] = "2020-06-15T12:30:45Z GET /index.html HTTP/1.1 200";
+    const char* end = record + sizeof(record) - 1;
+    ParsePlan plan("%Y-%m-%dT%H:%M:%SZ");
+    DateTimeD d;
+    size_t consumed;
+    for (auto _ : state) {
+        ParseError err = d.TryFromChars(record, end, plan, consumed);
+        benchmark::DoNotOptimize(err);
+        benchmark::DoNotOptimize(consumed);
+    }
+}
+BENCHMARK(BM_ParseEmbedded);
+
+// Month and weekday names, which are matched against the locale's tables.
+static void BM_ParseNames(benchmark::State& state) {
+    std::string line = "Mittwoch, 30 Dezember 2020 12:30:45";
+    ParsePlan plan("%A, %d %B %Y %H:%M:%S", "de_DE");
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(line, plan);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseNames);
+
+// A long zone name, matched against every built-in zone.
+static void BM_ParseZoneName(benchmark::State& state) {
+    std::string line = "2020-06-15 12:30:45 Australian Central Daylight Saving Time";
+    ParsePlan plan("%Y-%m-%d %H:%M:%S %Z");
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(line, plan);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseZoneName);
+
+// The fixed-layout ISO 8601 parser against the generic path for the closest format.
+static void BM_ParseISO8601Generic(benchmark::State& state) {
+    std::string line = "2020-06-15T12:30:45.123456789Z+0100";
+    ParsePlan plan("%Y-%m-%dT%H:%M:%S.%3Z%z");
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(line, plan);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_ParseISO8601Generic);
+
+static void BM_ParseISO8601Fixed(benchmark::State& state) {
+    std::string line = "2020-06-15T12:30:45.123456789+01:00";
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromISO8601(line);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_ParseISO8601Fixed);
+
+static void BM_ScanISO8601DateTimeSWAR(benchmark::State& state) {
+    const char line[] = "2020-06-15T12:30:45";
+    ISO8601Fields f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(line);
+        ParseError err = ISO8601Parser::ScanDateTimeSWAR(line, f);
+        benchmark::DoNotOptimize(err);
+        benchmark::DoNotOptimize(f);
+    }
+}
+BENCHMARK(BM_ScanISO8601DateTimeSWAR);
+
+#ifdef X_DATETIME_SSE2
+static void BM_ScanISO8601DateTimeSSE2(benchmark::State& state) {
+    const char line[] = "2020-06-15T12:30:45";
+    ISO8601Fields f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(line);
+        ParseError err = ISO8601Parser::ScanDateTimeSSE2(line, f);
+        benchmark::DoNotOptimize(err);
+        benchmark::DoNotOptimize(f);
+    }
+}
+BENCHMARK(BM_ScanISO8601DateTimeSSE2);
+#endif
+
+// Log lines an hour long, parsed with and without a ParseContext.
+static std::vector<std::string> LogTimestamps(const char* fmt) {
+    std::vector<std::string> lines;
+    DateTimeD d(2020, 6, 15);
+    for (int i = 0; i < 1024; ++i) {
+        lines.push_back(d.ToString(fmt));
+        d += Seconds(3);
+    }
+    return lines;
+}
+
+static void BM_ParsePlanNoContext(benchmark::State& state) {
+    std::vector<std::string> lines = LogTimestamps("%Y-%m-%d %H:%M:%S");
+    ParsePlan plan("%Y-%m-%d %H:%M:%S");
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(lines[i++ & 1023], plan);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParsePlanNoContext);
+
+static void BM_ParsePlanContext(benchmark::State& state) {
+    std::vector<std::string> lines = LogTimestamps("%Y-%m-%d %H:%M:%S");
+    ParsePlan plan("%Y-%m-%d %H:%M:%S");
+    ParseContext ctx;
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(lines[i++ & 1023], plan, ctx);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParsePlanContext);
+
+static void BM_ParseISO8601NoContext(benchmark::State& state) {
+    std::vector<std::string> lines = LogTimestamps("%Y-%m-%dT%H:%M:%SZ");
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError err = d.TryFromISO8601(lines[i++ & 1023]);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseISO8601NoContext);
+
+static void BM_ParseISO8601Context(benchmark::State& state) {
+    std::vector<std::string> lines = LogTimestamps("%Y-%m-%dT%H:%M:%SZ");
+    ParseContext ctx;
+    DateTimeD d;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError err = d.TryFromISO8601(lines[i++ & 1023], ctx);
+        benchmark::DoNotOptimize(err);
+    }
+}
+BENCHMARK(BM_ParseISO8601Context);
+
+// Offset lookups in a zone with state.range(0) transitions.
+static void BM_ZoneOffsetLookup(benchmark::State& state) {
+    Timezone zone;
+    zone.name = "Bench/Zone" + std::to_string(state.range(0));
+    for (long long i = 0; i < state.range(0); ++i) {
+        zone.utc.push_back(i * 15778800); // every half year
+        zone.gmtoff.push_back((i % 2) ? 7200 : 3600);
+    }
+    ZoneTransitions transitions(zone);
+    const long long span = state.range(0) * 15778800;
+    long long t = 0;
+    for (auto _ : state) {
+        t = (t + 7919 * 3601) % span;
+        benchmark::DoNotOptimize(transitions.AtUTC(t).gmtoff);
+    }
+}
+BENCHMARK(BM_ZoneOffsetLookup)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+// A zone with 256 half-yearly transitions, for the stream benchmarks below.
+static Timezone BenchCityZone() {
+    Timezone zone;
+    zone.name = "Bench/City";
+    for (long long i = 0; i < 256; ++i) {
+        zone.utc.push_back(i * 15778800);
+        zone.gmtoff.push_back((i % 2) ? 7200 : 3600);
+    }
+    return zone;
+}
+
+// Offsets of a time-ordered stream, one second apart, searched each time and
+// answered from a Hint.
+static void BM_ZoneOffsetStream(benchmark::State& state) {
+    ZoneTransitions transitions(BenchCityZone());
+    long long t = 1000000000;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transitions.AtUTC(++t).gmtoff);
+    }
+}
+BENCHMARK(BM_ZoneOffsetStream);
+
+static void BM_ZoneOffsetStreamHint(benchmark::State& state) {
+    ZoneTransitions transitions(BenchCityZone());
+    ZoneTransitions::Hint hint;
+    long long t = 1000000000;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(transitions.AtUTC(++t, hint).gmtoff);
+    }
+}
+BENCHMARK(BM_ZoneOffsetStreamHint);
+
+// Offsets after the last transition, from the zone's rule, over state.range(0)
+// years from 2100 on.
+static void BM_ZoneOffsetRule(benchmark::State& state) {
+    Timezone zone = BenchCityZone();
+    zone.rule = "CET-1CEST,M3.5.0,M10.5.0/3";
+    ZoneTransitions transitions(zone);
+    const long long from = GregorianCalendar::DaysFromCivil(2100, 1, 1) * 86400;
+    const long long span = state.range(0) * 31556952;
+    long long t = 0;
+    for (auto _ : state) {
+        t = (t + 7919 * 3601) % span;
+        benchmark::DoNotOptimize(transitions.AtUTC(from + t).gmtoff);
+    }
+}
+BENCHMARK(BM_ZoneOffsetRule)->Arg(1)->Arg(8)->Arg(1000);
+
+// UTCTicks() of a time-ordered stream in a zone with transitions.
+static void BM_UTCTicksStream(benchmark::State& state) {
+    DateTimeD d(2001, 9, 9, 0, 0, 0, DateTimeD(BenchCityZone()).TimeZoneId());
+    for (auto _ : state) {
+        d.AddSeconds(1);
+        benchmark::DoNotOptimize(d.UTCTicks());
+    }
+}
+BENCHMARK(BM_UTCTicksStream);
+
+#ifdef X_DATETIME_ZONEINFO
+#ifndef XDATETIME_ZONEINFO_DIR
+#define XDATETIME_ZONEINFO_DIR "tests/zoneinfo"
+#endif
+
+// What loading a zone on first use costs: mapping and decoding its TZif file,
+// and laying out its transitions.
+static void BM_LoadZoneInfo(benchmark::State& state) {
+    for (auto _ : state) {
+        Timezone zone;
+        if (!LoadZoneInfo(XDATETIME_ZONEINFO_DIR, "Europe/Berlin", zone)) {
+            state.SkipWithError("No Europe/Berlin in " XDATETIME_ZONEINFO_DIR);
+            return;
+        }
+        ZoneTransitions transitions(zone);
+        benchmark::DoNotOptimize(transitions.Size());
+    }
+}
+BENCHMARK(BM_LoadZoneInfo);
+#endif
+
+// A column of a million timestamps, split over state.range(0) threads.
+static const std::string& TimestampColumn() {
+    static std::string column;
+    if (column.empty()) {
+        FormatPlan plan("%Y-%m-%dT%H:%M:%SZ\n");
+        DateTimeD d(2020, 1, 1);
+        for (int i = 0; i < 1000000; ++i) {
+            column += d.ToString(plan);
+            d += Seconds(7);
+        }
+    }
+    return column;
+}
+
+static void BM_ParseMany(benchmark::State& state) {
+    const std::string& column = TimestampColumn();
+    ParsePlan plan("%Y-%m-%dT%H:%M:%SZ");
+    std::vector<long long> ticks(1000000);
+    std::vector<uint64_t> errors(1000000 / 64 + 1);
+    ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    ParseManyOptions options;
+    options.pool = &pool;
+    for (auto _ : state) {
+        ParseManyResult r = DateTimeD::ParseMany(column.data(), column.size(), '\n', plan,
+                ticks.data(), ticks.size(), errors.data(), options);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesProcessed(state.iterations() * column.size());
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_ParseMany)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParseManyISO8601(benchmark::State& state) {
+    const std::string& column = TimestampColumn();
+    std::vector<long long> ticks(1000000);
+    ThreadPool pool(static_cast<unsigned>(state.range(0)));
+    ParseManyOptions options;
+    options.pool = &pool;
+    for (auto _ : state) {
+        ParseManyResult r = DateTimeD::ParseManyISO8601(column.data(), column.size(), '\n',
+                ticks.data(), ticks.size(), NULL, options);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesProcessed(state.iterations() * column.size());
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_ParseManyISO8601)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+#ifdef X_DATETIME_MMAP
+// A million log lines read back from a file.
+static void BM_LogReader(benchmark::State& state) {
+    const std::string path = "xdatetime_bench.log";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        FormatPlan plan("%Y-%m-%dT%H:%M:%SZ INFO request served\n");
+        DateTimeD d(2020, 1, 1);
+        for (int i = 0; i < 1000000; ++i) {
+            out << d.ToString(plan);
+            d += Seconds(7);
+        }
+    }
+    LogReader<DateTimeD> reader(path);
+    for (auto _ : state) {
+        unsigned long long offset;
+        DateTimeD d;
+        reader.Rewind();
+        while (reader.Next(offset, d)) {
+            benchmark::DoNotOptimize(d);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * reader.FileSize());
+    state.SetItemsProcessed(state.iterations() * 1000000);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_LogReader)->Unit(benchmark::kMillisecond);
+#endif
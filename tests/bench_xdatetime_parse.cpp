@@ -0,0 +1,122 @@
+// xDateTime is Copyright (c) 2021-2023 Ali Sherief.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parser benchmarks over the fixed corpus in tests/corpus/parse. Every file holds
+// a format, a newline and an input, and is measured four ways:
+//   FromString/<name>  TryFromString() with the format string, compiled each time
+//   ParsePlan/<name>   TryFromString() with a ParsePlan compiled once
+//   Detect/<name>      format detection, as DateTime(string) does
+//   Reject/<name>      a precompiled plan on the input with its middle byte broken
+// Each reports ns/op and bytes/s of input.
+
+#include "x_datetime.h"
+#include <benchmark/benchmark.h>
+#include <dirent.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+using namespace xDateTime;
+
+#ifndef XDATETIME_CORPUS_DIR
+#define XDATETIME_CORPUS_DIR "tests/corpus/parse"
+#endif
+
+struct CorpusEntry {
+    std::string name;
+    std::string format;
+    std::string input;
+};
+
+static std::vector<CorpusEntry> ReadCorpus(const std::string& dir) {
+    std::vector<CorpusEntry> entries;
+    DIR* d = opendir(dir.c_str());
+    if (d == NULL) return entries;
+    while (struct dirent* e = readdir(d)) {
+        if (e->d_name[0] == '.') continue;
+        std::ifstream in((dir + "/" + e->d_name).c_str(), std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t nl = data.find('\n');
+        if (nl == std::string::npos) continue;
+        CorpusEntry entry = {e->d_name, data.substr(0, nl), data.substr(nl + 1)};
+        entries.push_back(entry);
+    }
+    closedir(d);
+    std::sort(entries.begin(), entries.end(),
+        [](const CorpusEntry& a, const CorpusEntry& b) { return a.name < b.name; });
+    return entries;
+}
+
+static void FromString(benchmark::State& state, CorpusEntry entry) {
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(entry.input, entry.format);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * entry.input.size());
+}
+
+static void WithPlan(benchmark::State& state, CorpusEntry entry) {
+    ParsePlan plan(entry.format);
+    DateTimeD d;
+    if (d.TryFromString(entry.input, plan) != ParseError::None) {
+        state.SkipWithError("The corpus input doesn't parse");
+        return;
+    }
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(entry.input, plan);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * entry.input.size());
+}
+
+static void Detect(benchmark::State& state, CorpusEntry entry) {
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = DateTimeD::TryParse(entry.input, d);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * entry.input.size());
+}
+
+static void Reject(benchmark::State& state, CorpusEntry entry) {
+    ParsePlan plan(entry.format);
+    std::string bad = entry.input;
+    bad[bad.size() / 2] = '\x7f';
+    DateTimeD d;
+    for (auto _ : state) {
+        ParseError err = d.TryFromString(bad, plan);
+        benchmark::DoNotOptimize(err);
+    }
+    state.SetBytesProcessed(state.iterations() * bad.size());
+}
+
+int main(int argc, char** argv) {
+    std::vector<CorpusEntry> corpus = ReadCorpus(XDATETIME_CORPUS_DIR);
+    if (corpus.empty()) {
+        fprintf(stderr, "No corpus in %s\n", XDATETIME_CORPUS_DIR);
+        return 1;
+    }
+    for (const CorpusEntry& entry: corpus) {
+        benchmark::RegisterBenchmark(("FromString/" + entry.name).c_str(), FromString, entry);
+        benchmark::RegisterBenchmark(("ParsePlan/" + entry.name).c_str(), WithPlan, entry);
+        benchmark::RegisterBenchmark(("Detect/" + entry.name).c_str(), Detect, entry);
+        benchmark::RegisterBenchmark(("Reject/" + entry.name).c_str(), Reject, entry);
+    }
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,75 @@
+// xDateTime is Copyright (c) 2021-2023 Ali Sherief.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Fuzz target for the parsers. An input is a format, a newline and the text to
+// parse with it, like the files in tests/corpus/parse, which make a seed corpus.
+// The text is also given to the ISO 8601 parser and to format detection.
+//
+// With clang, this links against libFuzzer. Otherwise it is built with a main()
+// which runs the files named on the command line once each, so that the corpus
+// can be replayed under the sanitizers.
+
+#include "x_datetime.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace xDateTime;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const char* first = reinterpret_cast<const char*>(data);
+    const char* last = first + size;
+    const char* nl = size ? static_cast<const char*>(memchr(first, '\n', size)) : NULL;
+    // Give the text a buffer of its own, so that reading past its end is caught.
+    const char* text_first = nl ? nl + 1 : first;
+    std::vector<char> text(text_first, last);
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    DateTimeD d;
+    size_t consumed;
+    if (nl != NULL) {
+        ParsePlan plan(std::string(first, nl));
+        d.TryFromChars(p, end, plan);
+        d.TryFromChars(p, end, plan, consumed);
+        ParseContext ctx;
+        d.TryFromChars(p, end, plan, ctx);
+        d.TryFromChars(p, end, plan, consumed, ctx);
+        d.TryFromChars(p, end, plan, ctx);
+    }
+    d.TryFromISO8601(p, end);
+    d.TryFromISO8601(p, end, consumed);
+    ParseContext ctx;
+    d.TryFromISO8601(p, end, ctx);
+    d.TryFromISO8601(p, end, ctx);
+    d.TryFromChars(p, end);
+    return 0;
+}
+
+#ifndef X_DATETIME_LIBFUZZER
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "Cannot open %s\n", argv[i]);
+            return 1;
+        }
+        std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+    return 0;
+}
+#endif
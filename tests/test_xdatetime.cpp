@@ -13,11 +13,18 @@
 // limitations under the License. 
 
 #define X_DATETIME_WITH_LOCALE_EN_US
+#define X_DATETIME_WITH_LOCALE_DE_DE
 #include "x_datetime.h"
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 
 using namespace xDateTime;
 
+#ifndef XDATETIME_ZONEINFO_DIR
+#define XDATETIME_ZONEINFO_DIR "tests/zoneinfo"
+#endif
+
 TEST(xDateTime, TimeDelta) {
   ASSERT_EQ((TimeDelta<std::ratio<1>>(1).ToString()), "1d 0h 0min 0s");
   ASSERT_EQ((TimeDelta<std::ratio<1>>(0, 1).ToString()), "0d 1h 0min 0s");
@@ -298,3 +305,1116 @@ TEST(xDateTime, DateTimePeriod) {
     ASSERT_THROW(dp2.Union(dpfar), MalformedDateTime);
     ASSERT_THROW(dp2.Intersection(dpfar), MalformedDateTime);
 }
+
+TEST(xDateTime, TimezoneRegistry) {
+    TimezoneId pst = TZId("PST");
+    ASSERT_EQ(TZ(pst).name, "PST");
+    ASSERT_EQ(TZId("UTC"), UTC_TimezoneId);
+    ASSERT_EQ(TimezoneId(), UTC_TimezoneId);
+    ASSERT_EQ(UTC1_Timezone().tz.name, "UTC+1");
+    ASSERT_THROW(TZId("No Such Time"), std::out_of_range);
+
+    // Zones built by hand are interned once and then reuse their handle.
+    TimezoneId custom = DateTimeD(Timezone("Custom Time", 5, 0)).TimeZoneId();
+    ASSERT_EQ(DateTimeD(2020, 1, 1, Timezone("Custom Time", 5, 0)).TimeZoneId(), custom);
+    ASSERT_EQ(TZId("Custom Time"), custom);
+    ASSERT_EQ(TZ(custom).gmtoff[0], 5 * 3600);
+
+    DateTimeD d(2020, 1, 1, 10, 0, 0, pst);
+    ASSERT_EQ(d.TimeZoneId(), pst);
+    ASSERT_EQ(d, DateTimeD(2020, 1, 1, 10, 0, 0, PST_Timezone().tz));
+    ASSERT_EQ(d.ToTimeZone(TZId("EST")).TimeZone().name, "EST");
+}
+
+TEST(xDateTime, CompactLayout) {
+    ASSERT_TRUE(std::is_trivially_copyable<DateTimeD>::value);
+    ASSERT_LE(sizeof(DateTimeD), 16u);
+
+    DateTimeD d(2020, 1, 1, 10, 0, 0, TZId("PST"));
+    DateTimeD copy;
+    std::memcpy(&copy, &d, sizeof(d));
+    ASSERT_EQ(copy, d);
+    ASSERT_EQ(copy.TimeZoneId(), TZId("PST"));
+
+    // Arithmetic keeps the zone of the left hand side.
+    TimeDeltaD hour(std::chrono::seconds(3600));
+    DateTimeD later = d + hour;
+    ASSERT_EQ(later.TimeZoneId(), TZId("PST"));
+    ASSERT_EQ(later.Hour(), 11);
+    ASSERT_EQ(later - d, hour);
+
+    DateTimeD e(static_cast<time_t>(86400));
+    ASSERT_EQ(e.ToTimeT(), 86400);
+    ASSERT_EQ(e.Day(), 2);
+    ASSERT_EQ(DateTimeD(e.ToChrono()), e);
+}
+
+TEST(xDateTime, UnixEpochOffset) {
+    static_assert(UnixEpochOffset<std::chrono::system_clock>::Get() == 0,
+            "system_clock counts from the Unix epoch");
+
+    // Other clocks are measured once and then cached.
+    long long steady = UnixEpochOffset<std::chrono::steady_clock>::Get();
+    ASSERT_EQ(UnixEpochOffset<std::chrono::steady_clock>::Get(), steady);
+
+    typedef DateTime<GregorianCalendar, std::chrono::steady_clock> SteadyDateTime;
+    auto now = std::chrono::steady_clock::now();
+    SteadyDateTime d(now);
+    ASSERT_EQ(SteadyDateTime(d.ToChrono()), d);
+}
+
+TEST(xDateTime, GregorianCalendar) {
+    // Compare against gmtime_r over a few centuries either side of the epoch.
+    for (long long days = -150000; days <= 150000; days += 7) {
+        time_t t = static_cast<time_t>(days * 86400);
+        struct tm tm_;
+        gmtime_r(&t, &tm_);
+        long long y;
+        int m, d;
+        GregorianCalendar::CivilFromDays(days, y, m, d);
+        ASSERT_EQ(y, tm_.tm_year + 1900);
+        ASSERT_EQ(m, tm_.tm_mon + 1);
+        ASSERT_EQ(d, tm_.tm_mday);
+        ASSERT_EQ(GregorianCalendar::WeekdayFromDays(days), tm_.tm_wday);
+        ASSERT_EQ(GregorianCalendar::DayOfYear(y, m, d), tm_.tm_yday + 1);
+        ASSERT_EQ(GregorianCalendar::DaysFromCivil(y, m, d), days);
+    }
+    ASSERT_EQ(GregorianCalendar::DaysInMonth(2000, 2), 29);
+    ASSERT_EQ(GregorianCalendar::DaysInMonth(1900, 2), 28);
+    // Out of range fields carry over, like mktime.
+    ASSERT_EQ(GregorianCalendar::SecondsFromCivil(1970, 13, 1, 0, 0, 0), 365 * 86400);
+    ASSERT_EQ(GregorianCalendar::SecondsFromCivil(1970, 1, 0, 0, 0, 0), -86400);
+
+    // Dates before 1970 round down rather than towards zero.
+    DateTimeW d(1969, 12, 31, 23, 59, 59, 250000);
+    ASSERT_EQ(d.Year(), 1969);
+    ASSERT_EQ(d.Month(), 12);
+    ASSERT_EQ(d.Day(), 31);
+    ASSERT_EQ(d.Hour(), 23);
+    ASSERT_EQ(d.Second(), 59);
+    ASSERT_EQ(d.Millisecond(), 250);
+    ASSERT_EQ(d.DayOfWeek(), 4);
+    ASSERT_EQ(d.EndOfMonthDay(), 31);
+    ASSERT_EQ(DateTimeD(2024, 2, 10).EndOfMonthDay(), 29);
+    ASSERT_EQ(DateTimeD(2024, 3, 1).DayOfYear(), 61);
+}
+
+TEST(xDateTime, FormatPlan) {
+    DateTimeD d(2021, 3, 4, 5, 6, 7, TZId("CET"));
+    FormatPlan iso("%Y-%m-%dT%H:%M:%S%z");
+    ASSERT_EQ(d.ToString(iso), "2021-03-04T05:06:07+0100");
+    ASSERT_EQ(d.ToString(iso), d.ToString("%Y-%m-%dT%H:%M:%S%z"));
+
+    // Composite conversions are expanded when the plan is built.
+    FormatPlan c("[%c] %D %%");
+    ASSERT_EQ(d.ToString(c), "[Thu Mar  4 05:06:07 2021] 03/04/21 %");
+
+    // Names come from the plan's locale.
+    FormatPlan de("%a %A %b %B", "de_DE");
+    ASSERT_EQ(de.Locale(), "de_DE");
+    ASSERT_EQ(d.ToString(de), "Do Donnerstag Mär März");
+    ASSERT_EQ(d.DayOfWeekShortString("de_DE"), "Do");
+
+    ASSERT_EQ(d.ToString("%Od.%OH"), "04.05");
+    ASSERT_EQ(DateTimeD(2021, 3, 14).ToString("%Od"), "14");
+    ASSERT_EQ(DateTimeD(2021, 3, 4, TZId("NST")).ToString("%z"), "+0330");
+    ASSERT_EQ(DateTimeD(2021, 3, 4, Timezone("Minus Time", -3, -30)).ToString("%z"), "-0330");
+
+    ASSERT_THROW(FormatPlan("%Q"), MalformedDateTime);
+    ASSERT_THROW(FormatPlan("%Ed"), MalformedDateTime);
+    ASSERT_THROW(FormatPlan("%OY"), MalformedDateTime);
+    ASSERT_THROW(FormatPlan("%a", "xx_NOWHERE"), MalformedDateTime);
+}
+
+TEST(xDateTime, Fields) {
+    DateTimeD d(2024, 12, 31, 23, 58, 59, 123456789);
+    CivilTime f = d.Fields();
+    ASSERT_EQ(f.year, 2024);
+    ASSERT_EQ(f.month, 12);
+    ASSERT_EQ(f.day, 31);
+    ASSERT_EQ(f.yday, 366);
+    ASSERT_EQ(f.wday, 2);
+    ASSERT_EQ(f.wday + 1, d.DayOfWeek());
+    ASSERT_EQ(f.hour, 23);
+    ASSERT_EQ(f.minute, 58);
+    ASSERT_EQ(f.second, 59);
+    ASSERT_EQ(f.nanosecond, 123456789);
+
+    struct tm t = d.ToTimeTM();
+    ASSERT_EQ(t.tm_yday, 365);
+    ASSERT_EQ(t.tm_wday, 2);
+
+    // Coarser periods still report the fraction in nanoseconds.
+    ASSERT_EQ(DateTimeW(1969, 12, 31, 23, 59, 59, 5).Fields().nanosecond, 5000);
+    ASSERT_EQ(DateTimeW(1969, 12, 31, 23, 59, 59, 5).ToString("%3"), "000005000");
+}
+
+TEST(xDateTime, FormatTo) {
+    DateTimeD d(2021, 3, 4, 5, 6, 7, TZId("CET"));
+    FormatPlan plan("%Y-%m-%d %H:%M:%S %Z %z");
+    std::string expected = d.ToString(plan);
+
+    char buf[64];
+    ASSERT_EQ(d.FormatTo(buf, sizeof(buf), plan), expected.size());
+    ASSERT_EQ(std::string(buf), expected);
+    ASSERT_LE(expected.size(), MaxFormattedSize(plan));
+
+    // Truncated output is still terminated, and the full length is returned.
+    char small[8];
+    ASSERT_EQ(d.FormatTo(small, sizeof(small), plan), expected.size());
+    ASSERT_EQ(std::string(small), expected.substr(0, 7));
+    ASSERT_EQ(d.FormatTo(static_cast<char*>(nullptr), 0, plan), expected.size());
+
+    std::vector<char> v;
+    d.FormatTo(std::back_inserter(v), plan);
+    ASSERT_EQ(std::string(v.begin(), v.end()), expected);
+
+    FormatPlan names("%A %B %p %Od", "de_DE");
+    ASSERT_LE(d.ToString(names).size(), MaxFormattedSize(names));
+
+    TimeDeltaD t(std::chrono::nanoseconds(-90061000000001LL));
+    ASSERT_EQ(t.FormatTo(buf, sizeof(buf)), t.ToString().size());
+    ASSERT_EQ(std::string(buf), t.ToString());
+    std::string s;
+    TimeDeltaW(std::chrono::microseconds(1)).FormatTo(std::back_inserter(s));
+    ASSERT_EQ(s, "0d 0h 0min 0s 1μs");
+}
+
+TEST(xDateTime, ISO8601Formatter) {
+    DateTimeD d(2021, 3, 4, 5, 6, 7, 123456789);
+    ASSERT_EQ(d.ToRFC3339String(), "2021-03-04T05:06:07Z");
+    ASSERT_EQ(d.ToRFC3339String(3), "2021-03-04T05:06:07.123Z");
+    ASSERT_EQ(d.ToRFC3339String(6), "2021-03-04T05:06:07.123456Z");
+    ASSERT_EQ(d.ToRFC3339String(9), "2021-03-04T05:06:07.123456789Z");
+    ASSERT_EQ(DateTimeD(2021, 3, 4, 5, 6, 7, 4000000, TZId("CET")).ToRFC3339String(3),
+            "2021-03-04T05:06:07.004+01:00");
+    ASSERT_EQ(DateTimeD(1969, 12, 31, 23, 59, 59, Timezone("Minus Time", -3, -30)).ToRFC3339String(),
+            "1969-12-31T23:59:59-03:30");
+    ASSERT_EQ(DateTimeW(2000, 2, 29, 0, 0, 0, 7).ToRFC3339String(9), "2000-02-29T00:00:00.000007000Z");
+    ASSERT_EQ(DateTimeD(2021, 3, 4).ToRFC3339String(), DateTimeD(2021, 3, 4).ToString("%Y-%m-%dT%H:%M:%SZ"));
+
+    char buf[DateTimeD::MaxISO8601Size];
+    ASSERT_EQ(d.FormatISO8601(buf, 9), 30u);
+    ASSERT_THROW(d.FormatISO8601(buf, 2), MalformedDateTime);
+    typedef DateTime<GregorianCalendar, std::chrono::system_clock, std::ratio<1>> DateTimeS;
+    ASSERT_EQ(DateTimeS(9999, 12, 31, 23, 59, 59).ToRFC3339String(), "9999-12-31T23:59:59Z");
+    ASSERT_THROW(DateTimeS(10000, 1, 1).FormatISO8601(buf), MalformedDateTime);
+}
+
+TEST(xDateTime, TryParse) {
+    DateTimeD d;
+    ASSERT_EQ(DateTimeD::TryParse("1970-03-04 05:06:07", "%Y-%m-%d %H:%M:%S", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 3, 4, 5, 6, 7));
+    ASSERT_EQ(DateTimeD::TryParse("1971-03-04 05:06", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1971, 3, 4, 5, 6, 0));
+
+    // Failures are reported without throwing and leave the output untouched.
+    DateTimeD before = d;
+    ASSERT_EQ(DateTimeD::TryParse("2021/03/04", "%Y-%m-%d", d), ParseError::Mismatch);
+    ASSERT_EQ(DateTimeD::TryParse("2021-", "%Y-%m", d), ParseError::BadValue);
+    ASSERT_EQ(DateTimeD::TryParse("99999999999999", "%Y", d), ParseError::BadValue);
+    ASSERT_EQ(DateTimeD::TryParse("2021-03-04x", "%Y-%m-%d", d), ParseError::TrailingCharacters);
+    ASSERT_EQ(DateTimeD::TryParse("2021", "%Y%Q", d), ParseError::BadFormat);
+    ASSERT_EQ(DateTimeD::TryParse("2021 NOWHERE", "%Y %Z", d), ParseError::UnknownTimezone);
+    ASSERT_EQ(DateTimeD::TryParse("not a date", d), ParseError::NoMatchingFormat);
+    ASSERT_EQ(d, before);
+    ASSERT_EQ(d.TryFromString("1970-12-31", "%Y-%m-%d"), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 12, 31));
+
+    // The throwing interfaces are layered on top and keep their messages.
+    try {
+        DateTimeD bad("not a date");
+        FAIL();
+    }
+    catch (const MalformedDateTime& e) {
+        ASSERT_EQ(e.what(), ParseErrorString(ParseError::NoMatchingFormat));
+    }
+    ASSERT_THROW(d.FromString("2021-03-04x", "%Y-%m-%d"), MalformedDateTime);
+}
+
+TEST(xDateTime, FormatDetector) {
+    const char* inputs[] = {
+        "1970-01-02T03:04:05.123Z+0100", "1970-01-02T03:04:05.123Z", "1970-01-02 03:04:05.5",
+        "1970-01-02T03:04:05Z-0130", "1970-01-02T03:04:05Z", "1970-01-02 03:04:05",
+        "1970-01-02 03:04", "1970-1-2",
+    };
+    int expected[] = {0, 1, 2, 9, 10, 11, 12, 13};
+    for (int i = 0; i < 8; ++i) {
+        const char* s = inputs[i];
+        ASSERT_EQ(FormatDetector::IsoFormat(s, s + strlen(s)), expected[i]) << s;
+        DateTimeD d;
+        ASSERT_EQ(d.TryFromString(s, FormatDetector::IsoFormats()[expected[i]]), ParseError::None) << s;
+    }
+    const char* rejected[] = {"1970-01-02T03:04Z", "1970-01-02 03:04:05Z", "1970-01-02T03:04:05Z+01:00",
+        "1970-01-02 03:04:05.1234567890", "1970-001-02", "1970/01/02"};
+    for (const char* s: rejected) {
+        ASSERT_EQ(FormatDetector::IsoFormat(s, s + strlen(s)), -1) << s;
+    }
+
+    // The locale's formats still take priority over the ISO ones.
+    DateTimeD d;
+    ASSERT_EQ(DateTimeD::TryParse("01/02/70", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2));
+    ASSERT_EQ(DateTimeD::TryParse("03:04:05", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 1, 3, 4, 5));
+    ASSERT_EQ(DateTimeD::TryParse("1970-01-02T03:04:05Z", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 3, 4, 5));
+    ASSERT_EQ(DateTimeD::TryParse("1970-01-02T03:04", d), ParseError::NoMatchingFormat);
+}
+
+TEST(xDateTime, ParsePlan) {
+    ParsePlan plan("%Y-%m-%d %H:%M:%S");
+    ASSERT_EQ(plan.Error(), ParseError::None);
+    DateTimeD d;
+    ASSERT_EQ(d.TryFromString("1970-03-04 05:06:07", plan), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 3, 4, 5, 6, 7));
+    ASSERT_EQ(DateTimeD::TryParse("1970-01-02 00:00:01", plan, d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 0, 0, 1));
+    ASSERT_EQ(d.TryFromString("1970-01-02", plan), ParseError::Mismatch);
+    ASSERT_EQ(d.TryFromString("1970-01-02 xx:00:00", plan), ParseError::BadValue);
+
+    // Composite conversions and names are resolved when the plan is compiled.
+    ParsePlan names("%A %d %B %T", "de_DE");
+    ASSERT_EQ(d.TryFromString("Freitag 02 Januar 10:20:30", names), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 10, 20, 30));
+    ASSERT_EQ(d.TryFromString("Friday 02 January 10:20:30", names), ParseError::Mismatch);
+    ASSERT_EQ(DateTimeD::TryParse("1970-01-01 00:00:00.000000005", "%F %T.%3", d), ParseError::None);
+    ASSERT_EQ(d.TimeSinceEpoch(), 5);
+
+    // A bad format is reported when it is used, not by throwing.
+    ParsePlan bad("%Y %Q");
+    ASSERT_EQ(bad.Error(), ParseError::BadFormat);
+    ASSERT_EQ(d.TryFromString("1970 1", bad), ParseError::BadFormat);
+    ASSERT_EQ(ParsePlan("%Y %").Error(), ParseError::BadFormat);
+    ASSERT_EQ(ParsePlan("%Ed").Error(), ParseError::BadFormat);
+    ASSERT_EQ(ParsePlan("%a", "xx_NOWHERE").Error(), ParseError::None);
+    ASSERT_THROW(d.FromString("1970 1", bad), MalformedDateTime);
+}
+
+TEST(xDateTime, ParseChars) {
+    ParsePlan plan("%Y-%m-%dT%H:%M:%SZ");
+    const char record[] = "1970-01-02T03:04:05Z GET /index.html 200";
+    const char* end = record + strlen(record);
+    DateTimeD d;
+    size_t consumed = 0;
+    ASSERT_EQ(d.TryFromChars(record, end, plan, consumed), ParseError::None);
+    ASSERT_EQ(consumed, 20u);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 3, 4, 5));
+    ASSERT_EQ(DateTimeD::TryParse(record, end, plan, d), ParseError::TrailingCharacters);
+    ASSERT_EQ(DateTimeD::TryParse(record, record + 20, plan, d), ParseError::None);
+    ASSERT_EQ(d.TryFromChars(record, record + 20), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 3, 4, 5));
+
+    // Input cut short anywhere is rejected without reading past its end.
+    for (size_t n = 1; n < 20; ++n) {
+        std::string cut(record, n);
+        ASSERT_NE(d.TryFromChars(cut.data(), cut.data() + n, plan, consumed), ParseError::None) << n;
+        ASSERT_LE(consumed, n);
+    }
+    ASSERT_EQ(d.TryFromChars(record, record + 10, plan, consumed), ParseError::Mismatch);
+    ASSERT_EQ(consumed, 10u);
+}
+
+TEST(xDateTime, ISO8601Parser) {
+    DateTimeD d;
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07Z"), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 3, 4, 5, 6, 7));
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04 05:06:07.5"), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 3, 4, 5, 6, 7, 500000000));
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04t05:06:07.1234567891234z"), ParseError::None);
+    ASSERT_EQ(d.Nanosecond(), 123456789);
+    ASSERT_EQ(d.TryFromISO8601("1969-12-31T23:59:59-03:30"), ParseError::None);
+    ASSERT_EQ(d.TimeZone().gmtoff[0], -(3 * 3600 + 30 * 60));
+    ASSERT_EQ(d.ToUTC(), DateTimeD(1970, 1, 1, 3, 29, 59));
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07+05:30"), ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), TZId("UTC+5:30"));
+    // Less than an hour behind UTC. There is no built-in zone for that name, so
+    // it doesn't read back as the one for +00:30.
+    ASSERT_EQ(d.TryFromISO8601("2021-01-01T00:00:00-00:30"), ParseError::None);
+    ASSERT_EQ(d.TimeZone().name, "UTC-0:30");
+    ASSERT_EQ(d.UTCOffset(), -1800);
+    ASSERT_EQ(d.ToString("%z"), "-0030");
+    DateTimeD r;
+    ASSERT_EQ(r.TryFromString(d.ToString("%Y-%m-%d %H:%M:%S %z"), "%Y-%m-%d %H:%M:%S %z"), ParseError::None);
+    ASSERT_EQ(r.TimeZoneId(), d.TimeZoneId());
+    ASSERT_EQ(r, d);
+    ASSERT_NE(r.TryFromString(d.ToString("%Y-%m-%d %H:%M:%S %Z"), "%Y-%m-%d %H:%M:%S %Z"), ParseError::None);
+
+    // It reads back what FormatISO8601 writes.
+    const DateTimeD samples[] = {
+        DateTimeD(2021, 3, 4, 5, 6, 7, 123456789, TZId("CET")),
+        DateTimeD(2000, 2, 29, 23, 59, 59, 1),
+        DateTimeD(1700, 1, 1),
+        DateTimeD(2200, 12, 31, 23, 59, 59, 999999999, Timezone("Minus Time", -11, -45)),
+    };
+    for (const DateTimeD& s: samples) {
+        for (int digits: {0, 3, 6, 9}) {
+            std::string text = s.ToRFC3339String(digits);
+            DateTimeD r;
+            ASSERT_EQ(r.TryFromISO8601(text), ParseError::None) << text;
+            ASSERT_EQ(r.ToRFC3339String(digits), text);
+        }
+    }
+
+    // The portable and SIMD scanners agree, on good input and bad.
+    const char* inputs[] = {"2021-03-04T05:06:07", "1999-12-31T23:59:60", "2021-02-29T00:00:00",
+        "2021-13-01T00:00:00", "2021-00-10T00:00:00", "2021-01-10T24:00:00", "2021-01-10T00:60:00",
+        "2021/01/10T00:00:00", "2021-01-10T00-00:00", "2O21-01-10T00:00:00", "2021-01-10T00:00:0\xff",
+        "2021-01-1 T00:00:00", "0000-01-01T00:00:00"};
+    for (const char* s: inputs) {
+        ISO8601Fields a = ISO8601Fields(), b = ISO8601Fields();
+        ParseError err = ISO8601Parser::ScanDateTimeSWAR(s, a);
+#ifdef X_DATETIME_SSE2
+        ASSERT_EQ(ISO8601Parser::ScanDateTimeSSE2(s, b), err) << s;
+#else
+        b = a;
+#endif
+        if (err == ParseError::None) {
+            ASSERT_EQ(a.year * 10000 + a.month * 100 + a.day, b.year * 10000 + b.month * 100 + b.day) << s;
+            ASSERT_EQ(a.hour * 10000 + a.minute * 100 + a.second, b.hour * 10000 + b.minute * 100 + b.second) << s;
+        }
+    }
+
+    DateTimeD before = d;
+    ASSERT_EQ(d.TryFromISO8601("2021-02-29T00:00:00Z"), ParseError::BadValue);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06"), ParseError::Mismatch);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04X05:06:07"), ParseError::Mismatch);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07."), ParseError::BadValue);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07+0100"), ParseError::Mismatch);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07+01:0"), ParseError::BadValue);
+    ASSERT_EQ(d.TryFromISO8601("2021-03-04T05:06:07Zx"), ParseError::TrailingCharacters);
+    ASSERT_EQ(d, before);
+    ASSERT_THROW(d.FromISO8601("2021-03-04"), MalformedDateTime);
+
+    // Embedded in a record, and cut short anywhere.
+    const char record[] = "2021-03-04T05:06:07.25+01:00 GET /index.html";
+    size_t consumed = 0;
+    ASSERT_EQ(d.TryFromISO8601(record, record + strlen(record), consumed), ParseError::None);
+    ASSERT_EQ(consumed, 28u);
+    ASSERT_EQ(d, DateTimeD(2021, 3, 4, 5, 6, 7, 250000000, TZId("CET")));
+    for (size_t n = 0; n < 28; ++n) {
+        std::vector<char> cut(record, record + n);
+        ParseError err = d.TryFromISO8601(cut.data(), cut.data() + n, consumed);
+        ASSERT_LE(consumed, n);
+        if (err == ParseError::None) {
+            ASSERT_EQ(consumed, n);
+        }
+    }
+}
+
+TEST(xDateTime, ISO8601Range) {
+    // Years which don't fit in nanosecond ticks are refused, like the generic parser does.
+    DateTimeD d(2021, 1, 1);
+    const DateTimeD before = d;
+    for (const char* s: {"0001-01-01T00:00:00Z", "9999-12-31T23:59:59Z", "1600-01-01T00:00:00Z",
+                         "2300-01-01T00:00:00Z"}) {
+        ASSERT_EQ(d.TryFromISO8601(s), ParseError::BadValue) << s;
+        ASSERT_EQ(d.TryFromString(s, "%Y-%m-%dT%H:%M:%SZ"), ParseError::BadValue) << s;
+        ParseContext ctx;
+        ASSERT_EQ(d.TryFromISO8601(s, ctx), ParseError::BadValue) << s;
+    }
+    ASSERT_EQ(d, before);
+
+    // With whole second ticks, they round-trip.
+    typedef DateTime<GregorianCalendar, std::chrono::system_clock, std::ratio<1>> DateTimeS;
+    for (const DateTimeS& s: {DateTimeS(1, 1, 1), DateTimeS(9999, 12, 31, 23, 59, 59)}) {
+        std::string text = s.ToRFC3339String(0);
+        DateTimeS r;
+        ASSERT_EQ(r.TryFromISO8601(text), ParseError::None) << text;
+        ASSERT_EQ(r, s);
+    }
+}
+
+TEST(xDateTime, FromFields) {
+    DateTimeD d;
+    ASSERT_EQ(DateTimeD::TryParse("2021 01 2", "%Y %V %u", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 1, 4));
+    ASSERT_EQ(DateTimeD::TryParse("2020 53", "%Y %V", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2020, 12, 28));
+    ASSERT_EQ(DateTimeD::TryParse("2021 00 Fri", "%Y %U %a", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 1, 1));
+    ASSERT_EQ(DateTimeD::TryParse("2021 01", "%Y %W", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 1, 4));
+    ASSERT_EQ(DateTimeD::TryParse("2020 366", "%Y %j", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2020, 12, 31));
+    ASSERT_EQ(DateTimeD::TryParse("20 21-03", "%C %y-%m", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 3, 1));
+    ASSERT_EQ(DateTimeD::TryParse("12:30 AM", "%I:%M %p", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 1, 0, 30, 0));
+    ASSERT_EQ(DateTimeD::TryParse("01:00 PM", "%I:%M %p", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 1, 13, 0, 0));
+    ASSERT_EQ(DateTimeD::TryParse("86400.250", "%s.%1", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(1970, 1, 2, 0, 0, 0, 250000000));
+    ASSERT_EQ(DateTimeD::TryParse("2021-03-04 05:06 -0130", "%Y-%m-%d %H:%M %z", d), ParseError::None);
+    ASSERT_EQ(d.TimeZone().gmtoff[0], -5400);
+    ASSERT_EQ(d.ToUTC(), DateTimeD(2021, 3, 4, 6, 36, 0));
+
+    // Out of range fields are rejected rather than carried over.
+    DateTimeD before = d;
+    const char* bad[][2] = {
+        {"2021-13-01", "%Y-%m-%d"}, {"2021-02-29", "%Y-%m-%d"}, {"2021-04-00", "%Y-%m-%d"},
+        {"2021 366", "%Y %j"}, {"2021 54", "%Y %V"}, {"24:00", "%H:%M"}, {"00:60", "%H:%M"},
+        {"00:00:61", "%T"}, {"13 PM", "%I %p"}, {"2021 +2400", "%Y %z"}, {"99999999999", "%s"},
+    };
+    for (auto& b: bad) {
+        ASSERT_EQ(DateTimeD::TryParse(b[0], b[1], d), ParseError::BadValue) << b[0];
+    }
+    ASSERT_EQ(d, before);
+    ASSERT_EQ(DateTimeD::TryParse("2000-02-29 23:59:60", "%F %T", d), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2000, 3, 1));
+}
+
+TEST(xDateTime, ParseMany) {
+    // Every 7th row is bad, and the buffer ends with a delimiter.
+    std::string column;
+    std::vector<long long> expected;
+    for (int i = 0; i < 1000; ++i) {
+        DateTimeD d = DateTimeD(2020, 1, 1) + Seconds(i * 3671LL);
+        if (i % 7 == 3) {
+            column += "garbage";
+        }
+        else {
+            column += d.ToString("%Y-%m-%dT%H:%M:%SZ");
+        }
+        column += (i % 2) ? "\r\n" : "\n";
+        expected.push_back(i % 7 == 3 ? 0 : d.UTCTicks());
+    }
+    ParsePlan plan("%Y-%m-%dT%H:%M:%SZ");
+
+    ParseManyOptions options;
+    options.min_chunk_size = 100;
+    options.threads = 4;
+    ThreadPool pool(3);
+    for (int run = 0; run < 3; ++run) {
+        options.threads = (run == 0) ? 1 : 4;
+        options.pool = (run == 2) ? &pool : NULL;
+        std::vector<long long> ticks(1000, -1);
+        std::vector<uint64_t> errors(16, ~0ULL);
+        ParseManyResult r = DateTimeD::ParseMany(column.data(), column.size(), '\n', plan,
+                ticks.data(), ticks.size(), errors.data(), options);
+        ASSERT_EQ(r.rows, 1000u);
+        ASSERT_EQ(r.errors, 143u);
+        ASSERT_EQ(ticks, expected);
+        for (size_t i = 0; i < 1000; ++i) {
+            ASSERT_EQ((errors[i / 64] >> (i % 64)) & 1, i % 7 == 3 ? 1u : 0u) << i;
+        }
+    }
+
+    // The ISO 8601 parser, rows beyond the capacity, and empty rows.
+    long long ticks[3];
+    uint64_t errors = 0;
+    const char rows[] = "2021-03-04T05:06:07+01:00,,1970-01-01T00:00:01Z,2000-01-01T00:00:00Z";
+    ParseManyResult r = DateTimeD::ParseManyISO8601(rows, strlen(rows), ',', ticks, 3, &errors);
+    ASSERT_EQ(r.rows, 4u);
+    ASSERT_EQ(r.errors, 1u);
+    ASSERT_EQ(errors, 2u);
+    ASSERT_EQ(ticks[0], DateTimeD(2021, 3, 4, 4, 6, 7).UTCTicks());
+    ASSERT_EQ(ticks[2], 1000000000LL);
+    ASSERT_EQ(DateTimeD::ParseManyISO8601("", 0, ',', ticks, 3).rows, 0u);
+
+    // Offsets without a built-in zone, which the threads add to the registry as they go.
+    std::string offsets;
+    std::vector<long long> offset_expected;
+    for (int i = 0; i < 2000; ++i) {
+        const int minutes = 11 * 60 + 7 + i % 53;
+        char row[40];
+        snprintf(row, sizeof(row), "2021-03-04T05:06:07-%02d:%02d\n", minutes / 60, minutes % 60);
+        offsets += row;
+        offset_expected.push_back(DateTimeD(2021, 3, 4, 5, 6, 7).UTCTicks() + minutes * 60 * 1000000000LL);
+    }
+    std::vector<long long> offset_ticks(2000);
+    options.threads = 4;
+    options.pool = NULL;
+    r = DateTimeD::ParseManyISO8601(offsets.data(), offsets.size(), '\n', offset_ticks.data(),
+            offset_ticks.size(), NULL, options);
+    ASSERT_EQ(r.errors, 0u);
+    ASSERT_EQ(offset_ticks, offset_expected);
+}
+
+TEST(xDateTime, ParseContext) {
+    // Records an hour apart, so the date changes now and then.
+    ParsePlan plan("%Y-%m-%d %H:%M:%S");
+    ASSERT_EQ(plan.DatePrefix(), 6u);
+    ParseContext ctx, iso_ctx;
+    for (int i = 0; i < 100; ++i) {
+        DateTimeD d = DateTimeD(2020, 6, 14, 20, 0, 0) + Seconds(i * 3599LL);
+        std::string line = d.ToString("%Y-%m-%d %H:%M:%S");
+        DateTimeD a, b, c;
+        ASSERT_EQ(a.TryFromString(line, plan, ctx), ParseError::None);
+        ASSERT_EQ(b.TryFromString(line, plan), ParseError::None);
+        ASSERT_EQ(a, b) << line;
+        ASSERT_EQ(a, d);
+
+        char buf[DateTimeD::MaxISO8601Size];
+        std::string iso(buf, d.FormatISO8601(buf));
+        ASSERT_EQ(c.TryFromISO8601(iso, iso_ctx), ParseError::None);
+        ASSERT_EQ(c, d) << iso;
+    }
+    // The date changes 4 times.
+    ASSERT_EQ(ctx.Hits(), 95u);
+    ASSERT_EQ(ctx.Misses(), 5u);
+    ASSERT_EQ(iso_ctx.Hits(), 95u);
+
+    // Errors after a hit are the same as without the context.
+    DateTimeD a, b;
+    ASSERT_EQ(a.TryFromString("2020-06-18 23:00:00", plan, ctx), ParseError::None);
+    ASSERT_EQ(a.TryFromString("2020-06-18 24:00:00", plan, ctx), b.TryFromString("2020-06-18 24:00:00", plan));
+    ASSERT_EQ(a.TryFromString("2020-06-18 23:00:00x", plan, ctx), ParseError::TrailingCharacters);
+    ASSERT_EQ(a.TryFromISO8601("2020-06-18T23:00:00Z", ctx), ParseError::None);
+    ASSERT_EQ(a.TryFromISO8601("2020-06-18T23:61:00Z", ctx), ParseError::BadValue);
+    ASSERT_EQ(a.TryFromISO8601("2020-06-18T23:00:00Zx", ctx), ParseError::TrailingCharacters);
+    ASSERT_EQ(a, DateTimeD(2020, 6, 18, 23, 0, 0));
+
+    // A number at the end of the date which stopped early must stop there again.
+    ParsePlan hours("%Y-%m-%d %H");
+    ASSERT_EQ(a.TryFromString("2020-06-1 12", hours, ctx), ParseError::None);
+    ASSERT_EQ(a, DateTimeD(2020, 6, 1, 12, 0, 0));
+    ASSERT_EQ(a.TryFromString("2020-06-15 12", hours, ctx), ParseError::None);
+    ASSERT_EQ(a, DateTimeD(2020, 6, 15, 12, 0, 0));
+
+    // Plans which can't be split at the date.
+    ASSERT_EQ(ParsePlan("%s").DatePrefix(), 0u);
+    ASSERT_EQ(ParsePlan("%H:%M %Y-%m-%d").DatePrefix(), 0u);
+    ASSERT_EQ(ParsePlan("%Y-%m-%d %H %j").DatePrefix(), 0u);
+    ParsePlan epoch("%s");
+    ASSERT_EQ(a.TryFromString("1000", epoch, ctx), ParseError::None);
+    ASSERT_EQ(a.TryFromString("1001", epoch, ctx), ParseError::None);
+    ASSERT_EQ(a.UTCTicks(), 1001000000000LL);
+}
+
+#ifdef X_DATETIME_MMAP
+TEST(xDateTime, LogReader) {
+    // Lines cross the 4 KB windows, and one line is longer than two of them.
+    const std::string path = testing::TempDir() + "xdatetime_log_reader.log";
+    std::vector<unsigned long long> offsets;
+    std::vector<DateTimeD> times;
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        unsigned long long at = 0;
+        for (int i = 0; i < 2000; ++i) {
+            std::string line;
+            if (i % 10 == 9) {
+                line = "garbage";
+            }
+            else {
+                DateTimeD d = DateTimeD(2020, 6, 14, 23, 0, 0) + Seconds(i * 7LL);
+                line = d.ToString("%Y-%m-%dT%H:%M:%SZ") + " INFO message " + std::to_string(i);
+                offsets.push_back(at);
+                times.push_back(d);
+            }
+            if (i == 500) line += std::string(10000, 'x');
+            line += (i % 3 == 0) ? "\r\n" : "\n";
+            if (i == 1999) line = line.substr(0, line.find_first_of("\r\n"));
+            out << line;
+            at += line.size();
+        }
+    }
+
+    LogReader<DateTimeD> reader(path, 0, 4096);
+    for (int pass = 0; pass < 2; ++pass) {
+        unsigned long long offset;
+        DateTimeD d;
+        size_t n = 0;
+        while (reader.Next(offset, d)) {
+            ASSERT_LT(n, times.size());
+            ASSERT_EQ(offset, offsets[n]);
+            ASSERT_EQ(d, times[n]);
+            ++n;
+        }
+        ASSERT_EQ(n, times.size());
+        ASSERT_EQ(reader.Lines(), 2000u);
+        ASSERT_EQ(reader.Skipped(), 200u);
+        reader.Rewind();
+    }
+
+    // A ParsePlan at a fixed column, with month names.
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "[4242] 15/Jun/2020:12:00:00 +0200 GET /\n";
+        out << "[4242] 15/Jun/2020:12:00:01 +0200 GET /a\n";
+        out << "[4242] -\n";
+        out << "[4242] 16/Jun/2020:00:00:00 +0200 GET /b\n";
+    }
+    LogReader<DateTimeD> apache(path, ParsePlan("%d/%b/%Y:%H:%M:%S %z"), 7);
+    unsigned long long offset;
+    DateTimeD d;
+    ASSERT_TRUE(apache.Next(offset, d));
+    ASSERT_EQ(offset, 0u);
+    ASSERT_EQ(d.UTCTicks(), DateTimeD(2020, 6, 15, 10, 0, 0).UTCTicks());
+    ASSERT_TRUE(apache.Next(offset, d));
+    ASSERT_EQ(d.UTCTicks(), DateTimeD(2020, 6, 15, 10, 0, 1).UTCTicks());
+    ASSERT_TRUE(apache.Next(offset, d));
+    ASSERT_EQ(offset, 90u);
+    ASSERT_EQ(d.UTCTicks(), DateTimeD(2020, 6, 15, 22, 0, 0).UTCTicks());
+    ASSERT_FALSE(apache.Next(offset, d));
+    ASSERT_EQ(apache.Skipped(), 1u);
+
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    }
+    LogReader<DateTimeD> empty(path);
+    ASSERT_FALSE(empty.Next(offset, d));
+    std::remove(path.c_str());
+    ASSERT_THROW(LogReader<DateTimeD> missing(path), std::system_error);
+}
+#endif
+
+TEST(xDateTime, NameIndex) {
+    std::map<int, std::string> names;
+    names[0] = "Jun";
+    names[1] = "June";
+    names[2] = "Juli";
+    names[3] = "";
+    names[4] = "März";
+    names[5] = "Jun";
+    NameIndex index(names);
+    ASSERT_FALSE(index.Empty());
+    ASSERT_TRUE(NameIndex().Empty());
+
+    // The longest name wins, and of equal names the smallest key.
+    const char input[] = "June 1";
+    const char* p = input;
+    ASSERT_EQ(index.Match(p, input + 6), 1);
+    ASSERT_EQ(p, input + 4);
+    p = input;
+    ASSERT_EQ(index.Match(p, input + 3), 0);
+    ASSERT_EQ(p, input + 3);
+    p = input;
+    ASSERT_EQ(index.Match(p, input + 2), -1);
+    ASSERT_EQ(p, input);
+    ASSERT_EQ(index.Find("März"), 4);
+    ASSERT_EQ(index.Find("Jul"), -1);
+    ASSERT_EQ(index.Find(""), -1);
+
+    // Locale tables share one index.
+    const NameIndex& months = LocaleData::GetNameIndex(LocaleData::GetLongMonths("de_DE"));
+    ASSERT_EQ(&months, &LocaleData::GetNameIndex(LocaleData::GetLongMonths("de_DE")));
+    ASSERT_EQ(months.Find("März"), 2);
+    ASSERT_EQ(LocaleData::GetReverseAltDigit("C", "7"), 7);
+    ASSERT_TRUE(LocaleData::IsValidLocaleAltDigit("C", "3"));
+    ASSERT_FALSE(LocaleData::IsValidLocaleAltDigit("C", "Mon"));
+    ASSERT_THROW(LocaleData::GetReverseAltDigit("C", "x"), MalformedDateTime);
+
+    DateTimeD d;
+    ASSERT_EQ(d.TryFromString("Donnerstag 4 März 2021", "%A %d %B %Y", "de_DE"), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 3, 4));
+    ASSERT_EQ(d.TryFromString("Donnerstag 4 Mär 2021", "%A %d %B %Y", "de_DE"), ParseError::Mismatch);
+}
+
+TEST(xDateTime, ParseZoneNames) {
+    DateTimeD d;
+    ASSERT_EQ(d.TryFromString("2021-06-01 12:00 CEST", "%Y-%m-%d %H:%M %Z"), ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), TZId("CEST"));
+    ASSERT_EQ(d.TryFromString("2021-06-01 12:00 Central European Summer Time", "%Y-%m-%d %H:%M %Z"),
+            ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), TZId("Central European Summer Time"));
+    // "Central European Time" is also a name, but the longer one wins.
+    ASSERT_EQ(d.TryFromString("Central European Time 12:00", "%Z %H:%M"), ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), TZId("Central European Time"));
+    ASSERT_EQ(d.TryFromString("UTC+5:30 12:00", "%Z %H:%M"), ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), TZId("UTC+5:30"));
+
+    // A name can't stop in the middle of a number or a word, so UTC+0 doesn't
+    // take the start of the offset here.
+    ASSERT_EQ(d.TryFromString("12:00 UTC+0100", "%H:%M %Z%z"), ParseError::None);
+    ASSERT_EQ(d.UTCTicks(), DateTimeD(1970, 1, 1, 11, 0, 0).UTCTicks());
+    ASSERT_EQ(d.TryFromString("2021 CESTX", "%Y %Z"), ParseError::UnknownTimezone);
+    ASSERT_EQ(d.TryFromString("2021 CEST2", "%Y %Z%m"), ParseError::None);
+    ASSERT_EQ(d, DateTimeD(2021, 2, 1, TZ("CEST")));
+
+    // Zones registered at run time are still found by name.
+    TimezoneId custom = DateTimeD(Timezone("XYZT", 3, 0)).TimeZoneId();
+    ASSERT_EQ(d.TryFromString("2021 XYZT", "%Y %Z"), ParseError::None);
+    ASSERT_EQ(d.TimeZoneId(), custom);
+}
+
+// Central European time for 2021, as a zone with transitions.
+static Timezone TestBerlin() {
+    Timezone zone;
+    zone.name = "Test/Berlin";
+    zone.utc = {0, DateTimeD(2021, 3, 28, 1, 0, 0).ToTimeT(), DateTimeD(2021, 10, 31, 1, 0, 0).ToTimeT()};
+    zone.gmtoff = {3600, 7200, 3600};
+    zone.tzname = {"CET", "CEST", "CET"};
+    zone.dst = {0, 1, 0};
+    return zone;
+}
+
+TEST(xDateTime, ZoneTransitions) {
+    TimezoneId berlin = DateTimeD(TestBerlin()).TimeZoneId();
+    DateTimeD summer(2021, 7, 1, 12, 0, 0, berlin);
+    DateTimeD winter(2021, 1, 1, 12, 0, 0, berlin);
+    ASSERT_EQ(summer.UTCOffset(), 7200);
+    ASSERT_TRUE(summer.IsDST());
+    ASSERT_EQ(winter.UTCOffset(), 3600);
+    ASSERT_FALSE(winter.IsDST());
+    ASSERT_EQ(summer.UTCTicks(), DateTimeD(2021, 7, 1, 10, 0, 0).UTCTicks());
+    ASSERT_EQ(summer.ToString("%H:%M %z"), "12:00 +0200");
+    ASSERT_EQ(winter.ToString("%H:%M %z"), "12:00 +0100");
+    ASSERT_EQ(summer.ToUTC(), DateTimeD(2021, 7, 1, 10, 0, 0));
+    ASSERT_GT(DateTimeD(2021, 7, 1, 11, 30, 0), summer);
+    ASSERT_LT(DateTimeD(2021, 7, 1, 9, 30, 0), summer);
+
+    // Across the changes, from UTC.
+    DateTimeD before = DateTimeD(2021, 3, 28, 0, 59, 59).ToTimeZone(berlin);
+    DateTimeD after = DateTimeD(2021, 3, 28, 1, 0, 0).ToTimeZone(berlin);
+    ASSERT_EQ(before.ToString("%H:%M:%S %z"), "01:59:59 +0100");
+    ASSERT_EQ(after.ToString("%H:%M:%S %z"), "03:00:00 +0200");
+    ASSERT_EQ(after.UTCTicks() - before.UTCTicks(), 1000000000);
+    // Both of these are 02:30 locally, and keep their own offsets.
+    const DateTimeD first(2021, 10, 31, 0, 30, 0), second(2021, 10, 31, 1, 30, 0);
+    ASSERT_EQ(first.ToTimeZone(berlin).ToString("%H:%M %z"), "02:30 +0200");
+    ASSERT_EQ(second.ToTimeZone(berlin).ToString("%H:%M %z"), "02:30 +0100");
+    ASSERT_TRUE(first.ToTimeZone(berlin).IsDST());
+    ASSERT_EQ(first.ToTimeZone(berlin).ToUTC(), first);
+    ASSERT_EQ(second.ToTimeZone(berlin).ToUTC(), second);
+    ASSERT_EQ(first.ToTimeZone(berlin), first);
+    ASSERT_LT(first.ToTimeZone(berlin), second.ToTimeZone(berlin));
+    for (long long t = first.ToTimeT() - 7200; t < second.ToTimeT() + 7200; t += 900) {
+        const DateTimeD d = DateTimeD(static_cast<time_t>(t)).ToTimeZone(berlin);
+        ASSERT_EQ(d.UTCTicks(), t * 1000000000) << t;
+        ASSERT_EQ(d.ToTimeZone(berlin).UTCTicks(), d.UTCTicks()) << t;
+    }
+
+    // A repeated local time takes the later offset, a skipped one the earlier.
+    ASSERT_EQ(DateTimeD(2021, 10, 31, 2, 30, 0, berlin).UTCOffset(), 3600);
+    ASSERT_EQ(DateTimeD(2021, 3, 28, 2, 30, 0, berlin).UTCOffset(), 3600);
+
+    const ZoneTransitions& t = TZTransitions(berlin);
+    ASSERT_EQ(t.Size(), 3u);
+    ASSERT_EQ(t.Abbreviation(t.AtUTC(summer.UTCTicks() / 1000000000)), "CEST");
+    ASSERT_EQ(t.Abbreviation(t.AtUTC(-1)), "CET");
+    ASSERT_EQ(TZTransitions(UTC_TimezoneId).AtUTC(0).gmtoff, 0);
+    ASSERT_EQ(TZTransitions(TZId("UTC+5:30")).AtLocal(123456789).gmtoff, 5 * 3600 + 1800);
+
+    // Against a linear scan, for every size of tree up to 40.
+    for (int n = 1; n <= 40; ++n) {
+        Timezone zone;
+        zone.name = "Test/Random" + std::to_string(n);
+        for (int i = 0; i < n; ++i) {
+            zone.utc.push_back(i * 1000 + (i * 7919) % 500);
+            zone.gmtoff.push_back((i * 37) % 50 * 60);
+        }
+        ZoneTransitions z(zone);
+        for (long long at = -100; at < n * 1000 + 100; at += 37) {
+            int expected = zone.gmtoff[0];
+            for (int i = 0; i < n; ++i) {
+                if (zone.utc[i] <= at) expected = zone.gmtoff[i];
+            }
+            ASSERT_EQ(z.AtUTC(at).gmtoff, expected) << n << " " << at;
+        }
+    }
+}
+
+TEST(xDateTime, ZoneTransitionHint) {
+    Timezone zone;
+    zone.name = "Test/Hint";
+    for (int i = 0; i < 50; ++i) {
+        zone.utc.push_back(i * 1000);
+        zone.gmtoff.push_back(i * 60);
+    }
+    ZoneTransitions a(zone), b(TestBerlin());
+
+    // One hint over both tables and both directions, in order and out of it.
+    ZoneTransitions::Hint hint;
+    for (long long t = -500; t < 51000; t += 7) {
+        ASSERT_EQ(a.AtUTC(t, hint).gmtoff, a.AtUTC(t).gmtoff) << t;
+        ASSERT_EQ(a.AtUTC(t, hint).gmtoff, a.AtUTC(t).gmtoff) << t;
+        ASSERT_EQ(a.AtLocal(t, hint).gmtoff, a.AtLocal(t).gmtoff) << t;
+        const long long u = (t * 7919) % 60000 - 5000;
+        ASSERT_EQ(a.AtUTC(u, hint).gmtoff, a.AtUTC(u).gmtoff) << u;
+        ASSERT_EQ(b.AtUTC(t * 40000, hint).gmtoff, b.AtUTC(t * 40000).gmtoff) << t;
+    }
+    ASSERT_EQ(a.AtUTC(LLONG_MIN, hint).gmtoff, 0);
+    ASSERT_EQ(a.AtUTC(LLONG_MAX, hint).gmtoff, 49 * 60);
+    ASSERT_EQ(a.AtUTC(LLONG_MAX, hint).gmtoff, 49 * 60);
+
+    // Through DateTime, whose lookups share a hint per thread.
+    TimezoneId berlin = DateTimeD(TestBerlin()).TimeZoneId();
+    DateTimeD d(2021, 3, 28, 0, 0, 0, berlin);
+    for (int i = 0; i < 4 * 60; ++i, d.AddSeconds(60)) {
+        ASSERT_EQ(d.UTCOffset(), TZTransitions(berlin).AtLocal(d.ToTimeT()).gmtoff);
+        ASSERT_EQ(DateTimeD(2021, 3, 28, 0, 0, 0).ToTimeZone(berlin).UTCOffset(), 3600);
+    }
+}
+
+TEST(xDateTime, BuiltinZones) {
+    // Built-in zones are read from the tables on first use, once, even when several
+    // threads get there together.
+    const TimezoneId first_use = Yakutsk_Time_TimezoneId;
+    std::vector<const Timezone*> seen(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&seen, i, first_use]() { seen[i] = &TZ(first_use); });
+    }
+    for (std::thread& t: threads) t.join();
+    for (const Timezone* z: seen) {
+        ASSERT_EQ(z, &TZ(first_use));
+    }
+    ASSERT_EQ(TZ(first_use).name, "Yakutsk Time");
+    ASSERT_EQ(&TZTransitions(first_use), &TZTransitions(first_use));
+
+    // The tables are constant, and the enum names their handles.
+    static_assert(BuiltinZones[UTC_TimezoneId].gmtoff == 0, "UTC");
+    static_assert(BuiltinZones[CEST_TimezoneId].gmtoff == 7200, "CEST");
+    static_assert(BuiltinZones[UTCp530_TimezoneId].gmtoff == 5 * 3600 + 1800, "UTC+5:30");
+
+    ASSERT_STREQ(BuiltinZones[0].name, "UTC");
+    for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+        if (i > 1) {
+            ASSERT_LT(strcmp(BuiltinZones[i - 1].name, BuiltinZones[i].name), 0) << i;
+        }
+        ASSERT_EQ(TZId(BuiltinZones[i].name), static_cast<TimezoneId>(i));
+        ASSERT_EQ(TZ(static_cast<TimezoneId>(i)).name, BuiltinZones[i].name);
+    }
+    // The generated trie is the one NameIndex builds from the names.
+    std::map<int, std::string> names;
+    for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+        names[i] = BuiltinZones[i].name;
+    }
+    const NameIndex index(names);
+    const NameTrie trie = TimezoneRegistry::BuiltinNames();
+    for (unsigned i = 0; i < BuiltinZoneCount; ++i) {
+        ASSERT_EQ(trie.Find(BuiltinZones[i].name), static_cast<int>(i));
+        ASSERT_LE(strlen(BuiltinZones[i].name), BuiltinNameMaxLength);
+        const std::string input = std::string(BuiltinZones[i].name) + " Time 2021";
+        for (size_t n = 0; n <= input.size(); ++n) {
+            const char* p = input.data();
+            const char* q = input.data();
+            ASSERT_EQ(trie.Match(p, input.data() + n), index.Match(q, input.data() + n)) << input;
+            ASSERT_EQ(p, q);
+        }
+    }
+    ASSERT_EQ(trie.Find("Central European"), -1);
+    ASSERT_EQ(TZId("Central European Summer Time"), Central_European_Summer_Time_TimezoneId);
+    ASSERT_EQ(TZ(UTCp530_TimezoneId).name, "UTC+5:30");
+    ASSERT_EQ(CEST_Timezone().tz.gmtoff[0], 7200);
+    ASSERT_THROW(TZId("ABC"), std::out_of_range);
+    ASSERT_THROW(TZId(""), std::out_of_range);
+    ASSERT_THROW(TZId("ZZZZ"), std::out_of_range);
+    ASSERT_EQ(DateTimeD(2021, 1, 1, 0, 0, 0, CEST_TimezoneId).UTCOffset(), 7200);
+
+}
+
+#ifdef X_DATETIME_ZONEINFO
+// A version 1 TZif file with one transition, at t = 1000 from "AAA" (+1h) to "BB"
+// (+2h, DST).
+static std::string SmallTZif() {
+    std::string data("TZif", 4);
+    data.append(16, '\0');
+    const int counts[6] = {0, 0, 0, 1, 2, 7};
+    for (int c: counts) {
+        data += std::string("\0\0\0", 3) + static_cast<char>(c);
+    }
+    data += std::string("\0\0\x03\xe8", 4);               // transition time
+    data += '\x01';                                        // its type
+    data += std::string("\0\0\x0e\x10\0\0", 6);            // type 0: +3600, AAA
+    data += std::string("\0\0\x1c\x20\x01\x04", 6);        // type 1: +7200, BB
+    data += std::string("AAA\0BB\0", 7);
+    return data;
+}
+
+TEST(xDateTime, ZoneInfo) {
+    SetZoneInfoDirectory(XDATETIME_ZONEINFO_DIR);
+
+    TimezoneId berlin = TZId("Europe/Berlin");
+    ASSERT_EQ(TZ(berlin).name, "Europe/Berlin");
+    ASSERT_EQ(TZId("Europe/Berlin"), berlin);
+    const size_t size = TimezoneRegistry::getInstance().Size();
+    ASSERT_EQ(TZId("Europe/Berlin"), berlin);
+    ASSERT_EQ(TimezoneRegistry::getInstance().Size(), size);
+
+    DateTimeD summer(2021, 7, 1, 12, 0, 0, berlin);
+    ASSERT_EQ(summer.UTCOffset(), 7200);
+    ASSERT_TRUE(summer.IsDST());
+    ASSERT_EQ(DateTimeD(2021, 1, 1, 12, 0, 0, berlin).UTCOffset(), 3600);
+    const ZoneTransitions& t = TZTransitions(berlin);
+    ASSERT_EQ(t.Abbreviation(t.AtUTC(summer.UTCTicks() / 1000000000)), "CEST");
+    // Double summer time in 1945, and local mean time before 1893.
+    ASSERT_EQ(DateTimeD(1945, 6, 15, 12, 0, 0).ToTimeZone(berlin).UTCOffset(), 10800);
+    ASSERT_EQ(DateTimeD(1890, 1, 1, 12, 0, 0).ToTimeZone(berlin).UTCOffset(), 3208);
+
+    ASSERT_EQ(DateTimeD(2021, 7, 1, 12, 0, 0).ToTimeZone(TZId("America/New_York")).ToString("%H:%M %z"),
+              "08:00 -0400");
+    ASSERT_EQ(DateTimeD(2021, 1, 1, 12, 0, 0).ToTimeZone(TZId("America/New_York")).ToString("%H:%M %z"),
+              "07:00 -0500");
+    ASSERT_EQ(DateTimeD(2021, 7, 1, 12, 0, 0).ToTimeZone(TZId("Asia/Kolkata")).ToString("%H:%M %z"),
+              "17:30 +0530");
+
+    ASSERT_THROW(TZId("Europe/Nowhere"), std::out_of_range);
+    ASSERT_THROW(TZId("Europe/Nowhere"), std::out_of_range);
+    ASSERT_THROW(TZId("../zoneinfo/Europe/Berlin"), std::out_of_range);
+    ASSERT_THROW(TZId("Europe/../Europe/Berlin"), std::out_of_range);
+    ASSERT_THROW(TZId("/etc/passwd"), std::out_of_range);
+    ASSERT_THROW(TZId("Europe"), std::out_of_range);
+
+    // Parsing doesn't load zones named by its input; TZId() does.
+    std::string dir = testing::TempDir() + "xdatetime_zoneinfo";
+    mkdir(dir.c_str(), 0700);
+    {
+        std::ifstream from(XDATETIME_ZONEINFO_DIR "/Asia/Kolkata", std::ios::binary);
+        std::ofstream to((dir + "/XDTZ").c_str(), std::ios::binary);
+        to << from.rdbuf();
+    }
+    SetZoneInfoDirectory(dir);
+    DateTimeD parsed;
+    ASSERT_EQ(parsed.TryFromString("2021-01-01 XDTZ", "%Y-%m-%d %Z"), ParseError::UnknownTimezone);
+    TimezoneId loaded = TZId("XDTZ");
+    ASSERT_EQ(parsed.TryFromString("2021-01-01 XDTZ", "%Y-%m-%d %Z"), ParseError::None);
+    ASSERT_EQ(parsed.TimeZoneId(), loaded);
+    ASSERT_EQ(parsed.UTCOffset(), 5 * 3600 + 1800);
+    remove((dir + "/XDTZ").c_str());
+    rmdir(dir.c_str());
+    SetZoneInfoDirectory(XDATETIME_ZONEINFO_DIR);
+
+    // Misses are remembered up to a limit, the most recent first.
+    for (int i = 0; i < 5000; ++i) {
+        TimezoneId id;
+        ASSERT_FALSE(TimezoneRegistry::getInstance().Load("Nowhere/" + std::to_string(i), id));
+    }
+    ASSERT_THROW(TZId("Nowhere/4999"), std::out_of_range);
+    ASSERT_THROW(TZId("Nowhere/0"), std::out_of_range);
+
+    // Version 1 data.
+    const std::string small = SmallTZif();
+    Timezone zone;
+    ASSERT_TRUE(DecodeTZif(reinterpret_cast<const unsigned char*>(small.data()), small.size(), "Small", zone));
+    ZoneTransitions z(zone);
+    ASSERT_EQ(z.AtUTC(999).gmtoff, 3600);
+    ASSERT_EQ(z.Abbreviation(z.AtUTC(999)), "AAA");
+    ASSERT_EQ(z.AtUTC(1000).gmtoff, 7200);
+    ASSERT_EQ(z.AtUTC(1000).dst, 1);
+    ASSERT_EQ(z.Abbreviation(z.AtUTC(1000)), "BB");
+
+    // Anything cut short is refused.
+    std::ifstream in(XDATETIME_ZONEINFO_DIR "/Europe/Berlin", std::ios::binary);
+    std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_GT(file.size(), 1000u);
+    for (size_t n = 0; n < small.size(); ++n) {
+        std::vector<unsigned char> cut(small.begin(), small.begin() + n);
+        ASSERT_FALSE(DecodeTZif(cut.data(), cut.size(), "Small", zone)) << n;
+    }
+    for (size_t n = 0; n < file.size() - 40; n += 7) {
+        std::vector<unsigned char> cut(file.begin(), file.begin() + n);
+        ASSERT_FALSE(DecodeTZif(cut.data(), cut.size(), "Europe/Berlin", zone)) << n;
+    }
+}
+#endif
+
+// Seconds since the epoch of 01:00 UTC on the last Sunday of the month.
+static long long LastSundayOneAM(long long year, int month) {
+    typedef GregorianCalendar C;
+    long long day = C::DaysFromCivil(year, month, C::DaysInMonth(year, month));
+    day -= C::WeekdayFromDays(day);
+    return day * C::SecondsPerDay + 3600;
+}
+
+TEST(xDateTime, PosixRule) {
+    PosixRule cet("CET-1CEST,M3.5.0,M10.5.0/3");
+    ASSERT_TRUE(cet.Valid());
+    ASSERT_TRUE(cet.HasDST());
+    ASSERT_EQ(cet.StdOffset(), 3600);
+    ASSERT_EQ(cet.DSTOffset(), 7200);
+    ASSERT_EQ(cet.StdName(), "CET");
+    ASSERT_EQ(cet.DSTName(), "CEST");
+    long long start, end;
+    cet.Transitions(2021, start, end);
+    ASSERT_EQ(start, DateTimeD(2021, 3, 28, 1, 0, 0).ToTimeT());
+    ASSERT_EQ(end, DateTimeD(2021, 10, 31, 1, 0, 0).ToTimeT());
+
+    PosixRule plus3("<+03>-3");
+    ASSERT_TRUE(plus3.Valid());
+    ASSERT_FALSE(plus3.HasDST());
+    ASSERT_EQ(plus3.StdName(), "+03");
+    ASSERT_EQ(plus3.StdOffset(), 3 * 3600);
+
+    // No rules: the US ones, second Sunday of March to first Sunday of November.
+    PosixRule us("EST5EDT");
+    ASSERT_TRUE(us.HasDST());
+    us.Transitions(2021, start, end);
+    ASSERT_EQ(start, DateTimeD(2021, 3, 14, 7, 0, 0).ToTimeT());
+    ASSERT_EQ(end, DateTimeD(2021, 11, 7, 6, 0, 0).ToTimeT());
+
+    // Julian days, with and without February 29th, and times outside of 0-24h.
+    PosixRule julian("AAA3BBB,J60/-1,59/26:30");
+    ASSERT_TRUE(julian.Valid());
+    julian.Transitions(2024, start, end);
+    ASSERT_EQ(start, DateTimeD(2024, 3, 1, 2, 0, 0).ToTimeT());
+    ASSERT_EQ(end, DateTimeD(2024, 3, 1, 4, 30, 0).ToTimeT());
+    ASSERT_TRUE(PosixRule("<-02>2<-01>,M3.5.0/-1,M10.5.0/0").Valid());
+
+    const char* bad[] = {"", "C", "CET", "CET+", "CET-25", "CET-1CEST,M3.5.0", "CET-1CEST,M13.1.0,M10.5.0",
+                         "CET-1CEST,M3.6.0,M10.5.0", "CET-1CEST,M3.5.0,M10.5.0/3x", "<CET-1", "CET-1CEST,J0,J365",
+                         "CET-1CEST,M3.5.0,M10.5.0/168"};
+    for (const char* spec: bad) {
+        ASSERT_FALSE(PosixRule(spec).Valid()) << spec;
+    }
+
+    // The fixture has transitions up to 2037, and the rule after that.
+    SetZoneInfoDirectory(XDATETIME_ZONEINFO_DIR);
+    TimezoneId berlin = TZId("Europe/Berlin");
+    ASSERT_EQ(TZ(berlin).rule, "CET-1CEST,M3.5.0,M10.5.0/3");
+    const ZoneTransitions& z = TZTransitions(berlin);
+    for (long long year = 2030; year < 2500; year += (year < 2050) ? 1 : 37) {
+        const long long s = LastSundayOneAM(year, 3), e = LastSundayOneAM(year, 10);
+        ASSERT_EQ(z.AtUTC(s - 1).gmtoff, 3600) << year;
+        ASSERT_EQ(z.AtUTC(s).gmtoff, 7200) << year;
+        ASSERT_EQ(z.Abbreviation(z.AtUTC(s)), "CEST") << year;
+        ASSERT_EQ(z.AtUTC(e - 1).gmtoff, 7200) << year;
+        ASSERT_EQ(z.AtUTC(e).gmtoff, 3600) << year;
+        ASSERT_EQ(z.Abbreviation(z.AtUTC(e)), "CET") << year;
+        // Locally, 02:30 is skipped in March and repeated in October.
+        ASSERT_EQ(z.AtLocal(s + 3600 - 1).gmtoff, 3600) << year;
+        ASSERT_EQ(z.AtLocal(s + 5400).gmtoff, 3600) << year;
+        ASSERT_EQ(z.AtLocal(s + 7200).gmtoff, 7200) << year;
+        ASSERT_EQ(z.AtLocal(e + 5400).gmtoff, 3600) << year;
+        ASSERT_EQ(z.AtLocal(e + 3600 - 1).gmtoff, 7200) << year;
+        ASSERT_EQ(z.AtLocalFirst(e + 5400).gmtoff, 7200) << year;
+        ASSERT_EQ(z.AtLocalFirst(e + 7200).gmtoff, 3600) << year;
+        ASSERT_EQ(z.AtLocalFirst(s + 5400).gmtoff, 3600) << year;
+        if (year < 2200) ASSERT_EQ(DateTimeD(static_cast<time_t>(e - 1800)).ToTimeZone(berlin).UTCOffset(), 7200) << year;
+    }
+    // The same for the transitions in the table.
+    const long long e2021 = LastSundayOneAM(2021, 10);
+    ASSERT_EQ(z.AtLocalFirst(e2021 + 5400).gmtoff, 7200);
+    ASSERT_EQ(z.AtLocalFirst(e2021 + 7200).gmtoff, 3600);
+    ASSERT_EQ(z.AtLocalFirst(e2021 - 86400).gmtoff, 7200);
+    ASSERT_EQ(DateTimeD(2100, 7, 1, 12, 0, 0, berlin).ToString("%H:%M %z"), "12:00 +0200");
+    ASSERT_EQ(DateTimeD(2100, 7, 1, 12, 0, 0).ToTimeZone(berlin).ToString("%H:%M %z"), "14:00 +0200");
+
+    // Across the end of the table, with and without a hint.
+    ZoneTransitions::Hint hint;
+    const long long from = DateTimeD(2035, 1, 1).ToTimeT(), to = DateTimeD(2041, 1, 1).ToTimeT();
+    for (long long t = from; t < to; t += 1799) {
+        ASSERT_EQ(z.AtUTC(t, hint).gmtoff, z.AtUTC(t).gmtoff) << t;
+        ASSERT_EQ(z.AtLocal(t, hint).gmtoff, z.AtLocal(t).gmtoff) << t;
+        ASSERT_EQ(z.AtUTC(t).gmtoff, (t >= LastSundayOneAM(DateTimeD(static_cast<time_t>(t)).Year(), 3) &&
+                                      t < LastSundayOneAM(DateTimeD(static_cast<time_t>(t)).Year(), 10)) ? 7200 : 3600) << t;
+    }
+
+    // A southern zone with only a rule, from several threads at once over more
+    // years than are cached.
+    Timezone sydney;
+    sydney.name = "Test/Sydney";
+    sydney.gmtoff.push_back(36000);
+    sydney.rule = "AEST-10AEDT,M10.1.0,M4.1.0/3";
+    ZoneTransitions south(sydney);
+    ASSERT_EQ(south.AtUTC(DateTimeD(2021, 1, 1).ToTimeT()).gmtoff, 39600);
+    ASSERT_EQ(south.AtUTC(DateTimeD(2021, 7, 1).ToTimeT()).gmtoff, 36000);
+    std::vector<std::thread> threads;
+    std::atomic<int> errors(0);
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&south, &errors, i]() {
+            PosixRule rule("AEST-10AEDT,M10.1.0,M4.1.0/3");
+            for (int k = 0; k < 20000; ++k) {
+                const long long year = 2000 + (k * 7 + i) % 40;
+                const long long t = GregorianCalendar::DaysFromCivil(year, 1, 1) * 86400 + (k * 7919LL) % (365 * 86400);
+                long long s, e;
+                rule.Transitions(year, s, e);
+                const int expected = (t < e || t >= s) ? 39600 : 36000;
+                if (south.AtUTC(t).gmtoff != expected) ++errors;
+            }
+        });
+    }
+    for (std::thread& t: threads) t.join();
+    ASSERT_EQ(errors.load(), 0);
+}